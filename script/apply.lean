@@ -81,13 +81,12 @@ if (arity == fixed + {n}) \{
   }
 } else if (arity < fixed + {n}) \{\n"
   if n ≥ 2 then do
-    emit  s!"  obj * as[{n}] = \{ {args} };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) \{ lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, {n}+fixed-arity, &as[arity-fixed]);\n"
+    emit "  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {\n"
+    for k in [1:n] do
+      emit s!"  case {k}: return lean_apply_{n-k}(lean_apply_{k}(f, {mkArgs k}), {mkArgsFrom k n});\n"
+    emit "  default: lean_unreachable();
+  }\n"
   else emit s!"  lean_assert(fixed < arity);
   lean_unreachable();\n"
   emit s!"} else \{
@@ -104,8 +103,7 @@ case 0: lean_unreachable();\n"
     emit  s!"case {i+1}: return reinterpret_cast<fn{i+1}>(f)({as});\n"
   emit "default: return reinterpret_cast<fnn>(f)(as);
 }
-}
-static obj* curry(obj* f, unsigned n, obj** as) { return curry(lean_closure_fun(f), n, as); }\n"
+}\n"
 
 def mkApplyN (max : Nat) : M Unit := do
   emit "extern \"C\" LEAN_EXPORT obj* lean_apply_n(obj* f, unsigned n, obj** as) {
@@ -144,26 +142,46 @@ if (arity == fixed + n) \{
 }\n"
 
 def mkFixArgs : M Unit := emit "
+static inline unsigned closure_byte_size(unsigned num_fixed) {
+    return sizeof(lean_closure_object) + sizeof(void*)*num_fixed;
+}
+
+/* Number of argument slots that `fix_args` reserves in new closures beyond the fixed arguments, so that further
+   partial applications of an exclusive closure can store their arguments in place. */
+static constexpr unsigned g_closure_reserve = 4;
+
 static obj* fix_args(obj* f, unsigned n, obj*const* as) {
     unsigned arity = lean_closure_arity(f);
     unsigned fixed = lean_closure_num_fixed(f);
     unsigned new_fixed = fixed + n;
     lean_assert(new_fixed < arity);
-    obj * r = lean_alloc_closure(lean_closure_fun(f), arity, new_fixed);
-    obj ** source = lean_closure_arg_cptr(f);
-    obj ** target = lean_closure_arg_cptr(r);
-    if (!lean_is_exclusive(f)) {
-      for (unsigned i = 0; i < fixed; i++, source++, target++) {
-          *target = *source;
-          lean_inc(*target);
-      }
-      lean_dec_ref(f);
+    obj * r;
+    obj ** target;
+    if (lean_is_exclusive(f) && lean_small_object_size(f) >= closure_byte_size(new_fixed)) {
+      r = f;
+      target = lean_closure_arg_cptr(r) + fixed;
     } else {
-      for (unsigned i = 0; i < fixed; i++, source++, target++) {
-          *target = *source;
+      unsigned capacity = arity - 1 < new_fixed + g_closure_reserve ? arity - 1 : new_fixed + g_closure_reserve;
+      r = lean_alloc_small_object(closure_byte_size(capacity));
+      lean_set_st_header(r, LeanClosure, 0);
+      lean_to_closure(r)->m_fun = lean_closure_fun(f);
+      lean_to_closure(r)->m_arity = arity;
+      obj ** source = lean_closure_arg_cptr(f);
+      target = lean_closure_arg_cptr(r);
+      if (!lean_is_exclusive(f)) {
+        for (unsigned i = 0; i < fixed; i++, source++, target++) {
+            *target = *source;
+            lean_inc(*target);
+        }
+        lean_dec_ref(f);
+      } else {
+        for (unsigned i = 0; i < fixed; i++, source++, target++) {
+            *target = *source;
+        }
+        lean_free_small_object(f);
       }
-      lean_free_small_object(f);
     }
+    lean_to_closure(r)->m_num_fixed = new_fixed;
     for (unsigned i = 0; i < n; i++, as++, target++) {
         *target = *as;
     }
@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) 2026 Lean FRO. All rights reserved.
+# Released under Apache 2.0 license as described in the file LICENSE.
+#
+# Generates src/library/ir_interpreter_trampolines.h, the table of typed call trampolines
+# the IR interpreter uses to call the unboxed version of native functions.
+#
+#   python script/gen_interpreter_trampolines.py > src/library/ir_interpreter_trampolines.h
+import sys
+import itertools
+
+# maximal number of parameters of functions called through a trampoline
+MAX_ARITY = 4
+
+# calling convention classes: C type, `value` field, and `value` constructor
+CLASSES = [
+    ("uint64", "m_num",     "value"),
+    ("double", "m_float",   "value::from_float"),
+    ("float",  "m_float32", "value::from_float32"),
+]
+CLASS_NAMES = ["i", "d", "f"]
+
+def signatures():
+    for n in range(MAX_ARITY + 1):
+        # the first parameter is the least significant digit of the index
+        for params in itertools.product(range(len(CLASSES)), repeat=n):
+            yield tuple(reversed(params))
+
+def fn_name(ret, params):
+    return "trampoline_%s_%s" % (CLASS_NAMES[ret], "".join(CLASS_NAMES[p] for p in params) or "v")
+
+def main():
+    out = sys.stdout
+    out.write("""/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+// DO NOT EDIT, this is an automatically generated file
+// Generated using script: ../../script/gen_interpreter_trampolines.py
+// Included by `ir_interpreter.cpp` after the definition of `value`.
+#pragma once
+
+namespace lean {
+namespace ir {
+typedef value (*trampoline)(void * f, value const * args);
+
+/* Number of parameters up to which `get_trampoline` has an entry. */
+static constexpr unsigned g_max_trampoline_arity = %d;
+/* Number of calling convention classes: `0` (integers and pointers), `1` (`double`), `2` (`float`). */
+static constexpr unsigned g_num_trampoline_classes = %d;
+
+""" % (MAX_ARITY, len(CLASSES)))
+    sigs = list(signatures())
+    for ret in range(len(CLASSES)):
+        for params in sigs:
+            ret_ty, _, ret_mk = CLASSES[ret]
+            param_tys = ", ".join(CLASSES[p][0] for p in params)
+            args = ", ".join("args[%d].%s" % (i, CLASSES[p][1]) for i, p in enumerate(params))
+            out.write("static value %s(void * f, value const * %s) { return %s(reinterpret_cast<%s (*)(%s)>(f)(%s)); } // NOLINT\n"
+                      % (fn_name(ret, params), "args" if params else "", ret_mk, ret_ty, param_tys, args))
+    out.write("""
+/* Entries are ordered by return class, number of parameters, and then by the parameter classes read as a
+   number in base `g_num_trampoline_classes` with the first parameter as the least significant digit. */
+static trampoline const g_trampolines[] = {
+""")
+    for ret in range(len(CLASSES)):
+        for params in sigs:
+            out.write("    %s,\n" % fn_name(ret, params))
+    out.write("""};
+
+/* \\brief Return the trampoline for a function with result class \\c ret and parameter classes \\c params. */
+static inline trampoline get_trampoline(unsigned ret, unsigned n, unsigned const * params) {
+    if (n > g_max_trampoline_arity)
+        return nullptr;
+    // signatures with fewer parameters come first
+    unsigned offset = 0, num_sigs = 0, k = 1;
+    for (unsigned i = 0; i <= g_max_trampoline_arity; i++, k *= g_num_trampoline_classes) {
+        if (i < n)
+            offset += k;
+        num_sigs += k;
+    }
+    unsigned idx = 0;
+    for (unsigned i = n; i > 0; i--)
+        idx = idx * g_num_trampoline_classes + params[i - 1];
+    return g_trampolines[ret * num_sigs + offset + idx];
+}
+}
+}
+""")
+
+if __name__ == "__main__":
+    main()
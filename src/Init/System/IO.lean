@@ -646,6 +646,27 @@ file.
 -/
 opaque FS.Handle : Type := Unit
 
+/--
+A read-only memory mapping of a file, created by `IO.FS.mmapFile`.
+
+The contents of the file are read directly from the mapping without copying them into a `ByteArray`.
+The mapping is removed when the last reference to it is dropped. The file must not be modified while
+it is mapped.
+-/
+opaque FS.MappedFile : Type := Unit
+
+/--
+A buffered reader that splits the contents of a file handle into lines, created by
+`IO.FS.LineReader.mk`.
+
+The reader reads large blocks from the handle and scans them for line breaks, so it is much faster
+than repeated calls to `IO.FS.Handle.getLine`. Because it reads ahead, the handle should not be read
+from directly while the reader is in use. On pipes and terminals, a line is returned as soon as it
+has arrived, except on Windows, where the reader waits until a whole block or the end of the input
+has arrived.
+-/
+opaque FS.LineReader : Type := Unit
+
 /--
 A pure-Lean abstraction of POSIX streams. These streams may represent an underlying POSIX stream or
 be implemented by Lean code.
@@ -825,6 +846,172 @@ Writing to a handle is typically buffered, and may not immediately modify the fi
 
 end Handle
 
+/--
+Maps the file at `fn` into memory for reading.
+
+Unlike `IO.FS.readBinFile`, the file is not read up front: its pages are loaded by the operating
+system when they are accessed.
+-/
+@[extern "lean_io_mmap_file"] opaque mmapFile (fn : @& FilePath) : IO MappedFile
+
+namespace MappedFile
+
+/--
+How the contents of a mapped file are going to be accessed. The operating system may use this to read
+ahead or to drop pages that have been read already.
+
+**Operating System Specifics:**
+* Windows: Advice is ignored.
+* Other platforms: [`posix_madvise`](https://pubs.opengroup.org/onlinepubs/9699919799/functions/posix_madvise.html)
+-/
+inductive Advice where
+  /-- No special treatment. -/
+  | normal
+  /-- The contents are going to be accessed in order, from the beginning to the end. -/
+  | sequential
+  /-- The contents are going to be accessed in random order. -/
+  | random
+  /-- The contents are going to be accessed soon. -/
+  | willNeed
+
+/-- The size of the mapped file in bytes. -/
+@[extern "lean_io_mapped_file_size"] opaque size (m : @& MappedFile) : Nat
+
+/-- Returns the byte at position `i`, or `0` if `i` is out of bounds. -/
+@[extern "lean_io_mapped_file_uget"] opaque uget (m : @& MappedFile) (i : USize) : UInt8
+
+/-- Returns the byte at position `i`, panicking if `i` is out of bounds. -/
+def get! (m : MappedFile) (i : Nat) : UInt8 :=
+  if i < m.size then m.uget i.toUSize else panic! "index out of bounds"
+
+/--
+Copies the bytes from `start` to `stop` (exclusive) into a new `ByteArray`. The indices are clamped
+to the size of the file.
+-/
+@[extern "lean_io_mapped_file_extract"] opaque extract (m : @& MappedFile) (start stop : @& Nat) : ByteArray
+
+/-- Checks whether the contents of the file are valid UTF-8, without copying them. -/
+@[extern "lean_io_mapped_file_validate_utf8"] opaque validateUTF8 (m : @& MappedFile) : Bool
+
+/--
+Decodes the contents of the file as a `String`, or returns `none` if they are not valid UTF-8. The
+contents are copied only once, directly into the string.
+-/
+@[extern "lean_io_mapped_file_to_string"] opaque toString? (m : @& MappedFile) : Option String
+
+/-- Informs the operating system how the contents of the mapping are going to be accessed. -/
+@[extern "lean_io_mapped_file_advise"] opaque advise (m : @& MappedFile) (advice : Advice) : IO Unit
+
+/-- Iterates over the bytes of the file in order. -/
+@[inline]
+protected def forIn {β : Type v} {m : Type v → Type w} [Monad m] (file : MappedFile) (b : β)
+    (f : UInt8 → β → m (ForInStep β)) : m β :=
+  let size := file.size
+  let rec @[specialize] loop (n : Nat) (b : β) : m β := do
+    match n with
+    | 0 => pure b
+    | n+1 =>
+      match (← f (file.uget (size - 1 - n).toUSize) b) with
+      | ForInStep.done b  => pure b
+      | ForInStep.yield b => loop n b
+  loop size b
+
+instance : ForIn m MappedFile UInt8 where
+  forIn := MappedFile.forIn
+
+/--
+An iterator over the bytes of a mapped file, analogous to `ByteArray.Iterator`.
+-/
+structure Iterator where
+  /-- The mapped file the iterator is for. -/
+  file : MappedFile
+  /-- The current position. It may be past the end of the file. -/
+  pos : Nat
+
+/-- Creates an iterator at the beginning of the file. -/
+@[inline] def iter (file : MappedFile) : Iterator :=
+  ⟨file, 0⟩
+
+namespace Iterator
+
+/-- The number of bytes after the current position. -/
+@[inline] def remainingBytes : Iterator → Nat
+  | ⟨file, pos⟩ => file.size - pos
+
+/-- The byte at the current position, or `0` if the iterator is at the end. -/
+@[inline] def curr : Iterator → UInt8
+  | ⟨file, pos⟩ => file.uget pos.toUSize
+
+/-- Moves the iterator to the next byte. -/
+@[inline] def next : Iterator → Iterator
+  | ⟨file, pos⟩ => ⟨file, pos + 1⟩
+
+/-- Moves the iterator forward by `n` bytes. -/
+@[inline] def forward : Iterator → Nat → Iterator
+  | ⟨file, pos⟩, n => ⟨file, pos + n⟩
+
+/-- Whether the iterator is at or past the end of the file. -/
+@[inline] def atEnd : Iterator → Bool
+  | ⟨file, pos⟩ => pos ≥ file.size
+
+/-- Whether the iterator is before the last byte of the file. -/
+@[inline] def hasNext : Iterator → Bool
+  | ⟨file, pos⟩ => pos < file.size
+
+/-- Copies the bytes from the current position to the end of the file into a `ByteArray`. -/
+@[inline] def remainingToByteArray : Iterator → ByteArray
+  | ⟨file, pos⟩ => file.extract pos file.size
+
+end Iterator
+
+end MappedFile
+
+namespace LineReader
+
+/--
+Creates a line reader for `h` that reads blocks of `capacity` bytes. The buffer grows if a single line
+does not fit into it.
+-/
+@[extern "lean_io_line_reader_mk"]
+opaque mk (h : Handle) (capacity : USize := 65536) : IO LineReader
+
+/--
+Reads the next line. The line break (`"\n"` or `"\r\n"`) is not included in the line. Returns `none`
+at the end of the file.
+-/
+@[extern "lean_io_line_reader_read_line"]
+opaque readLine? (r : @& LineReader) : IO (Option String)
+
+/--
+Reads up to `max` lines, without their line breaks. Returns an empty array at the end of the file.
+-/
+@[extern "lean_io_line_reader_read_lines"]
+opaque readLines (r : @& LineReader) (max : USize) : IO (Array String)
+
+/--
+Folds `f` over the remaining lines, without their line breaks. The lines are read in batches.
+-/
+@[specialize]
+partial def foldLines (r : LineReader) (init : α) (f : α → String → IO α) : IO α := do
+  let lines ← r.readLines 1024
+  if lines.isEmpty then
+    return init
+  r.foldLines (← lines.foldlM f init) f
+
+/--
+Reads all remaining lines, without their line breaks.
+-/
+partial def lines (r : LineReader) : IO (Array String) :=
+  go #[]
+where
+  go (acc : Array String) : IO (Array String) := do
+    let lines ← r.readLines 65536
+    if lines.isEmpty then
+      return acc
+    go (acc ++ lines)
+
+end LineReader
+
 /--
 Resolves a path to an absolute path that contains no '.', '..', or symbolic links.
 
@@ -926,14 +1113,8 @@ encountered.
 The underlying file is not automatically closed upon encountering an EOF, and subsequent reads from
 the handle may block and/or return data.
 -/
-partial def Handle.readBinToEndInto (h : Handle) (buf : ByteArray) : IO ByteArray := do
-  let rec loop (acc : ByteArray) : IO ByteArray := do
-    let buf ← h.read 1024
-    if buf.isEmpty then
-      return acc
-    else
-      loop (acc ++ buf)
-  loop buf
+@[extern "lean_io_prim_handle_read_bin_to_end_into"]
+opaque Handle.readBinToEndInto (h : @& Handle) (buf : ByteArray) : IO ByteArray
 
 /--
 Reads the entire remaining contents of the file handle until an end-of-file marker (EOF) is
@@ -966,18 +1147,8 @@ Newline markers are not included in the lines.
 The underlying file is not automatically closed, and subsequent reads from the handle may block
 and/or return data.
 -/
-partial def Handle.lines (h : Handle) : IO (Array String) := do
-  let rec read (lines : Array String) := do
-    let line ← h.getLine
-    if line.length == 0 then
-      pure lines
-    else if line.back == '\n' then
-      let line := line.dropRight 1
-      let line := if line.back == '\r' then line.dropRight 1 else line
-      read <| lines.push line
-    else
-      pure <| lines.push line
-  read #[]
+def Handle.lines (h : Handle) : IO (Array String) := do
+  (← LineReader.mk h).lines
 
 /--
 Returns the contents of a UTF-8-encoded text file as an array of lines.
@@ -1688,7 +1859,7 @@ the stream may block and/or return data.
 -/
 partial def readBinToEndInto (s : Stream) (buf : ByteArray) : IO ByteArray := do
   let rec loop (acc : ByteArray) : IO ByteArray := do
-    let buf ← s.read 1024
+    let buf ← s.read 65536
     if buf.isEmpty then
       return acc
     else
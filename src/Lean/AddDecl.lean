@@ -71,6 +71,54 @@ register_builtin_option warn.sorry : Bool := {
   descr    := "warn about uses of `sorry` in declarations added to the environment"
 }
 
+register_builtin_option kernel.stats : Bool := {
+  defValue := false
+  descr    := "collect kernel performance counters (`whnf`/`isDefEq` calls, cache hit rates, GMP operations, ...) \
+    for each declaration and report them as JSON, see also `kernel.stats.output`"
+}
+
+register_builtin_option kernel.stats.output : String := {
+  defValue := ""
+  descr    := "if nonempty, append the JSON reports collected by `kernel.stats` to this file, one declaration \
+    per line, instead of logging them"
+}
+
+/-- Resets the kernel performance counters of the current thread and starts collecting them. -/
+@[extern "lean_kernel_stats_reset"]
+opaque Kernel.resetStats : BaseIO Unit
+
+/--
+Returns the kernel performance counters collected on the current thread since the last
+`Kernel.resetStats` as a JSON object, and stops collecting them.
+-/
+@[extern "lean_kernel_stats_take"]
+opaque Kernel.takeStats : BaseIO String
+
+register_builtin_option kernel.sharedCache : Nat := {
+  defValue := 0
+  descr    := "if positive, the kernel shares `inferType`/`whnf` results between declarations, storing at most \
+    this many entries. Only results for closed terms that mention imported constants only are shared, \
+    see also `Kernel.sharedCacheStats`"
+}
+
+/--
+Enables the kernel cache shared between declarations (`kernel.sharedCache`) on the current thread,
+setting its capacity for the whole process.
+-/
+@[extern "lean_kernel_shared_cache_enter"]
+opaque Kernel.enterSharedCache (capacity : USize) : BaseIO Unit
+
+/-- Disables the kernel cache shared between declarations on the current thread. -/
+@[extern "lean_kernel_shared_cache_leave"]
+opaque Kernel.leaveSharedCache : BaseIO Unit
+
+/--
+Returns the size, capacity, hit, miss, and eviction counts of the kernel cache shared between
+declarations as a JSON object.
+-/
+@[extern "lean_kernel_shared_cache_stats"]
+opaque Kernel.sharedCacheStats : BaseIO String
+
 def addDecl (decl : Declaration) : CoreM Unit := do
   -- register namespaces for newly added constants; this used to be done by the kernel itself
   -- but that is incompatible with moving it to a separate task
@@ -137,13 +185,41 @@ where
           if !(← MonadLog.hasErrors) && decl.hasSorry then
             logWarning <| .tagged `hasSorry m!"declaration uses 'sorry'"
         try
-          let env ← (← getEnv).addDeclAux (← getOptions) decl (← read).cancelTk?
-            |> ofExceptKernelException
+          let env ← withKernelStats <| withSharedKernelCache do
+            (← getEnv).addDeclAux (← getOptions) decl (← read).cancelTk?
+              |> ofExceptKernelException
           setEnv env
         catch ex =>
           -- avoid follow-up errors by (trying to) add broken decl as axiom
           addAsAxiom
           throw ex
+  withKernelStats (k : CoreM Environment) : CoreM Environment := do
+    let opts ← getOptions
+    unless kernel.stats.get opts do
+      return (← k)
+    Kernel.resetStats
+    let start ← IO.monoNanosNow
+    try
+      k
+    finally
+      let stats ← Kernel.takeStats
+      let stop ← IO.monoNanosNow
+      let decls := (toJson decl.getTopLevelNames).compress
+      let line := s!"\{\"decls\":{decls},\"time_ns\":{stop - start},\"kernel\":{stats}}"
+      let output := kernel.stats.output.get opts
+      if output.isEmpty then
+        logInfo line
+      else
+        IO.FS.withFile output .append (·.putStrLn line)
+  withSharedKernelCache (k : CoreM Environment) : CoreM Environment := do
+    let capacity := kernel.sharedCache.get (← getOptions)
+    if capacity == 0 then
+      return (← k)
+    Kernel.enterSharedCache capacity.toUSize
+    try
+      k
+    finally
+      Kernel.leaveSharedCache
   addAsAxiom := do
     -- try to add as axiom with given type for def/theorem
     match decl with
@@ -141,6 +141,11 @@ def getExternNameFor (env : Environment) (backend : Name) (fn : Name) : Option S
   | ExternEntry.standard _ n => pure n
   | _ => failure
 
+/-- Returns the C function implementing `fn`, which the interpreter uses to call it directly. -/
+@[export lean_get_extern_c_name_for]
+private def getExternCNameFor? (env : Environment) (fn : Name) : Option String :=
+  getExternNameFor env `c fn
+
 private def getExternConstArity (declName : Name) : CoreM Nat := do
   let fromSignature : Unit → CoreM Nat := fun _ => do
     let cinfo ← getConstInfo declName
@@ -14,7 +14,51 @@ import Lean.Compiler.IR.NormIds
 import Lean.Compiler.IR.SimpCase
 import Lean.Compiler.IR.Boxing
 
-namespace Lean.IR.EmitC
+namespace Lean.IR
+
+register_builtin_option compiler.pgo.generate : Bool := {
+  defValue := false
+  group    := "compiler"
+  descr    := "(compiler) instrument the generated C code with execution counters for profile-guided optimization. \
+The counters are written to the file `$LEAN_PGO_FILE` (default: `default.leanprof`) when the program exits."
+}
+
+register_builtin_option compiler.pgo.use : String := {
+  defValue := ""
+  group    := "compiler"
+  descr    := "(compiler) profile written by a program built with `compiler.pgo.generate` that is used to mark hot and \
+cold functions and branches and to order functions in the generated C code"
+}
+
+/--
+Execution counts collected by a program built with `compiler.pgo.generate`. Functions are identified by their C
+name `f` as `f:<f>`, and alternatives of the `i`-th `case` emitted in `f` as `b:<f>:<i>:<alt>`.
+-/
+structure PGOProfile where
+  counts : Std.HashMap String Nat := {}
+  /-- Minimal execution count of the hottest functions that together account for 90% of all function entries. -/
+  hotThreshold : Nat := 0
+  deriving Inhabited
+
+/-- Reads a profile written by `compiler.pgo.generate`; counts of repeated runs are added up. -/
+def PGOProfile.load (fname : System.FilePath) : IO PGOProfile := do
+  let mut counts : Std.HashMap String Nat := {}
+  for line in (← IO.FS.lines fname) do
+    if let [key, n] := line.splitOn " " then
+      if let some n := n.toNat? then
+        counts := counts.insert key (counts.getD key 0 + n)
+  let fnCounts := counts.fold (init := #[]) fun cs key n => if key.startsWith "f:" then cs.push n else cs
+  let fnCounts := fnCounts.qsort (· > ·)
+  let total := fnCounts.foldl (· + ·) 0
+  let mut sum := 0
+  let mut hotThreshold := 0
+  for n in fnCounts do
+    if n == 0 || sum * 10 ≥ total * 9 then break
+    sum := sum + n
+    hotThreshold := n
+  return { counts, hotThreshold }
+
+namespace EmitC
 open ExplicitBoxing (requiresBoxedVersion mkBoxedName isBoxedName)
 
 def leanMainFn := "_lean_main"
@@ -25,8 +69,21 @@ structure Context where
   jpMap      : JPParamsMap := {}
   mainFn     : FunId := default
   mainParams : Array Param := #[]
-
-abbrev M := ReaderT Context (EStateM String String)
+  /-- If `true`, emit execution counters, see `compiler.pgo.generate`. -/
+  pgoGenerate : Bool := false
+  /-- Profile used for emitting hints, see `compiler.pgo.use`. -/
+  pgoProfile : PGOProfile := {}
+  /-- C name of the function being emitted. -/
+  fnCName    : String := ""
+
+structure State where
+  out : String := ""
+  /-- Names of the execution counters emitted so far, see `PGOProfile`. -/
+  pgoCounters : Array String := #[]
+  /-- Number of `case`s emitted in the current function. -/
+  numCases : Nat := 0
+
+abbrev M := ReaderT Context (EStateM String State)
 
 def getEnv : M Environment := Context.env <$> read
 def getModName : M Name := Context.modName <$> read
@@ -37,7 +94,7 @@ def getDecl (n : Name) : M Decl := do
   | none   => throw s!"unknown declaration '{n}'"
 
 @[inline] def emit {α : Type} [ToString α] (a : α) : M Unit :=
-  modify fun out => out ++ toString a
+  modify fun ⟨out, pgoCounters, numCases⟩ => ⟨out ++ toString a, pgoCounters, numCases⟩
 
 @[inline] def emitLn {α : Type} [ToString α] (a : α) : M Unit := do
   emit a; emit "\n"
@@ -45,6 +102,19 @@ def getDecl (n : Name) : M Decl := do
 def emitLns {α : Type} [ToString α] (as : List α) : M Unit :=
   as.forM fun a => emitLn a
 
+def pgoCountersName : M String :=
+  return (← getModName).mangle "_l_pgo_counts_"
+
+/-- Emits a statement incrementing the execution counter `key`. -/
+def emitPGOCounter (key : String) : M Unit := do
+  let idx ← modifyGet fun ⟨out, pgoCounters, numCases⟩ =>
+    (pgoCounters.size, ⟨out, pgoCounters.push key, numCases⟩)
+  emit (← pgoCountersName); emit "["; emit idx; emitLn "]++;"
+
+/-- Returns the key of the execution counter of alternative `alt` of the `case` that is being emitted. -/
+def pgoBranchKey (caseIdx alt : Nat) : M String :=
+  return s!"b:{(← read).fnCName}:{caseIdx}:{alt}"
+
 def argToCString (x : Arg) : String :=
   match x with
   | .var x => toString x
@@ -238,6 +308,9 @@ def emitFileHeader : M Unit := do
     "extern \"C\" {",
     "#endif"
   ]
+  if (← read).pgoGenerate then
+    -- the size is only known after emitting all functions, see `emitPGOCounters`
+    emitLn s!"extern uint64_t {← pgoCountersName}[];"
 
 def emitFileFooter : M Unit :=
   emitLns [
@@ -597,22 +670,45 @@ def emitTailCall (v : Expr) : M Unit :=
 
 mutual
 
+/-- Emits the body of alternative `alt` of the `caseIdx`-th `case`, preceded by its execution counter if enabled. -/
+partial def emitAltBody (caseIdx alt : Nat) (b : FnBody) : M Unit := do
+  if (← read).pgoGenerate then
+    emitLn "{"
+    emitPGOCounter (← pgoBranchKey caseIdx alt)
+    emitFnBody b
+    emitLn "}"
+  else
+    emitFnBody b
+
 partial def emitIf (x : VarId) (xType : IRType) (tag : Nat) (t : FnBody) (e : FnBody) : M Unit := do
-  emit "if ("; emitTag x xType; emit " == "; emit tag; emitLn ")";
-  emitFnBody t;
+  let caseIdx ← modifyGet fun ⟨out, pgoCounters, numCases⟩ => (numCases, ⟨out, pgoCounters, numCases + 1⟩)
+  let profile := (← read).pgoProfile
+  let thenCount := profile.counts.get? (← pgoBranchKey caseIdx 0)
+  let elseCount := profile.counts.get? (← pgoBranchKey caseIdx 1)
+  -- only mark branches that are taken in at least 95% of the cases
+  let hint := match thenCount, elseCount with
+    | some n, some m => if n + m > 0 && n * 20 ≥ (n + m) * 19 then "LEAN_LIKELY"
+      else if n + m > 0 && m * 20 ≥ (n + m) * 19 then "LEAN_UNLIKELY" else ""
+    | _, _ => ""
+  if hint.isEmpty then
+    emit "if ("; emitTag x xType; emit " == "; emit tag; emitLn ")"
+  else
+    emit "if ("; emit hint; emit "("; emitTag x xType; emit " == "; emit tag; emitLn "))"
+  emitAltBody caseIdx 0 t;
   emitLn "else";
-  emitFnBody e
+  emitAltBody caseIdx 1 e
 
 partial def emitCase (x : VarId) (xType : IRType) (alts : Array Alt) : M Unit :=
   match isIf alts with
   | some (tag, t, e) => emitIf x xType tag t e
   | _ => do
+    let caseIdx ← modifyGet fun ⟨out, pgoCounters, numCases⟩ => (numCases, ⟨out, pgoCounters, numCases + 1⟩)
     emit "switch ("; emitTag x xType; emitLn ") {";
     let alts := ensureHasDefault alts;
-    alts.forM fun alt => do
-      match alt with
-      | Alt.ctor c b  => emit "case "; emit c.cidx; emitLn ":"; emitFnBody b
-      | Alt.default b => emitLn "default: "; emitFnBody b
+    alts.size.forM fun i h => do
+      match alts[i]'h with
+      | Alt.ctor c b  => emit "case "; emit c.cidx; emitLn ":"; emitAltBody caseIdx i b
+      | Alt.default b => emitLn "default: "; emitAltBody caseIdx i b
     emitLn "}"
 
 partial def emitBlock (b : FnBody) : M Unit := do
@@ -664,6 +760,12 @@ def emitDeclAux (d : Decl) : M Unit := do
     match d with
     | .fdecl (f := f) (xs := xs) (type := t) (body := b) .. =>
       let baseName ← toCName f;
+      let profile := (← read).pgoProfile
+      if let some n := profile.counts.get? s!"f:{baseName}" then
+        if n == 0 then
+          emit "LEAN_COLD "
+        else if n ≥ profile.hotThreshold then
+          emit "LEAN_HOT "
       if xs.size == 0 then
         emit "static "
       else
@@ -688,7 +790,12 @@ def emitDeclAux (d : Decl) : M Unit := do
           let x := xs[i]!
           emit "lean_object* "; emit x.x; emit " = _args["; emit i; emitLn "];"
       emitLn "_start:";
-      withReader (fun ctx => { ctx with mainFn := f, mainParams := xs }) (emitFnBody b);
+      withReader (fun ctx => { ctx with mainFn := f, mainParams := xs, fnCName := baseName }) do
+        modify fun ⟨out, pgoCounters, _⟩ => ⟨out, pgoCounters, 0⟩
+        if (← read).pgoGenerate then
+          -- counts calls including self tail calls
+          emitPGOCounter s!"f:{baseName}"
+        emitFnBody b
       emitLn "}"
     | _ => pure ()
 
@@ -702,7 +809,23 @@ def emitDecl (d : Decl) : M Unit := do
 def emitFns : M Unit := do
   let env ← getEnv;
   let decls := getDecls env;
-  decls.reverse.forM emitDecl
+  let profile := (← read).pgoProfile
+  if profile.counts.isEmpty then
+    decls.reverse.forM emitDecl
+  else
+    -- emit hot functions first so that they are placed close to each other
+    let decls ← decls.reverse.mapM fun d => return (d, profile.counts.getD s!"f:{← toCName d.name}" 0)
+    let decls := decls.toList.mergeSort fun (_, n) (_, m) => n ≥ m
+    decls.forM fun (d, _) => emitDecl d
+
+/-- Emits the execution counters of the module and their names, see `lean_pgo_register`. -/
+def emitPGOCounters : M Unit := do
+  let counters := (← get).pgoCounters
+  emitLn s!"uint64_t {← pgoCountersName}[{max counters.size 1}];"
+  emit "static char const * const _l_pgo_names[] = {"
+  counters.forM fun key => do emit (quoteString key); emit ", "
+  emitLn "0};"
+  emitLn s!"static lean_pgo_counters _l_pgo = \{0, {counters.size}, _l_pgo_names, {← pgoCountersName}};"
 
 def emitMarkPersistent (d : Decl) (n : Name) : M Unit := do
   if d.resultType.isObj then
@@ -751,6 +874,8 @@ def emitInitFn : M Unit := do
     "if (_G_initialized) return lean_io_result_mk_ok(lean_box(0));",
     "_G_initialized = true;"
   ]
+  if (← read).pgoGenerate then
+    emitLn "lean_pgo_register(&_l_pgo);"
   env.imports.forM fun imp => emitLns [
     "res = " ++ mkModuleInitializationFunctionName imp.module ++ "(builtin, lean_io_mk_world());",
     "if (lean_io_result_is_error(res)) return res;",
@@ -763,16 +888,23 @@ def main : M Unit := do
   emitFileHeader
   emitFnDecls
   emitFns
+  if (← read).pgoGenerate then
+    emitPGOCounters
   emitInitFn
   emitMainFnIfNeeded
   emitFileFooter
 
 end EmitC
 
+/--
+Emits the C code of module `modName`. If `pgoGenerate` is true, the code is instrumented with execution counters
+for profile-guided optimization; `pgoProfile` is used to emit hints.
+-/
 @[export lean_ir_emit_c]
-def emitC (env : Environment) (modName : Name) : Except String String :=
-  match (EmitC.main { env := env, modName := modName }).run "" with
-  | EStateM.Result.ok    _   s => Except.ok s
+def emitC (env : Environment) (modName : Name) (pgoGenerate := false) (pgoProfile : PGOProfile := {}) :
+    Except String String :=
+  match (EmitC.main { env, modName, pgoGenerate, pgoProfile }).run {} with
+  | EStateM.Result.ok    _   s => Except.ok s.out
   | EStateM.Result.error err _ => Except.error err
 
 end Lean.IR
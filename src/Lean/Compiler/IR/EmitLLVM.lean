@@ -16,7 +16,7 @@ import Lean.Compiler.IR.Boxing
 import Lean.Compiler.IR.ResetReuse
 import Lean.Compiler.IR.LLVMBindings
 
-open Lean.IR.ExplicitBoxing (isBoxedName)
+open Lean.IR.ExplicitBoxing (isBoxedName mkBoxedName)
 
 namespace Lean.IR
 
@@ -62,6 +62,8 @@ structure Context (llvmctx : LLVM.Context) where
   mainFn     : FunId := default
   mainParams : Array Param := #[]
   llvmmodule : LLVM.Module llvmctx
+  /-- The declarations to emit if not the ones of the current module, see `jitCompile`. -/
+  decls?     : Option (List Decl) := none
 
 structure State (llvmctx : LLVM.Context) where
   var2val : Std.HashMap VarId (LLVM.LLVMType llvmctx × LLVM.Value llvmctx)
@@ -99,6 +101,11 @@ def getDecl (n : Name) : M llvmctx Decl := do
   | some d => pure d
   | none   => throw s!"unknown declaration {n}"
 
+def getEmitDecls : M llvmctx (List Decl) := do
+  match (← read).decls? with
+  | some decls => pure decls
+  | none       => return getDecls (← getEnv)
+
 def constInt8 (n : Nat) : M llvmctx (LLVM.Value llvmctx) :=  do
     LLVM.constInt8 llvmctx (UInt64.ofNat n)
 
@@ -519,7 +526,7 @@ def emitExternDeclAux (decl : Decl) (cNameStr : String) : M llvmctx Unit := do
 
 def emitFnDecls : M llvmctx Unit := do
   let env ← getEnv
-  let decls := getDecls env
+  let decls ← getEmitDecls
   let modDecls  : NameSet := decls.foldl (fun s d => s.insert d.name) {}
   let usedDecls : NameSet := decls.foldl (fun s d => collectUsedDecls env d (s.insert d.name)) {}
   let usedDecls := usedDecls.toList
@@ -1243,8 +1250,7 @@ def emitDecl (mod : LLVM.Module llvmctx) (builder : LLVM.Builder llvmctx) (d : D
     throw (s!"emitDecl:\ncompiling:\n{d}\nerr:\n{err}\n")
 
 def emitFns (mod : LLVM.Module llvmctx) (builder : LLVM.Builder llvmctx) : M llvmctx Unit := do
-  let env ← getEnv
-  let decls := getDecls env
+  let decls ← getEmitDecls
   decls.reverse.forM (emitDecl mod builder)
 
 def callIODeclInitFn (builder : LLVM.Builder llvmctx)
@@ -1581,8 +1587,7 @@ def emitMainFn (mod : LLVM.Module llvmctx) (builder : LLVM.Builder llvmctx) : M
   let _ ← LLVM.buildUnreachable builder
 
 def hasMainFn : M llvmctx Bool := do
-  let env ← getEnv
-  let decls := getDecls env
+  let decls ← getEmitDecls
   return decls.any (fun d => d.name == `main)
 
 def emitMainFnIfNeeded (mod : LLVM.Module llvmctx) (builder : LLVM.Builder llvmctx) : M llvmctx Unit := do
@@ -1594,6 +1599,12 @@ def main : M llvmctx Unit := do
   emitFns (← getLLVMModule) builder
   emitInitFn (← getLLVMModule) builder
   emitMainFnIfNeeded (← getLLVMModule) builder
+
+/-- Emits the functions selected by `jitCompile`, which need neither a module initializer nor `main`. -/
+def jitMain : M llvmctx Unit := do
+  emitFnDecls
+  let builder ← LLVM.createBuilderInContext llvmctx
+  emitFns (← getLLVMModule) builder
 end EmitLLVM
 
 def getLeanHBcPath : IO System.FilePath := do
@@ -1613,6 +1624,33 @@ partial def getModuleFunctions (mod : LLVM.Module llvmctx) : IO (Array (LLVM.Val
     else go (← LLVM.getNextFunction v) (acc.push v)
   go (← LLVM.getFirstFunction mod) #[]
 
+/-- Links the bitcode of `lean.h` into `mod`, giving its definitions internal linkage. -/
+def linkRuntimeModule (mod : LLVM.Module llvmctx) : IO Unit := do
+  let membuf ← LLVM.createMemoryBufferWithContentsOfFile (← getLeanHBcPath).toString
+  let modruntime ← LLVM.parseBitcode llvmctx membuf
+  /- It is important that we extract the names here because
+     pointers into modruntime get invalidated by linkModules -/
+  let runtimeGlobals ← (← getModuleGlobals modruntime).mapM (·.getName)
+  let filter func := do
+    -- | Do not insert internal linkage for
+    -- intrinsics such as `@llvm.umul.with.overflow.i64` which clang generates, and also
+    -- for declarations such as `lean_inc_ref_cold` which are externally defined.
+    if (← LLVM.isDeclaration func) then
+      return none
+    else
+      return some (← func.getName)
+  let runtimeFunctions ← (← getModuleFunctions modruntime).filterMapM filter
+  LLVM.linkModules (dest := mod) (src := modruntime)
+  -- Mark every global and function as having internal linkage.
+  for name in runtimeGlobals do
+    let some global ← LLVM.getNamedGlobal mod name
+       | throw <| IO.Error.userError s!"ERROR: linked module must have global from runtime module: '{name}'"
+    LLVM.setLinkage global LLVM.Linkage.internal
+  for name in runtimeFunctions do
+    let some fn ← LLVM.getNamedFunction mod name
+       | throw <| IO.Error.userError s!"ERROR: linked module must have function from runtime module: '{name}'"
+    LLVM.setLinkage fn LLVM.Linkage.internal
+
 /--
 `emitLLVM` is the entrypoint for the lean shell to code generate LLVM.
 -/
@@ -1626,33 +1664,80 @@ def emitLLVM (env : Environment) (modName : Name) (filepath : String) : IO Unit
   let out? ← ((EmitLLVM.main (llvmctx := llvmctx)).run initState).run emitLLVMCtx
   match out? with
   | .ok _ => do
-         let membuf ← LLVM.createMemoryBufferWithContentsOfFile (← getLeanHBcPath).toString
-         let modruntime ← LLVM.parseBitcode llvmctx membuf
-         /- It is important that we extract the names here because
-            pointers into modruntime get invalidated by linkModules -/
-         let runtimeGlobals ← (← getModuleGlobals modruntime).mapM (·.getName)
-         let filter func := do
-           -- | Do not insert internal linkage for
-           -- intrinsics such as `@llvm.umul.with.overflow.i64` which clang generates, and also
-           -- for declarations such as `lean_inc_ref_cold` which are externally defined.
-           if (← LLVM.isDeclaration func) then
-             return none
-           else
-             return some (← func.getName)
-         let runtimeFunctions ← (← getModuleFunctions modruntime).filterMapM filter
-         LLVM.linkModules (dest := emitLLVMCtx.llvmmodule) (src := modruntime)
-         -- Mark every global and function as having internal linkage.
-         for name in runtimeGlobals do
-           let some global ← LLVM.getNamedGlobal emitLLVMCtx.llvmmodule name
-              | throw <| IO.Error.userError s!"ERROR: linked module must have global from runtime module: '{name}'"
-           LLVM.setLinkage global LLVM.Linkage.internal
-         for name in runtimeFunctions do
-           let some fn ← LLVM.getNamedFunction emitLLVMCtx.llvmmodule name
-              | throw <| IO.Error.userError s!"ERROR: linked module must have function from runtime module: '{name}'"
-           LLVM.setLinkage fn LLVM.Linkage.internal
+         linkRuntimeModule emitLLVMCtx.llvmmodule
          if let some err ← LLVM.verifyModule emitLLVMCtx.llvmmodule then
            throw <| .userError err
          LLVM.writeBitcodeToFile emitLLVMCtx.llvmmodule filepath
          LLVM.disposeModule emitLLVMCtx.llvmmodule
   | .error err => throw (IO.Error.userError err)
+
+/-- Returns `true` iff the running process has a symbol with the given name. -/
+@[extern "lean_ir_has_native_symbol"]
+private opaque hasNativeSymbol (sym : @& String) : BaseIO Bool
+
+private def cNameFor (env : Environment) (n : Name) : String :=
+  match getExportNameFor? env n with
+  | some (.str .anonymous s) => s
+  | _                        => if n == `main then leanMainFn else n.mangle
+
+/--
+Collects the IR declarations of `roots` and, transitively, of the functions they use that do not have
+native code in the running process. Fails if one of them cannot be compiled on its own, e.g. because it is a
+constant that is only initialized by its module initializer.
+-/
+private partial def collectJITDecls (env : Environment) (roots : Array Name) : ExceptT String BaseIO (List Decl) := do
+  let (_, decls, _) ← (roots.forM visit).run ([], {})
+  return decls
+where
+  visit (n : Name) : StateT (List Decl × NameSet) (ExceptT String BaseIO) Unit := do
+    if (← get).2.contains n then return
+    modify fun (decls, visited) => (decls, visited.insert n)
+    if (← hasNativeSymbol (cNameFor env n)) then return
+    match findEnvDecl env n with
+    | none => throw s!"unknown declaration '{n}'"
+    | some (.extern (ext := ext) ..) =>
+      -- calls to these are emitted directly, see `emitExternCall`
+      match getExternEntryFor ext `c with
+      | some (.standard ..) | some (.inline ..) => pure ()
+      | _ => throw s!"external declaration '{n}' does not have native code"
+    | some d@(.fdecl (xs := xs) ..) =>
+      if xs.isEmpty then
+        throw s!"constant '{n}' does not have native code"
+      if hasInitAttr env n then
+        throw s!"declaration '{n}' is initialized by its module"
+      modify fun (decls, visited) => (d :: decls, visited)
+      for m in (collectUsedDecls env d).toList do
+        visit m
+
+/--
+Compiles `fn`, its boxed version if any, and the functions they use that do not have native code with the
+process-wide ORC JIT. Returns the addresses of `fn` and of its boxed version (`0` if there is none).
+
+This is used by the interpreter to run hot functions natively, see `interpreter.jit_threshold`.
+-/
+@[export lean_ir_jit_compile]
+def jitCompile (env : Environment) (fn : Name) : IO (USize × USize) := do
+  let boxed := mkBoxedName fn
+  let roots := if (findEnvDecl env boxed).isSome then #[fn, boxed] else #[fn]
+  let decls ← match ← (collectJITDecls env roots).run with
+    | .ok decls  => pure decls
+    | .error err => throw <| .userError s!"cannot compile '{fn}': {err}"
+  LLVM.llvmInitializeTargetInfo
+  -- the JIT compiles a copy of the module, so the context is freed right away
+  let llvmctx ← LLVM.createContext
+  let suffix ← tryFinally (m := IO) (do
+      let module ← LLVM.createModule llvmctx s!"jit.{fn}"
+      let emitLLVMCtx : EmitLLVM.Context llvmctx := {env := env, modName := env.mainModule, llvmmodule := module, decls? := decls}
+      let initState := { var2val := default, jp2bb := default : EmitLLVM.State llvmctx}
+      let out? ← ((EmitLLVM.jitMain (llvmctx := llvmctx)).run initState).run emitLLVMCtx
+      if let .error err := out? then
+        throw (IO.Error.userError err)
+      linkRuntimeModule module
+      if let some err ← LLVM.verifyModule module then
+        throw <| .userError err
+      LLVM.jitAddModule module)
+    (LLVM.disposeContext llvmctx)
+  let addr ← LLVM.jitLookup (cNameFor env fn ++ suffix)
+  let boxedAddr ← if roots.size > 1 then LLVM.jitLookup (cNameFor env boxed ++ suffix) else pure 0
+  return (addr, boxedAddr)
 end Lean.IR
@@ -101,6 +101,10 @@ opaque llvmInitializeTargetInfo : BaseIO (Unit)
 @[extern "lean_llvm_create_context"]
 opaque createContext : BaseIO (Context)
 
+/-- Frees `ctx` together with all modules that still belong to it. -/
+@[extern "lean_llvm_dispose_context"]
+opaque disposeContext (ctx : Context) : BaseIO Unit
+
 @[extern "lean_llvm_create_module"]
 opaque createModule (ctx : Context) (name : @&String) : BaseIO (Module ctx)
 
@@ -347,6 +351,17 @@ opaque disposeModule (m : Module ctx) : BaseIO Unit
 @[extern "lean_llvm_verify_module"]
 opaque verifyModule (m : Module ctx) : BaseIO (Option String)
 
+/--
+Compiles a copy of `m` with the process-wide ORC JIT. The functions defined and exported by `m` are
+renamed by appending the returned suffix, so that they do not clash with the ones of earlier modules.
+-/
+@[extern "lean_llvm_jit_add_module"]
+opaque jitAddModule (m : Module ctx) : IO String
+
+/-- Returns the address of a symbol compiled by `jitAddModule`, or `0` if there is no such symbol. -/
+@[extern "lean_llvm_jit_lookup"]
+opaque jitLookup (name : @&String) : IO USize
+
 @[extern "lean_llvm_create_string_attribute"]
 opaque createStringAttribute (key : String) (value : String) : BaseIO (Attribute ctx)
 
@@ -171,6 +171,10 @@ def runFrontend
         isModule := stx.isModule
         mainModuleName, opts, trustLevel, plugins
       }
+  let profileInterpreter :=
+    (trace.profiler.output.get? opts).isSome && trace.profiler.interpreter.get opts > 0
+  if profileInterpreter then
+    Firefox.startInterpreterProfiler (trace.profiler.interpreter.get opts).toUInt32
   let processor := Language.Lean.process
   let snap ← processor setup none ctx
   let snaps := Language.toSnapshotTree snap
@@ -178,6 +182,7 @@ def runFrontend
 
   -- reporting should be done before any early exit from the function
   let hasErrors ← snaps.runAndReport opts jsonOutput severityOverrides
+  let interpreterProfile ← if profileInterpreter then Firefox.stopInterpreterProfiler else pure {}
 
   let some cmdState := Language.Lean.waitForFinalCmdState? snap
     | return none
@@ -208,7 +213,8 @@ def runFrontend
 
   if let some out := trace.profiler.output.get? opts then
     let traceStates := snaps.getAll.map (·.traces)
-    let profile ← Firefox.Profile.export mainModuleName.toString startTime traceStates opts
+    let profile ←
+      Firefox.Profile.export mainModuleName.toString startTime traceStates opts interpreterProfile
     IO.FS.writeFile ⟨out⟩ <| Json.compress <| toJson profile
 
   -- no point in freeing the snapshot graph and all referenced data this close to process exit
@@ -298,6 +298,19 @@ private def markQuotInit (env : Environment) : Environment :=
 private def isQuotInit (env : Environment) : Bool :=
   env.quotInit
 
+/--
+Returns the constants imported from other modules. The kernel uses the identity of this map to decide
+whether cached results can be reused across declarations, see `kernel.sharedCache`.
+-/
+@[export lean_kernel_environment_imported_constants]
+private def importedConstants (env : Environment) : Std.HashMap Name ConstantInfo :=
+  env.constants.map₁
+
+/-- Returns `true` if `n` is an imported constant, i.e., it was not added by the current module. -/
+@[export lean_kernel_environment_is_imported]
+private def isImported (env : Environment) (n : Name) : Bool :=
+  !env.constants.stage₁ && env.constants.map₁.contains n
+
 /-- Type check given declaration and add it to the environment -/
 @[extern "lean_add_decl"]
 opaque addDeclCore (env : Environment) (maxHeartbeats : USize) (decl : @& Declaration)
@@ -1159,6 +1172,18 @@ def getModuleIdxFor? (env : Environment) (declName : Name) : Option ModuleIdx :=
 def isImportedConst (env : Environment) (declName : Name) : Bool :=
   env.getModuleIdxFor? declName |>.isSome
 
+@[export lean_elab_environment_is_imported_const]
+private def isImportedConstExport (env : Environment) (declName : Name) : Bool :=
+  env.isImportedConst declName
+
+/--
+Returns the list of all imported modules. All environments derived from the same imports share this
+array, which the interpreter uses to share caches for imported declarations between them.
+-/
+@[export lean_elab_environment_imports_id]
+private def importsId (env : Environment) : Array EffectiveImport :=
+  env.header.modules
+
 def isConstructor (env : Environment) (declName : Name) : Bool :=
   env.findAsync? declName |>.any (·.kind == .ctor)
 
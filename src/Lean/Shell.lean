@@ -226,7 +226,10 @@ private def shellMain
         | IO.eprintln s!"failed to create '{c}'"
           return 1
       profileitIO "C code generation" opts do
-        let data ← IO.ofExcept <| IR.emitC env mainModuleName
+        let pgoUse := IR.compiler.pgo.use.get opts
+        let pgoProfile ← if pgoUse.isEmpty then pure {} else IR.PGOProfile.load pgoUse
+        let data ← IO.ofExcept <|
+          IR.emitC env mainModuleName (IR.compiler.pgo.generate.get opts) pgoProfile
         out.write data.toUTF8
     if let some bc := bcFileName? then
       initLLVM
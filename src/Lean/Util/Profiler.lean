@@ -171,7 +171,8 @@ def categories : Array Category := #[
   { name := `Elab.block, color := "brown" },
   { name := `Elab, color := "red" },
   { name := `Meta, color := "yellow" },
-  { name := `Kernel, color := "green" }
+  { name := `Kernel, color := "green" },
+  { name := `Interpreter, color := "blue" }
 ]
 
 /-- Returns first `startTime` in the trace tree, if any. -/
@@ -185,6 +186,46 @@ private partial def getFirstStart? : MessageData → Option Float
     | .withContext _ msg => getFirstStart? msg
     | _ => none
 
+/--
+Adds a frame of the function `funcName` on top of the stack `parentStackIdx?`, reusing existing entries of
+the string, function, frame, and stack tables, and returns the index of the resulting stack.
+-/
+private def ThreadWithMaps.addFrame (thread : ThreadWithMaps) (funcName : String) (category : Nat)
+    (parentStackIdx? : Option Nat) : Nat × ThreadWithMaps := Id.run do
+  let mut thread := thread
+  let strIdx := thread.stringMap[funcName]?.getD thread.stringMap.size
+  if strIdx == thread.stringMap.size then
+    thread := { thread with
+      stringArray := thread.stringArray.push funcName
+      stringMap := thread.stringMap.insert funcName strIdx }
+  let funcIdx := thread.funcMap[strIdx]?.getD thread.funcMap.size
+  if funcIdx == thread.funcMap.size then
+    thread := { thread with
+      funcTable := {
+        name := thread.funcTable.name.push strIdx
+        resource := thread.funcTable.resource.push (-1)
+        -- the following fields could be inferred from `Syntax` in the message
+        fileName := thread.funcTable.fileName.push none
+        lineNumber := thread.funcTable.lineNumber.push none
+        columnNumber := thread.funcTable.columnNumber.push none
+        length := thread.funcTable.length + 1
+      }
+      frameTable := thread.frameTable.push { func := funcIdx, category := category }
+      funcMap := thread.funcMap.insert strIdx funcIdx }
+  let frameIdx := funcIdx
+  let stackIdx := thread.stackMap[(frameIdx, parentStackIdx?)]?.getD thread.stackMap.size
+  if stackIdx == thread.stackMap.size then
+    thread := { thread with
+      stackTable := {
+        frame := thread.stackTable.frame.push frameIdx
+        «prefix» := thread.stackTable.prefix.push parentStackIdx?
+        category := thread.stackTable.category.push category
+        subcategory := thread.stackTable.subcategory.push 0
+        length := thread.stackTable.length + 1
+      }
+      stackMap := thread.stackMap.insert (frameIdx, parentStackIdx?) stackIdx }
+  return (stackIdx, thread)
+
 private partial def addTrace (pp : Bool) (thread : ThreadWithMaps) (trace : MessageData) :
     IO ThreadWithMaps :=
   (·.2) <$> StateT.run (go none none trace) thread
@@ -198,47 +239,8 @@ where
         funcName := s!"{funcName}: {data.tag}"
       if pp then
         funcName := s!"{funcName}: {← msg.format ctx?}"
-      let strIdx ← modifyGet fun thread =>
-        if let some idx := thread.stringMap[funcName]? then
-          (idx, thread)
-        else
-          (thread.stringMap.size, { thread with
-            stringArray := thread.stringArray.push funcName
-            stringMap := thread.stringMap.insert funcName thread.stringMap.size })
       let category := categories.findIdx? (·.name.isPrefixOf data.cls) |>.getD 0
-      let funcIdx ← modifyGet fun thread =>
-        if let some idx := thread.funcMap[strIdx]? then
-          (idx, thread)
-        else
-          (thread.funcMap.size, { thread with
-            funcTable := {
-              name := thread.funcTable.name.push strIdx
-              resource := thread.funcTable.resource.push (-1)
-              -- the following fields could be inferred from `Syntax` in the message
-              fileName := thread.funcTable.fileName.push none
-              lineNumber := thread.funcTable.lineNumber.push none
-              columnNumber := thread.funcTable.columnNumber.push none
-              length := thread.funcTable.length + 1
-            }
-            frameTable := thread.frameTable.push {
-              func := thread.funcMap.size
-              category := category
-            }
-            funcMap := thread.funcMap.insert strIdx thread.funcMap.size })
-      let frameIdx := funcIdx
-      let stackIdx ← modifyGet fun thread =>
-        if let some idx := thread.stackMap[(frameIdx, parentStackIdx?)]? then
-          (idx, thread)
-        else
-          (thread.stackMap.size, { thread with
-            stackTable := {
-              frame := thread.stackTable.frame.push frameIdx
-              «prefix» := thread.stackTable.prefix.push parentStackIdx?
-              category := thread.stackTable.category.push category
-              subcategory := thread.stackTable.subcategory.push 0
-              length := thread.stackTable.length + 1
-            }
-            stackMap := thread.stackMap.insert (frameIdx, parentStackIdx?) thread.stackMap.size })
+      let stackIdx ← modifyGet (·.addFrame funcName category parentStackIdx?)
       modify fun thread => { thread with lastTime := data.startTime }
       for c in children do
         if let some nextStart := getFirstStart? c then
@@ -277,8 +279,71 @@ def Thread.new (name : String) : Thread := {
     length := 0 }
 }
 
+/-- A call stack sampled by the interpreter profiler. -/
+structure InterpreterSample where
+  /-- Thread ID as returned by `IO.getTID`. -/
+  tid : Nat
+  /-- Time of the sample as returned by `IO.monoNanosNow`. -/
+  time : Nat
+  /-- Indices into `InterpreterProfile.frames`, outermost frame first. -/
+  stack : Array Nat
+  /--
+  Number of sampling intervals since the previous sample of the thread, all of which are attributed to
+  this call stack.
+  -/
+  ticks : Nat
+
+/-- Call stacks of interpreted code sampled between `startInterpreterProfiler` and `stopInterpreterProfiler`. -/
+structure InterpreterProfile where
+  /-- Names of the sampled functions; functions that were called natively are suffixed with ` [native]`. -/
+  frames : Array String := #[]
+  samples : Array InterpreterSample := #[]
+
+/--
+Starts sampling the call stacks of interpreted code on all threads every `intervalUs` microseconds. Does
+nothing if the profiler is already running or `intervalUs` is zero. See also `trace.profiler.interpreter`.
+-/
+@[extern "lean_interpreter_profiler_start"]
+opaque startInterpreterProfiler (intervalUs : UInt32) : BaseIO Unit
+
+/-- Stops the interpreter profiler and returns the samples collected since it was started. -/
+@[extern "lean_interpreter_profiler_stop"]
+opaque stopInterpreterProfiler : BaseIO InterpreterProfile
+
+private def ThreadWithMaps.addInterpreterSample (profile : InterpreterProfile) (intervalUs : Nat)
+    (thread : ThreadWithMaps) (sample : InterpreterSample) : ThreadWithMaps := Id.run do
+  let category := categories.findIdx? (·.name == `Interpreter) |>.getD 0
+  let mut thread := thread
+  let mut parentStackIdx? : Option Nat := none
+  for frame in sample.stack do
+    let (stackIdx, thread') := thread.addFrame profile.frames[frame]! category parentStackIdx?
+    thread := thread'
+    parentStackIdx? := some stackIdx
+  let some stackIdx := parentStackIdx?
+    | return thread
+  let weight := (sample.ticks * intervalUs).toFloat / 1000000
+  return { thread with samples := {
+    stack := thread.samples.stack.push stackIdx
+    time := thread.samples.time.push (sample.time.toFloat / 1000000000)
+    weight := thread.samples.weight.push weight
+    threadCPUDelta := thread.samples.threadCPUDelta.push weight
+    length := thread.samples.length + 1
+  } }
+
+/--
+Converts samples of the interpreter profiler, taken every `intervalUs` microseconds, to one thread per
+sampled thread.
+-/
+def InterpreterProfile.toThreads (profile : InterpreterProfile) (name : String) (intervalUs : Nat) :
+    Array Thread :=
+  let tids := profile.samples.groupByKey (·.tid)
+  tids.toArray.qsort (fun (t1, _) (t2, _) => t1 < t2) |>.map fun (tid, samples) =>
+    let samples := samples.qsort (·.time < ·.time)
+    let thread := { Thread.new s!"{name} interpreter {tid}" with isMainThread := false }
+    samples.foldl (ThreadWithMaps.addInterpreterSample profile intervalUs) { thread with } |>.toThread
+
 def Profile.export (name : String) (startTime : Float) (traceStates : Array TraceState)
-    (opts : Options) : IO Profile := do
+    (opts : Options) (interpreterProfile : InterpreterProfile := {}) : IO Profile := do
   let tids := traceStates.groupByKey (·.tid)
   let stopTime := (← IO.monoNanosNow).toFloat / 1000000000
   let threads ← tids.toArray.qsort (fun (t1, _) (t2, _) => t1 < t2) |>.mapM fun (tid, traceStates) => do
@@ -307,9 +372,11 @@ def Profile.export (name : String) (startTime : Float) (traceStates : Array Trac
           } }
       thread ← addTrace (Lean.trace.profiler.output.pp.get opts) thread trace
     return thread
+  let interpreterThreads :=
+    interpreterProfile.toThreads name (trace.profiler.interpreter.get opts)
   return {
     «meta» := { startTime, categories }
-    threads := threads.map (·.toThread)
+    threads := threads.map (·.toThread) ++ interpreterThreads
   }
 
 structure ThreadWithCollideMaps extends ThreadWithMaps where
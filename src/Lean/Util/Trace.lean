@@ -187,6 +187,14 @@ register_builtin_option trace.profiler.output : String := {
     "output `trace.profiler` data in Firefox Profiler-compatible format to given file path"
 }
 
+register_builtin_option trace.profiler.interpreter : Nat := {
+  defValue := 0
+  group    := "profiler"
+  descr    :=
+    "if nonzero, sample the call stacks of interpreted code every given number of microseconds and \
+include them in `trace.profiler.output` as one additional thread per sampled thread"
+}
+
 register_builtin_option trace.profiler.output.pp : Bool := {
   defValue := false
   group    := "profiler"
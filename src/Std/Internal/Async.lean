@@ -11,6 +11,7 @@ public import Std.Internal.Async.Timer
 public import Std.Internal.Async.TCP
 public import Std.Internal.Async.UDP
 public import Std.Internal.Async.DNS
+public import Std.Internal.Async.File
 public import Std.Internal.Async.Select
 public import Std.Internal.Async.Process
 public import Std.Internal.Async.System
@@ -0,0 +1,106 @@
+/-
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+-/
+module
+
+prelude
+public import Std.Internal.UV.File
+public import Std.Internal.Async.Basic
+
+public section
+
+namespace Std
+namespace Internal
+namespace IO
+namespace Async
+
+open System
+
+/--
+Represents a file opened on the libuv thread pool. Unlike `IO.FS.Handle`, operations on the file
+return immediately and do not block a thread of the task manager while the system call runs.
+-/
+structure File where
+  private ofNative ::
+    native : Internal.UV.File
+
+namespace File
+
+/--
+Opens the file at `path` in the given mode.
+-/
+@[inline]
+def «open» (path : FilePath) (mode : IO.FS.Mode) : IO (AsyncTask File) :=
+  (·.map File.ofNative) <$> (AsyncTask.ofPromise <$> Internal.UV.File.open path mode)
+
+@[inline]
+private def offsetToInt64 : Option UInt64 → Int64
+  | none => -1
+  | some offset => offset.toInt64
+
+/--
+Reads up to `size` bytes from the file at `offset`, or at the current position if `offset` is `none`.
+Returns an empty array at the end of the file.
+-/
+@[inline]
+def read (f : File) (size : UInt64) (offset : Option UInt64 := none) : IO (AsyncTask ByteArray) :=
+  AsyncTask.ofPromise <$> f.native.read size (offsetToInt64 offset)
+
+/--
+Writes all of `data` to the file at `offset`, or at the current position if `offset` is `none`.
+-/
+@[inline]
+def write (f : File) (data : ByteArray) (offset : Option UInt64 := none) : IO (AsyncTask Unit) :=
+  AsyncTask.ofPromise <$> f.native.write data (offsetToInt64 offset)
+
+/--
+Flushes the data and metadata of the file to the storage device.
+-/
+@[inline]
+def fsync (f : File) : IO (AsyncTask Unit) :=
+  AsyncTask.ofPromise <$> f.native.fsync
+
+/--
+Closes the file once the operations on it that are in flight have finished. Other operations on the
+file fail afterwards. Files that are not closed explicitly are closed when they are freed.
+-/
+@[inline]
+def close (f : File) : IO (AsyncTask Unit) :=
+  AsyncTask.ofPromise <$> f.native.close
+
+/--
+Returns the metadata of the file at `path`, following symbolic links.
+-/
+@[inline]
+def metadata (path : FilePath) : IO (AsyncTask IO.FS.Metadata) :=
+  AsyncTask.ofPromise <$> Internal.UV.File.metadata path
+
+/--
+Returns the entries of the directory at `path`, without `.` and `..`.
+-/
+@[inline]
+def readDir (path : FilePath) : IO (AsyncTask (Array IO.FS.DirEntry)) :=
+  AsyncTask.ofPromise <$> Internal.UV.File.readDir path
+
+/--
+Reads the whole file at `path`.
+-/
+@[inline]
+def readFile (path : FilePath) : IO (AsyncTask ByteArray) :=
+  AsyncTask.ofPromise <$> Internal.UV.File.readFile path
+
+/--
+Replaces the contents of the file at `path` with `data`, creating the file if it does not exist.
+-/
+def writeFile (path : FilePath) (data : ByteArray) : IO (AsyncTask Unit) := do
+  let file ← File.open path .write
+  file.bindIO fun file => do
+    let written ← file.write data
+    written.bindIO fun _ => file.close
+
+end File
+end Async
+end IO
+end Internal
+end Std
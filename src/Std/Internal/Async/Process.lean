@@ -8,6 +8,8 @@ module
 prelude
 public import Std.Time
 public import Std.Internal.UV.System
+public import Std.Internal.UV.Process
+public import Std.Internal.Async.Basic
 public import Std.Data.HashMap
 
 public section
@@ -236,6 +238,23 @@ Returns the available memory for allocation in bytes.
 def availableMemory : IO UInt64 :=
   UV.System.availableMemory
 
+/--
+Runs a process to completion and captures its output and exit code, like `IO.Process.output`, but
+without blocking a thread: the process is supervised by the event loop, which reads its standard
+output and error. The child process is run with a null standard input.
+
+The specifications of standard input, output, and error handles in `args` are ignored. The task fails
+if the process cannot be spawned or if its output is not valid UTF-8.
+-/
+def output (args : IO.Process.SpawnArgs) : IO (Async.AsyncTask IO.Process.Output) := do
+  let task := Async.AsyncTask.ofPromise (← UV.Process.output args)
+  task.mapIO (sync := true) fun (exitCode, stdout, stderr) => do
+    let some stdout := String.fromUTF8? stdout
+      | throw <| .userError s!"process '{args.cmd}' wrote non UTF-8 data to stdout"
+    let some stderr := String.fromUTF8? stderr
+      | throw <| .userError s!"process '{args.cmd}' wrote non UTF-8 data to stderr"
+    return { exitCode, stdout, stderr }
+
 end Process
 end IO
 end Internal
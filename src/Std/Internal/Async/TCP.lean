@@ -49,11 +49,13 @@ def mk : IO Server := do
 
 /--
 Binds the server socket to the specified address. Address reuse is enabled to allow rebinding the
-same address.
+same address. If `reusePort` is set, several servers can listen on the same address and the kernel
+distributes incoming connections among them; as each server is on its own event loop (see
+`Std.Internal.UV.Loop.count`), this spreads the I/O of the connections over several threads.
 -/
 @[inline]
-def bind (s : Server) (addr : SocketAddress) : IO Unit :=
-  s.native.bind addr
+def bind (s : Server) (addr : SocketAddress) (reusePort : Bool := false) : IO Unit :=
+  s.native.bind addr reusePort
 
 /--
 Listens for incoming connections with the given backlog.
@@ -125,6 +127,30 @@ Sends data through the client socket.
 def send (s : Client) (data : ByteArray) : IO (AsyncTask Unit) :=
   AsyncTask.ofPromise <$> s.native.send data
 
+/--
+Sends multiple buffers through the client socket with a single write, e.g., a frame header and its
+body, without concatenating them first.
+-/
+@[inline]
+def sendAll (s : Client) (data : Array ByteArray) : IO (AsyncTask Unit) :=
+  AsyncTask.ofPromise <$> s.native.sendAll data
+
+/--
+Holds back the data of subsequent sends until the next `flush`. Batching many small messages this way
+saves system calls.
+-/
+@[inline]
+def cork (s : Client) : IO Unit :=
+  s.native.cork
+
+/--
+Writes the data held back by `cork` with a single write. If `uncork` is set, subsequent sends are
+written immediately again.
+-/
+@[inline]
+def flush (s : Client) (uncork : Bool := true) : IO Unit :=
+  s.native.flush uncork
+
 /--
 Receives data from the client socket. If data is received, it’s wrapped in .some. If EOF is reached,
 the result is .none, indicating no more data is available. Receiving data in parallel on the same
@@ -135,6 +161,31 @@ Furthermore calling this function in parallel with `recvSelector` is not support
 def recv? (s : Client) (size : UInt64) : IO (AsyncTask (Option ByteArray)) :=
   AsyncTask.ofPromise <$> s.native.recv? size
 
+/--
+Starts receiving data continuously in chunks of at most `size` bytes, which is cheaper than repeated
+calls to `recv?` for large transfers. The chunks are returned by `recvNext?`; reading is paused while
+`capacity` chunks have not been requested yet. This mode is left at the end of the stream. It must
+not be used in parallel with `recv?` or `recvSelector`.
+-/
+@[inline]
+def recvStart (s : Client) (size : UInt64) (capacity : UInt32 := 16) : IO Unit :=
+  s.native.recvStart size capacity
+
+/--
+Receives the next chunk after `recvStart`. If EOF is reached, the result is .none.
+-/
+@[inline]
+def recvNext? (s : Client) : IO (AsyncTask (Option ByteArray)) :=
+  AsyncTask.ofPromise <$> s.native.recvNext?
+
+/--
+Gives a chunk returned by `recvNext?` back to the socket so that its memory is reused for receiving
+data. This only has an effect if `data` is not shared.
+-/
+@[inline]
+def recycle (s : Client) (data : ByteArray) : IO Unit :=
+  s.native.recycle data
+
 /--
 Creates a `Selector` that resolves once `s` has data available, up to at most `size` bytes,
 and provides that data. Calling this function starts the data wait, so it must not be called
@@ -190,6 +241,14 @@ Gets the local address of the client socket.
 def getSockName (s : Client) : IO SocketAddress :=
   s.native.getSockName
 
+/--
+Returns the number of bytes received from and successfully sent on the client socket so far, in
+this order.
+-/
+@[inline]
+def byteCounts (s : Client) : IO (UInt64 × UInt64) :=
+  s.native.byteCounts
+
 /--
 Enables the Nagle algorithm for the client socket.
 -/
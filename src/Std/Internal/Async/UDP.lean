@@ -38,11 +38,12 @@ inductive Membership
 namespace Socket
 
 /--
-Creates a new UDP socket.
+Creates a new UDP socket. A `batched` socket receives multiple datagrams with a single system call
+in `recvMany` where it is supported, at the cost of a copy in `recv`.
 -/
 @[inline]
-def mk : IO Socket := do
-  let native ← Internal.UV.UDP.Socket.new
+def mk (batched : Bool := false) : IO Socket := do
+  let native ← Internal.UV.UDP.Socket.new batched
   return Socket.ofNative native
 
 /--
@@ -80,6 +81,27 @@ Furthermore calling this function in parallel with `recvSelector` is not support
 def recv (s : Socket) (size : UInt64) : IO (AsyncTask (ByteArray × Option SocketAddress)) :=
   AsyncTask.ofPromise <$> s.native.recv size
 
+/--
+Sends each element of `data` as a datagram through an UDP socket. This is cheaper than calling
+`send` for each datagram, as it needs a single promise and uses as few system calls as possible. The
+`addr` parameter specifies the destination address of all datagrams. If `addr` is `none`, they are
+sent to the default peer address set by `connect`.
+-/
+@[inline]
+def sendMany (s : Socket) (data : Array ByteArray) (addr : Option SocketAddress := none) : IO (AsyncTask Unit) :=
+  AsyncTask.ofPromise <$> s.native.sendMany data addr
+
+/--
+Receives up to `count` datagrams from an UDP socket. The promise resolves when at least one datagram
+is available or an error occurs. This is cheaper than calling `recv` for each datagram, as it needs a
+single promise and uses as few system calls as possible, in particular on sockets created with
+`batched`. Calling this function in parallel with `recv`
+or `recvSelector` is not supported.
+-/
+@[inline]
+def recvMany (s : Socket) (count : UInt32) : IO (AsyncTask (Array (ByteArray × Option SocketAddress))) :=
+  AsyncTask.ofPromise <$> s.native.recvMany count
+
 /--
 Creates a `Selector` that resolves once `s` has data available, up to at most `size` bytes,
 and provides that data. If the socket has not been previously bound with `bind`, it is
@@ -15,5 +15,7 @@ public import Std.Internal.UV.TCP
 public import Std.Internal.UV.UDP
 public import Std.Internal.UV.System
 public import Std.Internal.UV.DNS
+public import Std.Internal.UV.File
+public import Std.Internal.UV.Process
 
 @[expose] public section
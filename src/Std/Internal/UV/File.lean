@@ -0,0 +1,87 @@
+/-
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+-/
+module
+
+prelude
+public import Init.System.IO
+public import Init.System.Promise
+
+@[expose] public section
+
+namespace Std
+namespace Internal
+namespace UV
+
+open System
+
+private opaque FileImpl : NonemptyType.{0}
+
+/--
+Represents a file opened with `File.open`. File system requests run on the libuv thread pool instead
+of blocking a thread of the task manager. The file is closed when the object is freed if it has not
+been closed with `File.close` before.
+-/
+def File : Type := FileImpl.type
+
+instance : Nonempty File := FileImpl.property
+
+namespace File
+
+/--
+Opens the file at `path` in the given mode.
+-/
+@[extern "lean_uv_fs_open"]
+opaque «open» (path : @& FilePath) (mode : IO.FS.Mode) : IO (IO.Promise (Except IO.Error File))
+
+/--
+Reads up to `size` bytes from the file at `offset`, or at the current position of the file if `offset`
+is negative. Returns an empty array at the end of the file.
+-/
+@[extern "lean_uv_fs_read"]
+opaque read (file : @& File) (size : UInt64) (offset : Int64) : IO (IO.Promise (Except IO.Error ByteArray))
+
+/--
+Writes all of `data` to the file at `offset`, or at the current position of the file if `offset` is
+negative.
+-/
+@[extern "lean_uv_fs_write"]
+opaque write (file : @& File) (data : ByteArray) (offset : Int64) : IO (IO.Promise (Except IO.Error Unit))
+
+/--
+Flushes the data and metadata of the file to the storage device.
+-/
+@[extern "lean_uv_fs_fsync"]
+opaque fsync (file : @& File) : IO (IO.Promise (Except IO.Error Unit))
+
+/--
+Closes the file once the operations on it that are in flight have finished. Other operations on the
+file fail afterwards.
+-/
+@[extern "lean_uv_fs_close"]
+opaque close (file : @& File) : IO (IO.Promise (Except IO.Error Unit))
+
+/--
+Returns the metadata of the file at `path`, following symbolic links.
+-/
+@[extern "lean_uv_fs_stat"]
+opaque metadata (path : @& FilePath) : IO (IO.Promise (Except IO.Error IO.FS.Metadata))
+
+/--
+Returns the entries of the directory at `path`, without `.` and `..`.
+-/
+@[extern "lean_uv_fs_read_dir"]
+opaque readDir (path : @& FilePath) : IO (IO.Promise (Except IO.Error (Array IO.FS.DirEntry)))
+
+/--
+Reads the whole file at `path`. Opening, reading and closing the file is done by a single chain of
+requests.
+-/
+@[extern "lean_uv_fs_read_file"]
+opaque readFile (path : @& FilePath) : IO (IO.Promise (Except IO.Error ByteArray))
+
+end File
+end UV
+end Internal
+end Std
@@ -43,6 +43,65 @@ Checks if the event loop is still active and processing events.
 @[extern "lean_uv_event_loop_alive"]
 opaque alive : BaseIO Bool
 
+/--
+Returns the number of event loops. Each event loop is run by its own thread, and every socket and
+timer stays on the event loop it was created on. The number is taken from the `LEAN_NUM_UV_LOOPS`
+environment variable at startup and defaults to 1.
+-/
+@[extern "lean_uv_event_loop_count"]
+opaque count : BaseIO Nat
+
+/--
+Counters of an event loop. The counters accumulate from the start of the process.
+
+The latency histograms have 24 buckets: bucket `0` counts latencies below 1µs, bucket `i` latencies
+from `2^(i-1)` µs to below `2^i` µs, and the last bucket all longer latencies.
+-/
+structure Metrics where
+  /--
+  Number of iterations of the event loop thread. An iteration waits for events and runs their
+  callbacks, and it is cut short whenever another thread needs exclusive access to the loop.
+  -/
+  iterations : UInt64
+  /--
+  Number of events processed by the event loop. Zero if libuv is older than 1.45.
+  -/
+  events : UInt64
+  /--
+  Time in nanoseconds the event loop spent waiting for events. Zero unless the loop was configured
+  with `accumulateIdleTime`.
+  -/
+  idleTimeNs : UInt64
+  /--
+  Number of operations (e.g., TCP sends) submitted to the event loop without waiting for it.
+  -/
+  jobs : UInt64
+  /--
+  Histogram of the times threads waited for exclusive access to the event loop while it was busy.
+  -/
+  lockWaits : Array UInt64
+  /--
+  Histogram of the times operations submitted while the event loop was busy waited until they ran.
+  -/
+  jobDelays : Array UInt64
+  /--
+  Number of requests (e.g., connects, writes, file system operations) in progress.
+  -/
+  activeRequests : UInt64
+  /--
+  Number of active handles (e.g., sockets that are reading or listening, running timers) of each
+  handle type, e.g. `("tcp", 3)`.
+  -/
+  activeHandles : Array (String × Nat)
+deriving Repr, Inhabited
+
+/--
+Returns the counters of each event loop, see `count`. This briefly takes exclusive access to the
+loops, in order to inspect their handles.
+-/
+@[extern "lean_uv_event_loop_metrics"]
+opaque metrics : BaseIO (Array Metrics)
+
 end Loop
 end UV
 end Internal
@@ -0,0 +1,30 @@
+/-
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+-/
+module
+
+prelude
+public import Init.System.IO
+public import Init.System.Promise
+
+@[expose] public section
+
+namespace Std
+namespace Internal
+namespace UV
+namespace Process
+
+/--
+Spawns a process with `uv_spawn` and captures its standard output and error on the event loop. The
+standard input of the process is null, and the stdio configuration of `args` is ignored. Resolves with
+the exit code and the outputs once the process has exited and both outputs are closed.
+-/
+@[extern "lean_uv_process_output"]
+opaque output (args : @& IO.Process.SpawnArgs) :
+    IO (IO.Promise (Except IO.Error (UInt32 × ByteArray × ByteArray)))
+
+end Process
+end UV
+end Internal
+end Std
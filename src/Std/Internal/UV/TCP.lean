@@ -49,12 +49,33 @@ Sends data through a TCP socket.
 @[extern "lean_uv_tcp_send"]
 opaque send (socket : @& Socket) (data : ByteArray) : IO (IO.Promise (Except IO.Error Unit))
 
+/--
+Sends the concatenation of `data` through a TCP socket with a single write, without copying the
+buffers.
+-/
+@[extern "lean_uv_tcp_send_all"]
+opaque sendAll (socket : @& Socket) (data : Array ByteArray) : IO (IO.Promise (Except IO.Error Unit))
+
+/--
+Holds back the data of subsequent sends until the next `flush`, so that it is written in one go.
+-/
+@[extern "lean_uv_tcp_cork"]
+opaque cork (socket : @& Socket) : IO Unit
+
+/--
+Writes the data held back by `cork` with a single write. If `uncork` is set, subsequent sends are
+written immediately again.
+-/
+@[extern "lean_uv_tcp_flush"]
+opaque flush (socket : @& Socket) (uncork : Bool := true) : IO Unit
+
 /--
 Receives data from a TCP socket with a maximum size of size bytes. The promise resolves when data is
 available or an error occurs. If data is received, it’s wrapped in .some. If EOF is reached, the
 result is .none, indicating no more data is available. Receiving data in parallel on the same
 socket is not supported. Instead, we recommend binding multiple sockets to the same address.
-Furthermore calling this function in parallel with `waitReadable` is not supported.
+Furthermore calling this function in parallel with `waitReadable` is not supported, and it fails
+after `recvStart`.
 -/
 @[extern "lean_uv_tcp_recv"]
 opaque recv? (socket : @& Socket) (size : UInt64) : IO (IO.Promise (Except IO.Error (Option ByteArray)))
@@ -62,7 +83,7 @@ opaque recv? (socket : @& Socket) (size : UInt64) : IO (IO.Promise (Except IO.Er
 /--
 Returns an `IO.Promise` that resolves to `true` once `socket` has data available for reading,
 or to `false` if `socket` is closed before that. Calling this function twice on the same `Socket`
-or in parallel with `recv?` is not supported.
+or in parallel with `recv?` is not supported, and it fails after `recvStart`.
 -/
 @[extern "lean_uv_tcp_wait_readable"]
 opaque waitReadable (socket : @& Socket) : IO (IO.Promise (Except IO.Error Bool))
@@ -79,10 +100,36 @@ without causing errors, in particular also without a receive running in the firs
 opaque cancelRecv (socket : @& Socket) : IO Unit
 
 /--
-Binds a TCP socket to a specific address.
+Starts receiving data continuously: the socket stays in reading state, and the received chunks of at
+most `size` bytes are queued until they are requested by `recvNext?`. Reading is paused while
+`capacity` chunks are queued. Buffers given back by `recycle` are reused for receiving data.
+The receive mode is left at the end of the stream or by `cancelRecv`. Calling this function while
+another receive operation is pending is not supported.
+-/
+@[extern "lean_uv_tcp_recv_start"]
+opaque recvStart (socket : @& Socket) (size : UInt64) (capacity : UInt32) : IO Unit
+
+/--
+Returns the next chunk received after `recvStart`. If EOF is reached, the result is .none. Calling
+this function again before the returned promise is resolved is not supported.
+-/
+@[extern "lean_uv_tcp_recv_next"]
+opaque recvNext? (socket : @& Socket) : IO (IO.Promise (Except IO.Error (Option ByteArray)))
+
+/--
+Gives a chunk returned by `recvNext?` back to the socket so that its memory can be reused for
+receiving data. This only has an effect if `buffer` is not shared.
+-/
+@[extern "lean_uv_tcp_recycle"]
+opaque recycle (socket : @& Socket) (buffer : ByteArray) : IO Unit
+
+/--
+Binds a TCP socket to a specific address. If `reusePort` is set, several sockets can be bound to the
+same address and the kernel distributes incoming connections among them (`SO_REUSEPORT`). This is
+not supported on all platforms.
 -/
 @[extern "lean_uv_tcp_bind"]
-opaque bind (socket : @& Socket) (addr : @& SocketAddress) : IO Unit
+opaque bind (socket : @& Socket) (addr : @& SocketAddress) (reusePort : Bool := false) : IO Unit
 
 /--
 Starts listening for incoming connections on a TCP socket.
@@ -114,6 +161,12 @@ Gets the local address of a bound TCP socket.
 @[extern "lean_uv_tcp_getsockname"]
 opaque getSockName (socket : @& Socket) : IO SocketAddress
 
+/--
+Returns the number of bytes received from and successfully sent on the socket so far, in this order.
+-/
+@[extern "lean_uv_tcp_byte_counts"]
+opaque byteCounts (socket : @& Socket) : IO (UInt64 × UInt64)
+
 /--
 Enables the Nagle algorithm for a TCP socket.
 -/
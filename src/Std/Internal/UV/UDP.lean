@@ -31,10 +31,11 @@ instance : Nonempty Socket := SocketImpl.property
 namespace Socket
 
 /--
-Creates a new UDP socket.
+Creates a new UDP socket. A `batched` socket uses `recvmmsg` in `recvMany` where it is supported,
+while `recv` on it receives into a scratch buffer of the maximal datagram size.
 -/
 @[extern "lean_uv_udp_new"]
-opaque new : IO Socket
+opaque new (batched : Bool := false) : IO Socket
 
 /--
 Binds an UDP socket to a specific address. Address reuse is enabled to allow rebinding the
@@ -65,6 +66,23 @@ Furthermore calling this function in parallel with `waitReadable` is not support
 @[extern "lean_uv_udp_recv"]
 opaque recv (socket : @& Socket) (size : UInt64) : IO (IO.Promise (Except IO.Error (ByteArray × Option SocketAddress)))
 
+/--
+Sends each element of `data` as a datagram through an UDP socket, using as few system calls as
+possible (`sendmmsg` where it is supported). The `addr` parameter is the destination address of all
+datagrams. If `addr` is `none`, they are sent to the default peer address set by `connect`. The
+promise resolves once all datagrams have been sent, or with the first error that occurred.
+-/
+@[extern "lean_uv_udp_send_many"]
+opaque sendMany (socket : @& Socket) (data : Array ByteArray) (addr : @& Option SocketAddress) : IO (IO.Promise (Except IO.Error Unit))
+
+/--
+Receives up to `count` datagrams from an UDP socket, using as few system calls as possible
+(`recvmmsg` on batched sockets where it is supported). The promise resolves when at least one datagram is available or
+an error occurs. Calling this function in parallel with `recv` or `waitReadable` is not supported.
+-/
+@[extern "lean_uv_udp_recv_many"]
+opaque recvMany (socket : @& Socket) (count : UInt32) : IO (IO.Promise (Except IO.Error (Array (ByteArray × Option SocketAddress))))
+
 /--
 Returns an `IO.Promise` that resolves once `socket` has data available for reading. Calling this
 function twice on the same `Socket` or in parallel with `recv` is not supported.
@@ -43,6 +43,8 @@ extern "C" {
 #if defined(__GNUC__) || defined(__clang__)
 #define LEAN_UNLIKELY(x) (__builtin_expect((x), 0))
 #define LEAN_LIKELY(x) (__builtin_expect((x), 1))
+#define LEAN_HOT __attribute__((hot))
+#define LEAN_COLD __attribute__((cold))
 
 #ifdef NDEBUG
 #define LEAN_ALWAYS_INLINE __attribute__((always_inline))
@@ -55,6 +57,8 @@ extern "C" {
 #else
 #define LEAN_UNLIKELY(x) (x)
 #define LEAN_LIKELY(x) (x)
+#define LEAN_HOT
+#define LEAN_COLD
 #define LEAN_ALWAYS_INLINE
 #endif
 
@@ -751,6 +755,17 @@ LEAN_EXPORT lean_object* lean_apply_n(lean_object* f, unsigned n, lean_object**
 /* Pre: n > 16 */
 LEAN_EXPORT lean_object* lean_apply_m(lean_object* f, unsigned n, lean_object** args);
 
+/* Execution counters of a module compiled with `compiler.pgo.generate`. The counters of all registered modules are
+   appended to the file `$LEAN_PGO_FILE` (default: `default.leanprof`) when the process exits. */
+typedef struct lean_pgo_counters {
+    struct lean_pgo_counters * m_next;
+    size_t                     m_size;
+    char const * const *       m_names;
+    uint64_t *                 m_counts;
+} lean_pgo_counters;
+
+LEAN_EXPORT void lean_pgo_register(lean_pgo_counters * c);
+
 /* Arrays of objects (low level API) */
 static inline lean_obj_res lean_alloc_array(size_t size, size_t capacity) {
     lean_array_object * o = (lean_array_object*)lean_alloc_object(sizeof(lean_array_object) + sizeof(void*)*capacity);
@@ -15,9 +15,8 @@ expr abstract(expr const & e, unsigned n, expr const * subst) {
     lean_assert(std::all_of(subst, subst+n, [](expr const & e) { return !has_loose_bvars(e) && is_fvar(e); }));
     if (!has_fvar(e))
         return e;
-    return replace(e, [=](expr const & m, unsigned offset) -> optional<expr> {
-            if (!has_fvar(m))
-                return some_expr(m); // expression m does not contain free variables
+    auto skip = [](expr const & m, unsigned) { return !has_fvar(m); };
+    return replace_rec(e, skip, [=](expr const & m, unsigned offset) -> optional<expr> {
             if (is_fvar(m)) {
                 unsigned i = n;
                 while (i > 0) {
@@ -43,9 +42,8 @@ static object * lean_expr_abstract_core(object * e0, size_t n, object * subst) {
         lean_inc(e0);
         return e0;
     }
-    expr r = replace(e, [=](expr const & m, unsigned offset) -> optional<expr> {
-            if (!has_fvar(m) && !has_mvar(m))
-                return some_expr(m); // expression m does not contain free/meta variables
+    auto skip = [](expr const & m, unsigned) { return !has_fvar(m) && !has_mvar(m); };
+    expr r = replace_rec(e, skip, [=](expr const & m, unsigned offset) -> optional<expr> {
             bool fv = is_fvar(m);
             bool mv = is_mvar(m);
             if (fv || mv) {
@@ -22,6 +22,8 @@ extern "C" object* lean_environment_add(object*, object*);
 extern "C" object* lean_environment_find(object*, object*);
 extern "C" object* lean_environment_mark_quot_init(object*);
 extern "C" uint8 lean_environment_quot_init(object*);
+extern "C" uint8 lean_kernel_environment_is_imported(object*, object*);
+extern "C" object* lean_kernel_environment_imported_constants(object*);
 extern "C" object* lean_kernel_record_unfold (object*, object*);
 extern "C" object* lean_kernel_get_diag(object*);
 extern "C" object* lean_kernel_set_diag(object*, object*);
@@ -67,6 +69,14 @@ bool environment::is_quot_initialized() const {
     return lean_environment_quot_init(to_obj_arg()) != 0;
 }
 
+bool environment::is_imported(name const & n) const {
+    return lean_kernel_environment_is_imported(to_obj_arg(), n.to_obj_arg()) != 0;
+}
+
+object_ref environment::get_imported_constants() const {
+    return object_ref(lean_kernel_environment_imported_constants(to_obj_arg()));
+}
+
 void environment::mark_quot_initialized() {
     m_obj = lean_environment_mark_quot_init(m_obj);
 }
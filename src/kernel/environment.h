@@ -87,6 +87,13 @@ public:
 
     bool is_quot_initialized() const;
 
+    /** \brief Return true iff the constant \c n was imported from another module. */
+    bool is_imported(name const & n) const;
+
+    /** \brief Return the map of imported constants. It is shared by all environments derived from the same
+        imports, so its address identifies them. */
+    object_ref get_imported_constants() const;
+
     /** \brief Return information for the constant with name \c n (if it is defined in this environment). */
     optional<constant_info> find(name const & n) const;
 
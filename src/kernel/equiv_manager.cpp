@@ -7,6 +7,7 @@ Author: Leonardo de Moura
 #include "runtime/interrupt.h"
 #include "runtime/flet.h"
 #include "kernel/equiv_manager.h"
+#include "kernel/type_checker.h"
 
 namespace lean {
 auto equiv_manager::mk_node() -> node_ref {
@@ -31,6 +32,8 @@ void equiv_manager::merge(node_ref n1, node_ref n2) {
     node_ref r1 = find(n1);
     node_ref r2 = find(n2);
     if (r1 != r2) {
+        if (g_kernel_stats)
+            g_kernel_stats->m_eqv_merges++;
         node & ref1 = m_nodes[r1];
         node & ref2 = m_nodes[r2];
         if (ref1.m_rank < ref2.m_rank) {
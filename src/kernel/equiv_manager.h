@@ -30,5 +30,6 @@ public:
     equiv_manager():m_use_hash(false) {}
     bool is_equiv(expr const & e1, expr const & e2, bool use_hash = false);
     void add_equiv(expr const & e1, expr const & e2);
+    size_t num_nodes() const { return m_nodes.size(); }
 };
 }
@@ -390,7 +390,7 @@ bool has_loose_bvar(expr const & e, unsigned i) {
     if (!has_loose_bvars(e))
         return false;
     bool found = false;
-    for_each(e, [&](expr const & e, unsigned offset) {
+    for_each_offset(e, [&](expr const & e, unsigned offset) {
             if (found)
                 return false; // already found
             unsigned n_i = i + offset;
@@ -418,12 +418,13 @@ expr lower_loose_bvars(expr const & e, unsigned s, unsigned d) {
     if (d == 0 || s >= get_loose_bvar_range(e))
         return e;
     lean_assert(s >= d);
-    return replace(e, [=](expr const & e, unsigned offset) -> optional<expr> {
+    auto skip = [=](expr const & e, unsigned offset) {
+        unsigned s1 = s + offset;
+        // overflow (vidx can't be >= max unsigned), or e does not contain bound variables with idx >= s1
+        return s1 < s || s1 >= get_loose_bvar_range(e);
+    };
+    return replace_rec(e, skip, [=](expr const & e, unsigned offset) -> optional<expr> {
             unsigned s1 = s + offset;
-            if (s1 < s)
-                return some_expr(e); // overflow, vidx can't be >= max unsigned
-            if (s1 >= get_loose_bvar_range(e))
-                return some_expr(e); // expression e does not contain bound variables with idx >= s1
             if (is_bvar(e) && bvar_idx(e) >= s1) {
                 lean_assert(bvar_idx(e) >= offset + d);
                 return some_expr(mk_bvar(bvar_idx(e) - nat(d)));
@@ -448,12 +449,12 @@ extern "C" LEAN_EXPORT object * lean_expr_lower_loose_bvars(b_obj_arg e, b_obj_a
 expr lift_loose_bvars(expr const & e, unsigned s, unsigned d) {
     if (d == 0 || s >= get_loose_bvar_range(e))
         return e;
-    return replace(e, [=](expr const & e, unsigned offset) -> optional<expr> {
-            unsigned s1 = s + offset;
-            if (s1 < s)
-                return some_expr(e); // overflow, vidx can't be >= max unsigned
-            if (s1 >= get_loose_bvar_range(e))
-                return some_expr(e); // expression e does not contain bound variables with idx >= s1
+    auto skip = [=](expr const & e, unsigned offset) {
+        unsigned s1 = s + offset;
+        // overflow (vidx can't be >= max unsigned), or e does not contain bound variables with idx >= s1
+        return s1 < s || s1 >= get_loose_bvar_range(e);
+    };
+    return replace_rec(e, skip, [=](expr const & e, unsigned offset) -> optional<expr> {
             if (is_var(e) && bvar_idx(e) >= s + offset) {
                 return some_expr(mk_bvar(bvar_idx(e) + nat(d)));
             } else {
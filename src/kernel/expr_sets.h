@@ -5,12 +5,12 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #pragma once
-#include <unordered_set>
 #include <utility>
 #include <functional>
 #include "runtime/hash.h"
+#include "util/flat_hash_map.h"
 #include "kernel/expr.h"
 
 namespace lean {
-typedef std::unordered_set<expr, expr_hash, std::equal_to<expr>> expr_set;
+typedef flat_hash_set<expr, expr_hash, std::equal_to<expr>> expr_set;
 }
@@ -9,10 +9,76 @@ Author: Leonardo de Moura
 #include <utility>
 #include <functional>
 #include "runtime/buffer.h"
+#include "util/flat_hash_map.h"
 #include "kernel/expr.h"
 #include "kernel/expr_sets.h"
 
 namespace lean {
+/** \brief Header-only version of `for_each` with scope levels, see below. `F` is inlined instead of
+    being called through `std::function`. */
+template<typename F>
+class for_each_offset_fn {
+    ptr_offset_hash_set<lean_object> m_cache;
+    F const &                        m_f;
+
+    bool visited(expr const & e, unsigned offset) {
+        if (is_likely_unshared(e)) return false;
+        return !m_cache.insert(std::make_pair(e.raw(), offset)).second;
+    }
+
+    void apply(expr const & e, unsigned offset) {
+        switch (e.kind()) {
+        case expr_kind::Const: case expr_kind::BVar: case expr_kind::Sort:
+            m_f(e, offset);
+            return;
+        default:
+            break;
+        }
+
+        if (visited(e, offset))
+            return;
+
+        if (!m_f(e, offset))
+            return;
+
+        switch (e.kind()) {
+        case expr_kind::Const: case expr_kind::BVar:
+        case expr_kind::Sort:  case expr_kind::Lit:
+        case expr_kind::MVar:  case expr_kind::FVar:
+            return;
+        case expr_kind::MData:
+            apply(mdata_expr(e), offset);
+            return;
+        case expr_kind::Proj:
+            apply(proj_expr(e), offset);
+            return;
+        case expr_kind::App:
+            apply(app_fn(e), offset);
+            apply(app_arg(e), offset);
+            return;
+        case expr_kind::Lambda: case expr_kind::Pi:
+            apply(binding_domain(e), offset);
+            apply(binding_body(e), offset+1);
+            return;
+        case expr_kind::Let:
+            apply(let_type(e), offset);
+            apply(let_value(e), offset);
+            apply(let_body(e), offset+1);
+            return;
+        }
+    }
+
+public:
+    for_each_offset_fn(F const & f):m_f(f) {} // NOLINT
+    void operator()(expr const & e) { apply(e, 0); }
+};
+
+template<typename F>
+void for_each_offset(expr const & e, F const & f) {
+    for_each_offset_fn<F> fn(f);
+    fn(e);
+}
+
 /**
 \brief Expression visitor.
 
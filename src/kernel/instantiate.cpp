@@ -12,15 +12,21 @@ Author: Leonardo de Moura
 #include "kernel/instantiate.h"
 
 namespace lean {
+/* `m` does not contain loose bound variables with idx >= offset */
+static inline bool skip_closed_from_offset(expr const & m, unsigned offset) {
+    return offset >= get_loose_bvar_range(m);
+}
+
 expr instantiate(expr const & a, unsigned s, unsigned n, expr const * subst) {
     if (s >= get_loose_bvar_range(a) || n == 0)
         return a;
-    return replace(a, [=](expr const & m, unsigned offset) -> optional<expr> {
+    auto skip = [=](expr const & m, unsigned offset) {
+        unsigned s1 = s + offset;
+        // overflow (vidx can't be >= max unsigned), or m does not contain loose bound variables with idx >= s1
+        return s1 < s || s1 >= get_loose_bvar_range(m);
+    };
+    return replace_rec(a, skip, [=](expr const & m, unsigned offset) -> optional<expr> {
             unsigned s1 = s + offset;
-            if (s1 < s)
-                return some_expr(m); // overflow, vidx can't be >= max unsigned
-            if (s1 >= get_loose_bvar_range(m))
-                return some_expr(m); // expression m does not contain loose bound variables with idx >= s1
             if (is_bvar(m)) {
                 nat const & vidx = bvar_idx(m);
                 if (vidx >= s1) {
@@ -58,9 +64,7 @@ static object * lean_expr_instantiate_core(b_obj_arg a0, size_t n, object** subs
         lean_inc(a0);
         return a0;
     }
-    expr r = replace(a, [=](expr const & m, unsigned offset) -> optional<expr> {
-            if (offset >= get_loose_bvar_range(m))
-                return some_expr(m); // expression m does not contain loose bound variables with idx >= offset
+    expr r = replace_rec(a, skip_closed_from_offset, [=](expr const & m, unsigned offset) -> optional<expr> {
             if (is_bvar(m)) {
                 nat const & vidx = bvar_idx(m);
                 if (vidx >= offset) {
@@ -99,9 +103,7 @@ extern "C" LEAN_EXPORT object * lean_expr_instantiate_range(b_obj_arg a, b_obj_a
 expr instantiate_rev(expr const & a, unsigned n, expr const * subst) {
     if (!has_loose_bvars(a))
         return a;
-    return replace(a, [=](expr const & m, unsigned offset) -> optional<expr> {
-            if (offset >= get_loose_bvar_range(m))
-                return some_expr(m); // expression m does not contain loose bound variables with idx >= offset
+    return replace_rec(a, skip_closed_from_offset, [=](expr const & m, unsigned offset) -> optional<expr> {
             if (is_bvar(m)) {
                 nat const & vidx = bvar_idx(m);
                 if (vidx >= offset) {
@@ -123,9 +125,7 @@ static object * lean_expr_instantiate_rev_core(object * a0, size_t n, object **
         lean_inc(a0);
         return a0;
     }
-    expr r = replace(a, [=](expr const & m, unsigned offset) -> optional<expr> {
-            if (offset >= get_loose_bvar_range(m))
-                return some_expr(m); // expression m does not contain loose bound variables with idx >= offset
+    expr r = replace_rec(a, skip_closed_from_offset, [=](expr const & m, unsigned offset) -> optional<expr> {
             if (is_bvar(m)) {
                 nat const & vidx = bvar_idx(m);
                 if (vidx >= offset) {
@@ -161,6 +161,75 @@ extern "C" LEAN_EXPORT object * lean_expr_instantiate_rev_range(b_obj_arg a, b_o
     }
 }
 
+namespace {
+struct skip_closed_from_offset_fn {
+    bool operator()(expr const & m, unsigned offset) const { return skip_closed_from_offset(m, offset); }
+};
+
+/* The replacement function of `instantiate_rev_beta`. Applications are handled a whole spine at a time, so that
+   the head is only inspected once per spine and inner applications of the spine are never visited on their own.
+   Their arguments are instantiated by the same traversal `m_rec`, so that shared subterms are only visited once for
+   each scope level. */
+struct instantiate_rev_beta_fn {
+    unsigned     m_n;
+    expr const * m_subst;
+    replace_rec_fn<skip_closed_from_offset_fn, instantiate_rev_beta_fn> * m_rec = nullptr;
+
+    optional<expr> operator()(expr const & m, unsigned offset) const {
+        unsigned s1 = offset;
+        unsigned h  = s1 + m_n;
+        auto in_range = [&](nat const & vidx) {
+            return vidx >= s1 && (h < s1 /* overflow, h is bigger than any vidx */ || (vidx.is_small() && vidx.get_small_value() < h));
+        };
+        if (is_app(m)) {
+            // the applications of the spine, outermost first
+            buffer<expr const *> spine;
+            expr const * it = &m;
+            while (is_app(*it)) {
+                spine.push_back(it);
+                it = &app_fn(*it);
+            }
+            expr const & fn = *it;
+            if (is_bvar(fn) && in_range(bvar_idx(fn))) {
+                expr const & v = m_subst[m_n - (bvar_idx(fn).get_small_value() - s1) - 1];
+                if (is_lambda(v)) {
+                    buffer<expr> rev_args;
+                    for (expr const * app : spine)
+                        rev_args.push_back((*m_rec)(app_arg(*app), offset));
+                    return some_expr(head_beta_reduce(apply_beta(lift_loose_bvars(v, offset), rev_args.size(), rev_args.data())));
+                }
+            }
+            expr r = (*m_rec)(fn, offset);
+            unsigned i = spine.size();
+            while (i > 0) {
+                --i;
+                expr const & app = *spine[i];
+                r = update_app(app, r, (*m_rec)(app_arg(app), offset));
+            }
+            return some_expr(r);
+        } else if (is_bvar(m)) {
+            nat const & vidx = bvar_idx(m);
+            if (in_range(vidx)) {
+                return some_expr(lift_loose_bvars(m_subst[m_n - (vidx.get_small_value() - s1) - 1], offset));
+            } else if (vidx >= s1) {
+                return some_expr(mk_bvar(vidx - nat(m_n)));
+            }
+        }
+        return none_expr();
+    }
+};
+}
+
+expr instantiate_rev_beta(expr const & a, unsigned n, expr const * subst) {
+    if (!has_loose_bvars(a) || n == 0)
+        return a;
+    skip_closed_from_offset_fn skip;
+    instantiate_rev_beta_fn f{n, subst};
+    replace_rec_fn<skip_closed_from_offset_fn, instantiate_rev_beta_fn> rec(skip, f, true);
+    f.m_rec = &rec;
+    return rec(a);
+}
+
 bool is_head_beta(expr const & t) {
     return is_app(t) && is_lambda(get_app_fn(t));
 }
@@ -232,9 +301,8 @@ expr cheap_beta_reduce(expr const & e) {
 expr instantiate_lparams(expr const & e, names const & lps, levels const & ls) {
     if (!has_param_univ(e))
         return e;
-    return replace(e, [&](expr const & e) -> optional<expr> {
-            if (!has_param_univ(e))
-                return some_expr(e);
+    auto skip = [](expr const & e, unsigned) { return !has_param_univ(e); };
+    return replace_rec(e, skip, [&](expr const & e, unsigned) -> optional<expr> {
             if (is_constant(e)) {
                 return some_expr(update_constant(e, map_reuse(const_levels(e), [&](level const & l) { return instantiate(l, lps, ls); })));
             } else if (is_sort(e)) {
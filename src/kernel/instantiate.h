@@ -24,6 +24,14 @@ inline expr instantiate_rev(expr const & e, buffer<expr> const & s) {
     return instantiate_rev(e, s.size(), s.data());
 }
 
+/** \brief Similar to `instantiate_rev`, but beta-reduces applications `x a_1 ... a_k` in \c e where the
+    bound variable `x` is replaced with a lambda. This is `instantiate_rev` followed by `head_beta_reduce`
+    at those applications, without materializing the intermediate redexes. */
+expr instantiate_rev_beta(expr const & e, unsigned n, expr const * s);
+inline expr instantiate_rev_beta(expr const & e, buffer<expr> const & s) {
+    return instantiate_rev_beta(e, s.size(), s.data());
+}
+
 expr apply_beta(expr f, unsigned num_rev_args, expr const * rev_args, bool preserve_data = true, bool zeta = false);
 bool is_head_beta(expr const & t);
 expr head_beta_reduce(expr const & t);
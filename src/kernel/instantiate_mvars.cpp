@@ -5,8 +5,8 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Authors: Leonardo de Moura
 */
 #include <vector>
-#include <unordered_map>
 #include "util/name_set.h"
+#include "util/flat_hash_map.h"
 #include "runtime/option_ref.h"
 #include "runtime/array_ref.h"
 #include "kernel/instantiate.h"
@@ -33,7 +33,7 @@ option_ref<level> get_lmvar_assignment(metavar_ctx & mctx, name const & mid) {
 
 class instantiate_lmvars_fn {
     metavar_ctx & m_mctx;
-    std::unordered_map<lean_object *, level> m_cache;
+    ptr_hash_map<lean_object, level> m_cache;
     std::vector<level> m_saved; // Helper vector to prevent values from being garbage collected
 
     inline level cache(level const & l, level r, bool shared) {
@@ -120,9 +120,8 @@ expr replace_fvars(expr const & e, array_ref<expr> const & fvars, expr const * r
     size_t sz = fvars.size();
     if (sz == 0)
         return e;
-    return replace(e, [=](expr const & m, unsigned offset) -> optional<expr> {
-            if (!has_fvar(m))
-                return some_expr(m); // expression m does not contain free variables
+    auto skip = [](expr const & m, unsigned) { return !has_fvar(m); };
+    return replace_rec(e, skip, [=](expr const & m, unsigned offset) -> optional<expr> {
             if (is_fvar(m)) {
                 size_t i = sz;
                 name const & fid = fvar_name(m);
@@ -141,7 +140,7 @@ class instantiate_mvars_fn {
     metavar_ctx & m_mctx;
     instantiate_lmvars_fn m_level_fn;
     name_set m_already_normalized; // Store metavariables whose assignment has already been normalized.
-    std::unordered_map<lean_object *, expr> m_cache;
+    ptr_hash_map<lean_object, expr> m_cache;
     std::vector<expr> m_saved; // Helper vector to prevent values from being garbage collected
 
     level visit_level(level const & l) {
@@ -6,11 +6,94 @@ Author: Leonardo de Moura
 */
 #pragma once
 #include <tuple>
+#include <utility>
 #include "runtime/interrupt.h"
 #include "kernel/expr.h"
+#include "util/flat_hash_map.h"
 #include "kernel/expr_maps.h"
 
 namespace lean {
+/**
+   \brief Header-only version of `replace` for the hot kernel utilities (`instantiate`, `abstract`, ...).
+
+   `F` is a template parameter, so it is inlined instead of being called through `std::function`.
+   Moreover, a subexpression \c s at scope level \c n is returned unchanged if <tt>skip(s, n)</tt>
+   holds, before the cache is consulted or \c f is invoked. \c skip should only test the
+   data cached in the expression, e.g., `get_loose_bvar_range` or `has_fvar`.
+*/
+template<typename Skip, typename F>
+class replace_rec_fn {
+    ptr_offset_hash_map<lean_object, expr> m_cache;
+    Skip const &                           m_skip;
+    F const &                              m_f;
+    bool                                   m_use_cache;
+
+    expr save_result(expr const & e, unsigned offset, expr r, bool shared) {
+        if (shared)
+            m_cache.insert(mk_pair(mk_pair(e.raw(), offset), r));
+        return r;
+    }
+
+    expr apply(expr const & e, unsigned offset) {
+        if (m_skip(e, offset))
+            return e;
+        bool shared = false;
+        if (m_use_cache && !is_likely_unshared(e)) {
+            auto it = m_cache.find(mk_pair(e.raw(), offset));
+            if (it != m_cache.end())
+                return it->second;
+            shared = true;
+        }
+        if (optional<expr> r = m_f(e, offset)) {
+            return save_result(e, offset, std::move(*r), shared);
+        } else {
+            switch (e.kind()) {
+            case expr_kind::Const: case expr_kind::Sort:
+            case expr_kind::BVar:  case expr_kind::Lit:
+            case expr_kind::MVar:  case expr_kind::FVar:
+                return save_result(e, offset, e, shared);
+            case expr_kind::MData: {
+                expr new_e = apply(mdata_expr(e), offset);
+                return save_result(e, offset, update_mdata(e, new_e), shared);
+            }
+            case expr_kind::Proj: {
+                expr new_e = apply(proj_expr(e), offset);
+                return save_result(e, offset, update_proj(e, new_e), shared);
+            }
+            case expr_kind::App: {
+                expr new_f = apply(app_fn(e), offset);
+                expr new_a = apply(app_arg(e), offset);
+                return save_result(e, offset, update_app(e, new_f, new_a), shared);
+            }
+            case expr_kind::Pi: case expr_kind::Lambda: {
+                expr new_d = apply(binding_domain(e), offset);
+                expr new_b = apply(binding_body(e), offset+1);
+                return save_result(e, offset, update_binding(e, new_d, new_b), shared);
+            }
+            case expr_kind::Let: {
+                expr new_t = apply(let_type(e), offset);
+                expr new_v = apply(let_value(e), offset);
+                expr new_b = apply(let_body(e), offset+1);
+                return save_result(e, offset, update_let(e, new_t, new_v, new_b), shared);
+            }
+            }
+            lean_unreachable();
+        }
+    }
+public:
+    replace_rec_fn(Skip const & skip, F const & f, bool use_cache):m_skip(skip), m_f(f), m_use_cache(use_cache) {}
+    expr operator()(expr const & e) { return apply(e, 0); }
+    /** \brief Replace in a subexpression \c e at scope level \c offset, sharing the cache with the enclosing traversal.
+        This can be used by \c f to process subexpressions before combining them. */
+    expr operator()(expr const & e, unsigned offset) { return apply(e, offset); }
+};
+
+template<typename Skip, typename F>
+expr replace_rec(expr const & e, Skip const & skip, F const & f, bool use_cache = true) {
+    replace_rec_fn<Skip, F> fn(skip, f, use_cache);
+    return fn(e);
+}
+
 /**
    \brief Apply <tt>f</tt> to the subexpressions of a given expression.
 
@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+#include <sstream>
+#include "runtime/thread.h"
+#include "kernel/shared_cache.h"
+#include "kernel/expr_maps.h"
+#include "kernel/for_each_fn.h"
+
+namespace lean {
+static constexpr unsigned g_num_shards = 16;
+
+/* We approximate LRU eviction using two generations: an entry found in `m_prev` is moved to `m_curr`,
+   and when `m_curr` is full, it becomes `m_prev` and the old `m_prev` is dropped. */
+struct shared_cache_table {
+    expr_map<expr> m_curr;
+    expr_map<expr> m_prev;
+};
+
+struct shared_cache_shard {
+    mutex              m_mutex;
+    /* Token of the current imports, entries for other tokens are ignored. */
+    uint64             m_token     = 0;
+    size_t             m_max_gen   = 0;
+    shared_cache_table m_tables[2];
+    uint64             m_hits      = 0;
+    uint64             m_misses    = 0;
+    uint64             m_inserts   = 0;
+    uint64             m_evictions = 0;
+
+    void clear() {
+        for (shared_cache_table & t : m_tables) {
+            t.m_curr.clear();
+            t.m_prev.clear();
+        }
+    }
+};
+
+/* `g_mutex` protects the fields below and the fields `m_token` and `m_max_gen` of all shards. The shards
+   are locked after `g_mutex`. */
+static mutex *              g_mutex    = nullptr;
+static shared_cache_shard * g_shards   = nullptr;
+static object *             g_imports  = nullptr;
+static uint64               g_token    = 0;
+static size_t               g_capacity = 0;
+static uint64               g_resets   = 0;
+
+LEAN_THREAD_VALUE(bool, g_enabled, false);
+
+static shared_cache_shard & get_shard(expr const & e) {
+    return g_shards[hash(e) % g_num_shards];
+}
+
+uint64 shared_cache_begin(environment const & env) {
+    if (!g_enabled)
+        return 0;
+    object_ref imports = env.get_imported_constants();
+    lock_guard<mutex> lock(*g_mutex);
+    if (imports.raw() != g_imports) {
+        /* We keep a reference to the imports so that their address cannot be reused by other imports.
+           The object may be shared with other threads from now on. */
+        mark_mt(imports.raw());
+        if (g_imports)
+            dec_ref(g_imports);
+        g_imports = imports.steal();
+        g_token++;
+        if (g_token > 1)
+            g_resets++;
+        for (unsigned i = 0; i < g_num_shards; i++) {
+            lock_guard<mutex> shard_lock(g_shards[i].m_mutex);
+            g_shards[i].m_token = g_token;
+            g_shards[i].clear();
+        }
+    }
+    return g_token;
+}
+
+optional<expr> shared_cache_find(uint64 token, shared_cache_kind k, expr const & e) {
+    shared_cache_shard & s = get_shard(e);
+    lock_guard<mutex> lock(s.m_mutex);
+    if (s.m_token != token)
+        return none_expr();
+    shared_cache_table & t = s.m_tables[static_cast<unsigned>(k)];
+    auto it = t.m_curr.find(e);
+    if (it != t.m_curr.end()) {
+        s.m_hits++;
+        return some_expr(it->second);
+    }
+    it = t.m_prev.find(e);
+    if (it == t.m_prev.end()) {
+        s.m_misses++;
+        return none_expr();
+    }
+    s.m_hits++;
+    expr r = it->second;
+    if (t.m_curr.size() < s.m_max_gen) {
+        t.m_curr.insert(*it);
+        t.m_prev.erase(it);
+    }
+    return some_expr(r);
+}
+
+/* Return true iff `e` only mentions constants imported by `env`. */
+static bool only_imported_constants(environment const & env, expr const & e) {
+    bool r = true;
+    for_each(e, [&](expr const & s) {
+            if (!r)
+                return false;
+            if (is_constant(s) && !env.is_imported(const_name(s)))
+                r = false;
+            return r;
+        });
+    return r;
+}
+
+void shared_cache_insert(uint64 token, shared_cache_kind k, environment const & env, expr const & e, expr const & r) {
+    lean_assert(!has_fvar(e) && !has_mvar(e) && !has_loose_bvars(e));
+    if (!only_imported_constants(env, e) || !only_imported_constants(env, r))
+        return;
+    /* The terms may be accessed by other threads from now on. */
+    mark_mt(e.raw());
+    mark_mt(r.raw());
+    shared_cache_shard & s = get_shard(e);
+    lock_guard<mutex> lock(s.m_mutex);
+    if (s.m_token != token || s.m_max_gen == 0)
+        return;
+    shared_cache_table & t = s.m_tables[static_cast<unsigned>(k)];
+    if (t.m_curr.size() >= s.m_max_gen) {
+        s.m_evictions += t.m_prev.size();
+        t.m_prev = std::move(t.m_curr);
+        t.m_curr.clear();
+    }
+    if (t.m_curr.insert(mk_pair(e, r)).second)
+        s.m_inserts++;
+}
+
+/* enterSharedCache (capacity : USize) : BaseIO Unit */
+extern "C" LEAN_EXPORT obj_res lean_kernel_shared_cache_enter(size_t capacity, obj_arg) {
+    g_enabled = capacity > 0;
+    lock_guard<mutex> lock(*g_mutex);
+    if (capacity != g_capacity) {
+        g_capacity = capacity;
+        /* Each shard holds at most two generations for each kind of result. */
+        size_t max_gen = std::max<size_t>(1, capacity / (4 * g_num_shards));
+        for (unsigned i = 0; i < g_num_shards; i++) {
+            lock_guard<mutex> shard_lock(g_shards[i].m_mutex);
+            g_shards[i].m_max_gen = max_gen;
+        }
+    }
+    return lean_io_result_mk_ok(box(0));
+}
+
+/* leaveSharedCache : BaseIO Unit */
+extern "C" LEAN_EXPORT obj_res lean_kernel_shared_cache_leave(obj_arg) {
+    g_enabled = false;
+    return lean_io_result_mk_ok(box(0));
+}
+
+/* sharedCacheStats : BaseIO String */
+extern "C" LEAN_EXPORT obj_res lean_kernel_shared_cache_stats(obj_arg) {
+    uint64 hits = 0, misses = 0, inserts = 0, evictions = 0;
+    size_t size = 0, capacity, resets;
+    {
+        lock_guard<mutex> lock(*g_mutex);
+        capacity = g_capacity;
+        resets   = g_resets;
+        for (unsigned i = 0; i < g_num_shards; i++) {
+            shared_cache_shard & s = g_shards[i];
+            lock_guard<mutex> shard_lock(s.m_mutex);
+            hits      += s.m_hits;
+            misses    += s.m_misses;
+            inserts   += s.m_inserts;
+            evictions += s.m_evictions;
+            for (shared_cache_table const & t : s.m_tables)
+                size += t.m_curr.size() + t.m_prev.size();
+        }
+    }
+    std::ostringstream out;
+    out << "{\"capacity\":" << capacity
+        << ",\"size\":" << size
+        << ",\"hits\":" << hits
+        << ",\"misses\":" << misses
+        << ",\"inserts\":" << inserts
+        << ",\"evictions\":" << evictions
+        << ",\"resets\":" << resets
+        << "}";
+    return lean_io_result_mk_ok(mk_string(out.str()));
+}
+
+void initialize_shared_cache() {
+    g_mutex  = new mutex();
+    g_shards = new shared_cache_shard[g_num_shards];
+}
+
+void finalize_shared_cache() {
+    delete[] g_shards;
+    delete g_mutex;
+    if (g_imports)
+        dec_ref(g_imports);
+}
+}
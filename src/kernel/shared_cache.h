@@ -0,0 +1,30 @@
+/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+#pragma once
+#include "kernel/environment.h"
+
+namespace lean {
+/** \brief Bounded cache of type checker results that is shared by all declarations checked by the
+    process (option `kernel.sharedCache`).
+
+    It only stores results for terms without free variables and metavariables that only mention imported
+    constants. These results do not depend on the declaration being checked, so they can be reused by
+    all declarations of the current module. The cache is thread-safe, and it is reset when it is used
+    with an environment with different imports.
+
+    The cache is only used on threads that have called `lean_kernel_shared_cache_enter`. */
+enum class shared_cache_kind { InferType, Whnf };
+
+/** \brief Return a nonzero token for using the shared cache with type checkers for \c env, or `0` if
+    the shared cache is not enabled on this thread. */
+uint64 shared_cache_begin(environment const & env);
+/** \brief Return the cached result for \c e. */
+optional<expr> shared_cache_find(uint64 token, shared_cache_kind k, expr const & e);
+/** \brief Store \c r as the result for \c e if \c e only mentions constants imported by \c env. */
+void shared_cache_insert(uint64 token, shared_cache_kind k, environment const & env, expr const & e, expr const & r);
+
+void initialize_shared_cache();
+void finalize_shared_cache();
+}
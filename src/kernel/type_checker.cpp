@@ -6,6 +6,8 @@ Author: Leonardo de Moura
 */
 #include <utility>
 #include <vector>
+#include <string>
+#include <sstream>
 #include "runtime/interrupt.h"
 #include "runtime/sstream.h"
 #include "runtime/flet.h"
@@ -41,8 +43,73 @@ static expr * g_nat_xor      = nullptr;
 static expr * g_nat_shiftLeft  = nullptr;
 static expr * g_nat_shiftRight = nullptr;
 
+LEAN_THREAD_GLOBAL_PTR(kernel_stats, g_kernel_stats);
+
+static inline void inc_stat(uint64 kernel_stats::* f) {
+    if (g_kernel_stats)
+        g_kernel_stats->*f += 1;
+}
+
+static inline void inc_cache_stat(bool hit, uint64 kernel_stats::* hits, uint64 kernel_stats::* misses) {
+    if (g_kernel_stats)
+        g_kernel_stats->*(hit ? hits : misses) += 1;
+}
+
+static inline void record_nat_stat(bool big) {
+    if (g_kernel_stats) {
+        g_kernel_stats->m_nat_ops++;
+        if (big)
+            g_kernel_stats->m_nat_big_ops++;
+    }
+}
+
+static inline void record_nat_op(nat const & v1, nat const & v2, nat const & r) {
+    record_nat_stat(!v1.is_small() || !v2.is_small() || !r.is_small());
+}
+
+static inline void record_nat_unop(nat const & v, nat const & r) {
+    record_nat_stat(!v.is_small() || !r.is_small());
+}
+
+/* Predicates produce a `Bool`, so only the arguments may be big. */
+static inline void record_nat_pred(nat const & v1, nat const & v2) {
+    record_nat_stat(!v1.is_small() || !v2.is_small());
+}
+
+void kernel_stats::display_json(std::ostream & out) const {
+    out << "{\"whnf_core\":" << m_whnf_core
+        << ",\"whnf\":" << m_whnf
+        << ",\"is_def_eq_core\":" << m_is_def_eq_core
+        << ",\"lazy_delta_reduction_step\":" << m_lazy_delta_steps
+        << ",\"delta_unfolds\":" << m_delta_unfolds
+        << ",\"cache\":{"
+        << "\"infer_type\":{\"hits\":" << m_infer_hits << ",\"misses\":" << m_infer_misses << ",\"max_size\":" << m_max_infer_cache << "}"
+        << ",\"whnf_core\":{\"hits\":" << m_whnf_core_hits << ",\"misses\":" << m_whnf_core_misses << ",\"max_size\":" << m_max_whnf_core_cache << "}"
+        << ",\"whnf\":{\"hits\":" << m_whnf_hits << ",\"misses\":" << m_whnf_misses << ",\"max_size\":" << m_max_whnf_cache << "}"
+        << ",\"failure\":{\"hits\":" << m_failure_hits << ",\"misses\":" << m_failure_misses << ",\"max_size\":" << m_max_failure_cache << "}"
+        << ",\"shared\":{\"hits\":" << m_shared_hits << ",\"misses\":" << m_shared_misses << "}"
+        << "}"
+        << ",\"equiv_manager\":{\"merges\":" << m_eqv_merges << ",\"max_nodes\":" << m_max_eqv_nodes << "}"
+        << ",\"nat\":{\"ops\":" << m_nat_ops << ",\"gmp_ops\":" << m_nat_big_ops << "}"
+        << "}";
+}
+
 type_checker::state::state(environment const & env):
-    m_env(env), m_ngen(*g_kernel_fresh) {}
+    m_env(env), m_ngen(*g_kernel_fresh), m_shared_cache(shared_cache_begin(env)) {}
+
+/** \brief Return true if results for \c e may be stored in the shared cache. We only use it for terms
+    whose results are expensive to compute, and not when collecting diagnostics since cache hits
+    would hide unfolded declarations. */
+bool type_checker::use_shared_cache(expr const & e) const {
+    if (m_st->m_shared_cache == 0 || m_diag || has_fvar(e) || has_mvar(e))
+        return false;
+    switch (e.kind()) {
+    case expr_kind::App: case expr_kind::Proj: case expr_kind::Let:
+        return true;
+    default:
+        return false;
+    }
+}
 
 /** \brief Make sure \c e "is" a sort, and return the corresponding sort.
     If \c e is not a sort, then the whnf procedure is invoked.
@@ -164,6 +231,9 @@ expr type_checker::infer_app(expr const & e, bool infer_only) {
         }
         return instantiate(binding_body(f_type), app_arg(e));
     } else {
+        /* We use `instantiate_rev_beta` to avoid creating beta-redexes such as `(fun x => P x) a` when
+           an argument is a lambda used in head position in `f_type` (e.g., the motive of a recursor).
+           Otherwise, each of them would be materialized here and then taken apart by `whnf_core`. */
         buffer<expr> args;
         expr const & f = get_app_args(e, args);
         expr f_type    = infer_type_core(f, true);
@@ -173,13 +243,13 @@ expr type_checker::infer_app(expr const & e, bool infer_only) {
             if (is_pi(f_type)) {
                 f_type = binding_body(f_type);
             } else {
-                f_type = instantiate_rev(f_type, i-j, args.data()+j);
+                f_type = instantiate_rev_beta(f_type, i-j, args.data()+j);
                 f_type = ensure_pi_core(f_type, e);
                 f_type = binding_body(f_type);
                 j = i;
             }
         }
-        return instantiate_rev(f_type, nargs-j, args.data()+j);
+        return instantiate_rev_beta(f_type, nargs-j, args.data()+j);
     }
 }
 
@@ -295,9 +365,21 @@ expr type_checker::infer_type_core(expr const & e, bool infer_only) {
     check_system("type checker", /* do_check_interrupted */ true);
 
     auto it = m_st->m_infer_type[infer_only].find(e);
+    inc_cache_stat(it != m_st->m_infer_type[infer_only].end(), &kernel_stats::m_infer_hits, &kernel_stats::m_infer_misses);
     if (it != m_st->m_infer_type[infer_only].end())
         return it->second;
 
+    /* Results of `check` are not shared, they depend on the universe parameters and safety of the declaration. */
+    bool shared = infer_only && use_shared_cache(e);
+    if (shared) {
+        optional<expr> r = shared_cache_find(m_st->m_shared_cache, shared_cache_kind::InferType, e);
+        inc_cache_stat(static_cast<bool>(r), &kernel_stats::m_shared_hits, &kernel_stats::m_shared_misses);
+        if (r) {
+            m_st->m_infer_type[infer_only].insert(mk_pair(e, *r));
+            return *r;
+        }
+    }
+
     expr r;
     switch (e.kind()) {
     case expr_kind::Lit:      r = lit_type(lit_value(e)); break;
@@ -319,6 +401,8 @@ expr type_checker::infer_type_core(expr const & e, bool infer_only) {
     }
 
     m_st->m_infer_type[infer_only].insert(mk_pair(e, r));
+    if (shared)
+        shared_cache_insert(m_st->m_shared_cache, shared_cache_kind::InferType, env(), e, r);
     return r;
 }
 
@@ -421,6 +505,7 @@ static bool is_let_fvar(local_ctx const & lctx, expr const & e) {
     We also do not cache results. */
 expr type_checker::whnf_core(expr const & e, bool cheap_rec, bool cheap_proj) {
     check_system("type checker: whnf", /* do_check_interrupted */ true);
+    inc_stat(&kernel_stats::m_whnf_core);
 
     // handle easy cases
     switch (e.kind()) {
@@ -442,6 +527,7 @@ expr type_checker::whnf_core(expr const & e, bool cheap_rec, bool cheap_proj) {
 
     // check cache
     auto it = m_st->m_whnf_core.find(e);
+    inc_cache_stat(it != m_st->m_whnf_core.end(), &kernel_stats::m_whnf_core_hits, &kernel_stats::m_whnf_core_misses);
     if (it != m_st->m_whnf_core.end())
         return it->second;
 
@@ -522,6 +608,7 @@ optional<expr> type_checker::unfold_definition_core(expr const & e) {
                 if (m_diag) {
                     m_diag->record_unfold(d->get_name());
                 }
+                inc_stat(&kernel_stats::m_delta_unfolds);
                 return some_expr(instantiate_value_lparams(*d, const_levels(e)));
             }
         }
@@ -592,7 +679,9 @@ template<typename F> optional<expr> type_checker::reduce_bin_nat_op(F const & f,
     if (!is_nat_lit_ext(arg2)) return none_expr();
     nat v1 = get_nat_val(arg1);
     nat v2 = get_nat_val(arg2);
-    return some_expr(mk_lit(literal(nat(f(v1.raw(), v2.raw())))));
+    nat r(f(v1.raw(), v2.raw()));
+    record_nat_op(v1, v2, r);
+    return some_expr(mk_lit(literal(r)));
 }
 
 #define ReducePowMaxExp 1<<24 // TODO: make it configurable
@@ -605,7 +694,9 @@ optional<expr> type_checker::reduce_pow(expr const & e) {
     nat v1 = get_nat_val(arg1);
     nat v2 = get_nat_val(arg2);
     if (v2 > nat(ReducePowMaxExp)) return none_expr();
-    return some_expr(mk_lit(literal(nat(nat_pow(v1.raw(), v2.raw())))));
+    nat r(nat_pow(v1.raw(), v2.raw()));
+    record_nat_op(v1, v2, r);
+    return some_expr(mk_lit(literal(r)));
 }
 
 template<typename F> optional<expr> type_checker::reduce_bin_nat_pred(F const & f, expr const & e) {
@@ -615,6 +706,7 @@ template<typename F> optional<expr> type_checker::reduce_bin_nat_pred(F const &
     if (!is_nat_lit_ext(arg2)) return none_expr();
     nat v1 = get_nat_val(arg1);
     nat v2 = get_nat_val(arg2);
+    record_nat_pred(v1, v2);
     return f(v1.raw(), v2.raw()) ? some_expr(mk_bool_true()) : some_expr(mk_bool_false());
 }
 
@@ -626,7 +718,9 @@ optional<expr> type_checker::reduce_nat(expr const & e) {
             expr arg = whnf(app_arg(e));
             if (!is_nat_lit_ext(arg)) return none_expr();
             nat v = get_nat_val(arg);
-            return some_expr(mk_lit(literal(nat(v+nat(1)))));
+            nat r = v+nat(1);
+            record_nat_unop(v, r);
+            return some_expr(mk_lit(literal(r)));
         }
     } else if (nargs == 2) {
         expr const & f = app_fn(app_fn(e));
@@ -651,6 +745,7 @@ optional<expr> type_checker::reduce_nat(expr const & e) {
 
 /** \brief Put expression \c t in weak head normal form */
 expr type_checker::whnf(expr const & e) {
+    inc_stat(&kernel_stats::m_whnf);
     // Do not cache easy cases
     switch (e.kind()) {
     case expr_kind::BVar:  case expr_kind::Sort: case expr_kind::MVar: case expr_kind::Pi:
@@ -670,26 +765,41 @@ expr type_checker::whnf(expr const & e) {
 
     // check cache
     auto it = m_st->m_whnf.find(e);
+    inc_cache_stat(it != m_st->m_whnf.end(), &kernel_stats::m_whnf_hits, &kernel_stats::m_whnf_misses);
     if (it != m_st->m_whnf.end())
         return it->second;
 
+    bool shared = use_shared_cache(e);
+    if (shared) {
+        optional<expr> r = shared_cache_find(m_st->m_shared_cache, shared_cache_kind::Whnf, e);
+        inc_cache_stat(static_cast<bool>(r), &kernel_stats::m_shared_hits, &kernel_stats::m_shared_misses);
+        if (r) {
+            m_st->m_whnf.insert(mk_pair(e, *r));
+            return *r;
+        }
+    }
+
     expr t = e;
+    expr r;
     while (true) {
         expr t1 = whnf_core(t);
         if (auto v = reduce_native(env(), t1)) {
-            m_st->m_whnf.insert(mk_pair(e, *v));
-            return *v;
+            r = *v;
+            break;
         } else if (auto v = reduce_nat(t1)) {
-            m_st->m_whnf.insert(mk_pair(e, *v));
-            return *v;
+            r = *v;
+            break;
         } else if (auto next_t = unfold_definition(t1)) {
             t = *next_t;
         } else {
-            auto r = t1;
-            m_st->m_whnf.insert(mk_pair(e, r));
-            return r;
+            r = t1;
+            break;
         }
     }
+    m_st->m_whnf.insert(mk_pair(e, r));
+    if (shared)
+        shared_cache_insert(m_st->m_shared_cache, shared_cache_kind::Whnf, env(), e, r);
+    return r;
 }
 
 /** \brief Given lambda/Pi expressions \c t and \c s, return true iff \c t is def eq to \c s.
@@ -855,15 +965,18 @@ lbool type_checker::is_def_eq_proof_irrel(expr const & t, expr const & s) {
 }
 
 bool type_checker::failed_before(expr const & t, expr const & s) const {
+    bool r;
     if (hash(t) < hash(s)) {
-        return m_st->m_failure.find(mk_pair(t, s)) != m_st->m_failure.end();
+        r = m_st->m_failure.find(mk_pair(t, s)) != m_st->m_failure.end();
     } else if (hash(t) > hash(s)) {
-        return m_st->m_failure.find(mk_pair(s, t)) != m_st->m_failure.end();
+        r = m_st->m_failure.find(mk_pair(s, t)) != m_st->m_failure.end();
     } else {
-        return
+        r =
             m_st->m_failure.find(mk_pair(t, s)) != m_st->m_failure.end() ||
             m_st->m_failure.find(mk_pair(s, t)) != m_st->m_failure.end();
     }
+    inc_cache_stat(r, &kernel_stats::m_failure_hits, &kernel_stats::m_failure_misses);
+    return r;
 }
 
 void type_checker::cache_failure(expr const & t, expr const & s) {
@@ -894,6 +1007,7 @@ optional<expr> type_checker::try_unfold_proj_app(expr const & e) {
 
      \remark t_n, s_n and cs are updated. */
 auto type_checker::lazy_delta_reduction_step(expr & t_n, expr & s_n) -> reduction_status {
+    inc_stat(&kernel_stats::m_lazy_delta_steps);
     auto d_t = is_delta(t_n);
     auto d_s = is_delta(s_n);
     if (!d_t && !d_s) {
@@ -1067,6 +1181,7 @@ bool type_checker::is_def_eq_unit_like(expr const & t, expr const & s) {
 
 bool type_checker::is_def_eq_core(expr const & t, expr const & s) {
     check_system("is_definitionally_equal", /* do_check_interrupted */ true);
+    inc_stat(&kernel_stats::m_is_def_eq_core);
     bool use_hash = true;
     lbool r = quick_is_def_eq(t, s, use_hash);
     if (r != l_undef) return r == l_true;
@@ -1189,8 +1304,36 @@ type_checker::type_checker(type_checker && src):
 }
 
 type_checker::~type_checker() {
-    if (m_st_owner)
+    if (m_st_owner) {
+        if (kernel_stats * s = g_kernel_stats) {
+            s->m_max_infer_cache     = std::max(s->m_max_infer_cache, m_st->m_infer_type[0].size() + m_st->m_infer_type[1].size());
+            s->m_max_whnf_core_cache = std::max(s->m_max_whnf_core_cache, m_st->m_whnf_core.size());
+            s->m_max_whnf_cache      = std::max(s->m_max_whnf_cache, m_st->m_whnf.size());
+            s->m_max_failure_cache   = std::max(s->m_max_failure_cache, m_st->m_failure.size());
+            s->m_max_eqv_nodes       = std::max(s->m_max_eqv_nodes, m_st->m_eqv_manager.num_nodes());
+        }
         delete m_st;
+    }
+}
+
+/* resetStats : BaseIO Unit */
+extern "C" LEAN_EXPORT obj_res lean_kernel_stats_reset(obj_arg) {
+    if (g_kernel_stats)
+        *g_kernel_stats = kernel_stats();
+    else
+        g_kernel_stats = new kernel_stats();
+    return lean_io_result_mk_ok(box(0));
+}
+
+/* takeStats : BaseIO String */
+extern "C" LEAN_EXPORT obj_res lean_kernel_stats_take(obj_arg) {
+    if (!g_kernel_stats)
+        return lean_io_result_mk_ok(mk_string("{}"));
+    std::ostringstream out;
+    g_kernel_stats->display_json(out);
+    delete g_kernel_stats;
+    g_kernel_stats = nullptr;
+    return lean_io_result_mk_ok(mk_string(out.str()));
 }
 
 inline static expr * new_persistent_expr_const(name const & n) {
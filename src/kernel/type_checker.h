@@ -5,11 +5,11 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #pragma once
-#include <unordered_set>
 #include <memory>
 #include <utility>
 #include <algorithm>
 #include "runtime/flet.h"
+#include "runtime/thread.h"
 #include "util/lbool.h"
 #include "util/name_set.h"
 #include "util/name_generator.h"
@@ -17,6 +17,7 @@ Author: Leonardo de Moura
 #include "kernel/local_ctx.h"
 #include "kernel/expr_maps.h"
 #include "kernel/equiv_manager.h"
+#include "kernel/shared_cache.h"
 
 namespace lean {
 /** \brief Lean Type Checker. It can also be used to infer types, check whether a
@@ -25,7 +26,7 @@ class type_checker {
 public:
     class state {
         typedef expr_map<expr> infer_cache;
-        typedef std::unordered_set<expr_pair, expr_pair_hash, expr_pair_eq> expr_pair_set;
+        typedef flat_hash_set<expr_pair, expr_pair_hash, expr_pair_eq> expr_pair_set;
         environment               m_env;
         name_generator            m_ngen;
         infer_cache               m_infer_type[2];
@@ -33,6 +34,8 @@ public:
         expr_map<expr>            m_whnf;
         equiv_manager             m_eqv_manager;
         expr_pair_set             m_failure;
+        /* Token for `shared_cache_find`/`shared_cache_insert`, `0` if the shared cache is disabled. */
+        uint64                    m_shared_cache;
         friend type_checker;
     public:
         state(environment const & env);
@@ -62,6 +65,7 @@ private:
     expr infer_let(expr const & e, bool infer_only);
     expr infer_type_core(expr const & e, bool infer_only);
     expr infer_type(expr const & e);
+    bool use_shared_cache(expr const & e) const;
 
     enum class reduction_status { Continue, DefUnknown, DefEqual, DefDiff };
     optional<expr> reduce_recursor(expr const & e, bool cheap_rec, bool cheap_proj);
@@ -163,6 +167,37 @@ public:
     optional<expr> unfold_definition(expr const & e);
 };
 
+/** \brief Kernel performance counters (option `kernel.stats`). They are aggregated over all type checkers
+    running on a thread while `g_kernel_stats` is set, see `lean_kernel_stats_reset`. */
+struct kernel_stats {
+    uint64 m_whnf_core           = 0;
+    uint64 m_whnf                = 0;
+    uint64 m_is_def_eq_core      = 0;
+    uint64 m_lazy_delta_steps    = 0;
+    uint64 m_delta_unfolds       = 0;
+    uint64 m_infer_hits          = 0;
+    uint64 m_infer_misses        = 0;
+    uint64 m_whnf_core_hits      = 0;
+    uint64 m_whnf_core_misses    = 0;
+    uint64 m_whnf_hits           = 0;
+    uint64 m_whnf_misses         = 0;
+    uint64 m_failure_hits        = 0;
+    uint64 m_failure_misses      = 0;
+    uint64 m_shared_hits         = 0;
+    uint64 m_shared_misses       = 0;
+    uint64 m_eqv_merges          = 0;
+    uint64 m_nat_ops             = 0;
+    /* `Nat` literal operations where an argument or the result is not a small scalar, i.e., GMP operations */
+    uint64 m_nat_big_ops         = 0;
+    size_t m_max_infer_cache     = 0;
+    size_t m_max_whnf_core_cache = 0;
+    size_t m_max_whnf_cache      = 0;
+    size_t m_max_failure_cache   = 0;
+    size_t m_max_eqv_nodes       = 0;
+    void display_json(std::ostream & out) const;
+};
+LEAN_THREAD_EXTERN_PTR(kernel_stats, g_kernel_stats);
+
 void initialize_type_checker();
 void finalize_type_checker();
 }
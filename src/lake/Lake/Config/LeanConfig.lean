@@ -206,6 +206,20 @@ configuration LeanConfig where
   -/
   backend : Backend := .default
   /--
+  Whether to compile native code for cross-module ThinLTO (via `-flto=thin`).
+
+  The object files of modules (from either backend) then contain LLVM bitcode
+  with a summary of their functions. When linking a shared library or
+  executable, the linker imports small functions across module boundaries for
+  inlining and generates the machine code of the modules in parallel, caching
+  the results in the package's build directory.
+
+  This requires a compiler and linker with ThinLTO support, such as the `clang`
+  and `lld` shipped with Lean. Static libraries built with this option can only
+  be linked by such a linker. Defaults to `false`.
+  -/
+  thinLto : Bool := false
+  /--
   Asserts whether Lake should assume Lean modules are platform-independent.
 
   * If `false`, Lake will add `System.Platform.target` to the module traces
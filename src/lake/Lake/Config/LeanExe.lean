@@ -75,18 +75,26 @@ The file name of binary executable
 @[inline] def supportInterpreter (self : LeanExe) : Bool :=
   self.config.supportInterpreter
 
+/--
+Whether to link the executable with ThinLTO.
+Is true if either the package or the executable have `thinLto` set.
+-/
+@[inline] def thinLto (self : LeanExe) : Bool :=
+  self.pkg.thinLto || self.config.thinLto
+
 /--
 The arguments to pass to `leanc` when linking the binary executable.
 
 By default, the package's plus the executable's `moreLinkArgs`.
 If `supportInterpreter := true`, Lake prepends `-rdynamic` on non-Windows
-systems.
+systems. If `thinLto` is set, Lake prepends `-flto=thin`.
 -/
 def linkArgs (self : LeanExe) : Array String :=
+  let args := if self.thinLto then #["-flto=thin"] else #[]
   if self.config.supportInterpreter && !Platform.isWindows then
-    #["-rdynamic"] ++ self.pkg.moreLinkArgs ++ self.config.moreLinkArgs
+    args ++ #["-rdynamic"] ++ self.pkg.moreLinkArgs ++ self.config.moreLinkArgs
   else
-    self.pkg.moreLinkArgs ++ self.config.moreLinkArgs
+    args ++ self.pkg.moreLinkArgs ++ self.config.moreLinkArgs
 
 /--
 Whether the Lean shared library should be dynamically linked to the executable.
@@ -101,9 +109,11 @@ the Lean shared library. Otherwise, Lean is linked statically.
 
 /--
 The arguments to weakly pass to `leanc` when linking the binary executable.
-That is, the package's `weakLinkArgs` plus the executable's  `weakLinkArgs`.
+That is, the package's `weakLinkArgs` plus the executable's  `weakLinkArgs`,
+preceded by the ThinLTO cache directory if `thinLto` is set.
 -/
 @[inline] def weakLinkArgs (self : LeanExe) : Array String :=
+  (if self.thinLto then self.pkg.thinLtoWeakLinkArgs else #[]) ++
   self.pkg.weakLinkArgs ++ self.config.weakLinkArgs
 
 end LeanExe
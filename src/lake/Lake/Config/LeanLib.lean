@@ -136,6 +136,13 @@ then the default (which is C for now).
 @[inline] def backend (self : LeanLib) : Backend :=
   Backend.orPreferLeft self.config.backend self.pkg.backend
 
+/--
+Whether to compile the library's modules for ThinLTO.
+Is true if either the package or the library have `thinLto` set.
+-/
+@[inline] def thinLto (self : LeanLib) : Bool :=
+  self.pkg.thinLto || self.config.thinLto
+
 /--
 The dynamic libraries to load for modules of this library.
 The targets of the package plus the targets of the library (in that order).
@@ -183,7 +190,8 @@ That is, the build type's `leancArgs`, the package's `moreLeancArgs`,
 and then the library's `moreLeancArgs`.
 -/
 @[inline] def leancArgs (self : LeanLib) : Array String :=
-  self.buildType.leancArgs ++ self.pkg.moreLeancArgs ++ self.config.moreLeancArgs
+  self.buildType.leancArgs ++ (if self.thinLto then #["-flto=thin"] else #[]) ++
+  self.pkg.moreLeancArgs ++ self.config.moreLeancArgs
 
 /--
 The arguments to weakly pass to `leanc` when compiling the library's Lean-produced C files.
@@ -208,14 +216,17 @@ That is, the package's `moreLinkLibs` plus the library's `moreLinkLibs`.
 
 /--
 The arguments to pass to `leanc` when linking the shared library.
-That is, the package's `moreLinkArgs` plus the library's `moreLinkArgs`.
+That is, the package's `moreLinkArgs` plus the library's `moreLinkArgs`,
+preceded by `-flto=thin` if `thinLto` is set.
 -/
 @[inline] def linkArgs (self : LeanLib) : Array String :=
-  self.pkg.moreLinkArgs ++ self.config.moreLinkArgs
+  (if self.thinLto then #["-flto=thin"] else #[]) ++ self.pkg.moreLinkArgs ++ self.config.moreLinkArgs
 
 /--
 The arguments to weakly pass to `leanc` when linking the shared library.
-That is, the package's `weakLinkArgs` plus the library's `weakLinkArgs`.
+That is, the package's `weakLinkArgs` plus the library's `weakLinkArgs`,
+preceded by the ThinLTO cache directory if `thinLto` is set.
 -/
 @[inline] def weakLinkArgs (self : LeanLib) : Array String :=
+  (if self.thinLto then self.pkg.thinLtoWeakLinkArgs else #[]) ++
   self.pkg.weakLinkArgs ++ self.config.weakLinkArgs
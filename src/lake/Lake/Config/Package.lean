@@ -554,6 +554,21 @@ namespace Package
 @[inline] def backend (self : Package) : Backend :=
   self.config.backend
 
+/-- The package's `thinLto` configuration. -/
+@[inline] def thinLto (self : Package) : Bool :=
+  self.config.thinLto
+
+/-- The directory in which the linker caches the results of ThinLTO. -/
+@[inline] def thinLtoCacheDir (self : Package) : FilePath :=
+  self.buildDir / "thinlto"
+
+/-- The arguments to weakly pass to `leanc` when linking ThinLTO objects of the package. -/
+def thinLtoWeakLinkArgs (self : Package) : Array String :=
+  if Platform.isOSX then
+    #[s!"-Wl,-cache_path_lto,{self.thinLtoCacheDir}"]
+  else
+    #[s!"-Wl,--thinlto-cache-dir={self.thinLtoCacheDir}"]
+
 /-- The package's `dynlibs` configuration. -/
 @[inline] def dynlibs (self : Package) : TargetArray Dynlib :=
   self.config.dynlibs
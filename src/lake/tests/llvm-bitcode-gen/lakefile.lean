@@ -6,6 +6,7 @@ open Lake DSL
 package «llvm-bitcode-gen» where
   -- add package configuration options here
   backend := .llvm
+  thinLto := get_config? thinLto |>.isSome
 
 lean_lib «LlvmBitcodeGen» where
   -- add library configuration options here
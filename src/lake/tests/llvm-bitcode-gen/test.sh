@@ -27,5 +27,11 @@ test_out -q exe llvm-bitcode-gen | grep --color true
 test -f .lake/build/ir/LlvmBitcodeGen.bc
 test -f .lake/build/ir/Main.bc
 
+# Check that ThinLTO summaries are emitted and used when linking
+./clean.sh
+test_run update
+test_out "-flto=thin" build -v -KthinLto=true
+test_out -q exe llvm-bitcode-gen | grep --color true
+
 # cleanup
 rm -f produced.out
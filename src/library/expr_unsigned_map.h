@@ -5,7 +5,7 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #pragma once
-#include <unordered_map>
+#include "util/flat_hash_map.h"
 #include "kernel/expr.h"
 
 namespace lean {
@@ -30,5 +30,5 @@ struct expr_unsigned_eq_fn {
 
 /* mapping from (expr, unsigned) -> T */
 template<typename T>
-using expr_unsigned_map = typename std::unordered_map<expr_unsigned, T, expr_unsigned_hash_fn, expr_unsigned_eq_fn>;
+using expr_unsigned_map = flat_hash_map<expr_unsigned, T, expr_unsigned_hash_fn, expr_unsigned_eq_fn>;
 }
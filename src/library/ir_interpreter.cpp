@@ -9,9 +9,11 @@ A simple interpreter for evaluating λRC IR code.
 Motivation
 ==========
 
-Even with a JIT compiler, we still have a need for a simpler interpreter on platforms LLVM JIT does not support (i.e.
-WebAssembly). Because this is mostly an edge case, we strive for simplicity instead of performance and thus reuse the
-existing compiler IR instead of inventing something like a new bytecode format.
+Even with a JIT compiler, we still have a need for an interpreter on platforms LLVM JIT does not support (i.e.
+WebAssembly), and for code that is run only a few times, such as most `#eval`s and tactics of the current file. Code
+is not interpreted from the compiler IR directly but from a register bytecode that is derived from the IR when a
+declaration is first called (see below). The bytecode stays close to the IR, so the interpreter can fall back to
+walking the IR for the few declarations that the bytecode does not cover.
 
 Implementation
 ==============
@@ -21,14 +23,61 @@ objects. The IR type system tells us which union member is active at any time. I
 slots by adding the current base pointer to the variable index. Further stacks are used for storing join points and call
 stack metadata. The interpreted IR is taken directly from the elab_environment. Whenever possible, we try to switch to native
 code by checking for the mangled symbol via dlsym/GetProcAddress, which is also how we can call external functions
-(which only works if the file declaring them has already been compiled). We always call the "boxed" versions of native
-functions, which have a (relatively) homogeneous ABI that we can use without runtime code generation; see also
-`call/lookup_symbol` below.
+(which only works if the file declaring them has already been compiled). By default, we call the "boxed" versions of
+native functions, which have a (relatively) homogeneous ABI that we can use without runtime code generation; see also
+`call/lookup_symbol` below. Boxing scalar arguments and results can dominate numeric code, so on 64-bit targets, functions
+with at most `g_max_trampoline_arity` parameters are instead called through a typed trampoline from the table generated
+by `script/gen_interpreter_trampolines.py`, using either their unboxed version or, for `[extern]` declarations, the C
+function itself if it is exported. Since all integers and pointers are passed the same way there, only `double` and
+`float` need to be distinguished, which keeps the table small.
+
+Register bytecode
+=================
+
+Walking the IR objects directly means decoding constructor fields and `nat` indices on every step and discovering
+the size of a stack frame only while executing it. Therefore, before a declaration is interpreted for the first time,
+its body is lowered to a linear sequence of instructions on a pre-sized frame of registers (`lower_fn`): variable and
+join point references become register indices and instruction offsets, `case` becomes a jump table, constructor
+layouts and literals are decoded ahead of time, and each call site resolves its callee only once. The lowered code is
+cached per declaration for the lifetime of the interpreter. Declarations that cannot be lowered as well as all code
+when the option `interpreter.bytecode` is disabled are still interpreted by walking the IR (`eval_body`).
+Calls whose result is returned directly reuse the current frame: a self tail call jumps back to the first
+instruction, and a tail call of another interpreted function replaces the registers and code of the frame, so that
+loops made of mutually recursive functions run in constant native stack space as they do in compiled code.
+
+Sampling profiler
+=================
+
+`Lean.Firefox.startInterpreterProfiler` starts a thread that advances `g_profiler_tick` at a fixed interval. Whenever
+an interpreter notices a new tick in `check_system`, i.e. on function entry and on loop back edges, or after a native
+call returns, it records its call stack including the frames of natively called functions. Each sample is weighted by
+the number of ticks since the previous sample of the thread, so that a native callee spanning many ticks is accounted
+for in full. Sampling at these points instead of from a signal handler means that no other thread ever reads the call
+stack and that recording may allocate, at the cost of attributing time spent in a native callee to the interpreted code
+that resumes after it if the callee returns to the interpreter only through other native code.
+
+JIT tier
+========
+
+In builds with LLVM support, the option `interpreter.jit_threshold` makes the interpreter hand a function to the LLVM
+ORC JIT once it has been called that many times (`EmitLLVM.jitCompile`). The function is compiled together with the
+local declarations it references; everything else is resolved against the symbols of the running process. From then
+on, calls go through the same paths as for precompiled code. Compiled code is cached for the whole process and never
+freed. Functions that cannot be compiled, such as constants and `[init]` declarations, stay interpreted.
 
 */
 #include <string>
 #include <vector>
+#include <limits>
+#include <mutex>
 #include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
 #ifdef LEAN_WINDOWS
 #include <windows.h>
 #include <psapi.h>
@@ -48,12 +97,36 @@ functions, which have a (relatively) homogeneous ABI that we can use without run
 #include "library/ir_types.h"
 #include "library/init_attribute.h"
 #include "util/nat.h"
+#include "util/flat_hash_map.h"
+#include "util/io.h"
 #include "util/option_declarations.h"
 
 #ifndef LEAN_DEFAULT_INTERPRETER_PREFER_NATIVE
 #define LEAN_DEFAULT_INTERPRETER_PREFER_NATIVE true
 #endif
 
+#ifndef LEAN_DEFAULT_INTERPRETER_BYTECODE
+#define LEAN_DEFAULT_INTERPRETER_BYTECODE true
+#endif
+
+#ifndef LEAN_DEFAULT_INTERPRETER_UNBOXED_CALLS
+#define LEAN_DEFAULT_INTERPRETER_UNBOXED_CALLS true
+#endif
+
+#ifndef LEAN_DEFAULT_INTERPRETER_JIT_THRESHOLD
+#define LEAN_DEFAULT_INTERPRETER_JIT_THRESHOLD 0
+#endif
+
+#ifndef LEAN_DEFAULT_INTERPRETER_SHARED_CONSTANT_CACHE
+#define LEAN_DEFAULT_INTERPRETER_SHARED_CONSTANT_CACHE 512
+#endif
+
+// Trampolines pass integers and pointers as `uint64`, which is only compatible with the native calling convention on
+// 64-bit targets that do not check signatures of indirect calls (unlike WebAssembly)
+#if !defined(LEAN_EMSCRIPTEN) && (defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64))
+#define LEAN_INTERPRETER_TRAMPOLINES
+#endif
+
 namespace lean {
 namespace ir {
 // C++ wrappers of Lean data types
@@ -188,6 +261,11 @@ option_ref<decl> find_ir_decl(elab_environment const & env, name const & n) {
     return option_ref<decl>(lean_ir_find_env_decl(env.to_obj_arg(), n.to_obj_arg()));
 }
 
+extern "C" object * lean_get_extern_c_name_for(object * env, object * n);
+option_ref<string_ref> get_extern_c_name_for(elab_environment const & env, name const & n) {
+    return option_ref<string_ref>(lean_get_extern_c_name_for(env.to_obj_arg(), n.to_obj_arg()));
+}
+
 extern "C" double lean_float_of_nat(lean_obj_arg a);
 extern "C" float lean_float32_of_nat(lean_obj_arg a);
 
@@ -195,6 +273,10 @@ static string_ref * g_mangle_prefix = nullptr;
 static string_ref * g_boxed_suffix = nullptr;
 static string_ref * g_boxed_mangled_suffix = nullptr;
 static name * g_interpreter_prefer_native = nullptr;
+static name * g_interpreter_bytecode = nullptr;
+static name * g_interpreter_unboxed_calls = nullptr;
+static name * g_interpreter_jit_threshold = nullptr;
+static name * g_interpreter_shared_constant_cache = nullptr;
 
 // constants (lacking native declarations) initialized by `lean_run_init`
 static name_map<object *> * g_init_globals;
@@ -313,6 +395,35 @@ void print_value(tout const & ios, value const & v, type t) {
   return print_value(const_cast<tout &>(ios), v, t);
 }
 
+/** \brief Clear the bits of a native scalar result that are not part of the value of type `t`. */
+value truncate_t(value v, type t) {
+    switch (t) {
+    case type::UInt8:  return static_cast<uint8>(v.m_num);
+    case type::UInt16: return static_cast<uint16>(v.m_num);
+    case type::UInt32: return static_cast<uint32>(v.m_num);
+    default:           return v;
+    }
+}
+}
+}
+
+#include "library/ir_interpreter_trampolines.h"
+
+namespace lean {
+namespace ir {
+/** \brief Return the trampoline class of `t`, or `-1` if values of type `t` cannot be passed through a trampoline. */
+static int trampoline_class(type t) {
+    switch (t) {
+    case type::Float:   return 1;
+    case type::Float32: return 2;
+    case type::Struct:
+    case type::Union:
+        return -1;
+    default:
+        return 0;
+    }
+}
+
 void * lookup_symbol_in_cur_exe(char const * sym) {
 #ifdef LEAN_WINDOWS
     std::vector<HMODULE> hmods(128);
@@ -345,6 +456,10 @@ struct native_symbol_cache_entry {
     void * m_addr;
     // true iff we chose the boxed version of a function where the IR uses the unboxed version
     bool m_boxed;
+    // if `m_boxed`, the address of the unboxed version, if any
+    void * m_unboxed_addr;
+    // true iff `m_unboxed_addr` is the C function of an `[extern]` declaration, which does not take erased arguments
+    bool m_unboxed_extern;
 };
 
 // Caches native symbol lookup successes _and_ failures; we assume no native code is loaded or
@@ -353,6 +468,682 @@ name_map<native_symbol_cache_entry> * g_native_symbol_cache;
 // could be `shared_mutex` with C++17
 std::shared_timed_mutex * g_native_symbol_cache_mutex;
 
+struct symbol_cache_entry {
+    // looking up IR from .oleans is slow enough to warrant its own cache; but as local IR can
+    // be backtracked, this cache needs to be local as well.
+    decl m_decl;
+    native_symbol_cache_entry m_native;
+    // trampoline for calling `m_native.m_unboxed_addr`, see `find_trampoline`
+    trampoline m_trampoline = nullptr;
+};
+
+/** \brief Return the trampoline for calling the unboxed version `ne.m_unboxed_addr` of the native function with IR
+    declaration `d`, or `nullptr` if it must be called via the boxed version. */
+static trampoline find_trampoline(decl const & d, native_symbol_cache_entry const & ne) {
+#ifdef LEAN_INTERPRETER_TRAMPOLINES
+    if (!ne.m_boxed || !ne.m_unboxed_addr) {
+        return nullptr;
+    }
+    unsigned classes[g_max_trampoline_arity];
+    unsigned n = 0;
+    for (param const & p : decl_params(d)) {
+        if (ne.m_unboxed_extern && param_type(p) == type::Irrelevant) {
+            continue;
+        }
+        int c = trampoline_class(param_type(p));
+        if (c < 0 || n == g_max_trampoline_arity) {
+            return nullptr;
+        }
+        classes[n++] = c;
+    }
+    int ret = trampoline_class(decl_type(d));
+    if (ret < 0) {
+        return nullptr;
+    }
+    return get_trampoline(ret, n, classes);
+#else
+    return nullptr;
+#endif
+}
+
+struct constant_cache_entry {
+    bool m_is_scalar;
+    value m_val;
+};
+
+extern "C" uint8 lean_elab_environment_is_imported_const(object * env, object * n);
+extern "C" object * lean_elab_environment_imports_id(object * env);
+
+/* Symbol cache for declarations imported by the environment. Unlike local declarations, which may be added or
+   backtracked, imported declarations do not change when the environment is extended. So this cache is
+   shared by all interpreters whose environments have the same imports (as identified by
+   `lean_elab_environment_imports_id`), on all threads. We only keep entries for one set of imports at a time. */
+struct imported_cache {
+    // imports of the entries below, or `nullptr`
+    object * m_imports = nullptr;
+    flat_hash_map<name, symbol_cache_entry, name_hash_fn, name_eq_fn>   m_symbols;
+
+    void reset(object * imports) {
+        m_symbols.clear();
+        if (m_imports)
+            dec_ref(m_imports);
+        m_imports = imports;
+        if (m_imports) {
+            // keep the imports alive so that their address cannot be reused by other imports
+            mark_mt(m_imports);
+            inc_ref(m_imports);
+        }
+    }
+};
+static imported_cache * g_imported_cache;
+static std::shared_timed_mutex * g_imported_cache_mutex;
+
+/* Approximate memory retained by `o`: the size of all objects reachable from `o` that are not yet shared between
+   threads or persistent, i.e. that a cache entry for `o` keeps alive on its own. */
+static size_t unshared_byte_size(object * o) {
+    size_t sz = 0;
+    std::unordered_set<object *> visited;
+    buffer<object *> todo;
+    todo.push_back(o);
+    while (!todo.empty()) {
+        object * o = todo.back();
+        todo.pop_back();
+        if (is_scalar(o) || !lean_is_st(o) || !visited.insert(o).second)
+            continue;
+        sz += lean_object_byte_size(o);
+        uint8_t tag = lean_ptr_tag(o);
+        if (tag <= LeanMaxCtorTag) {
+            for (unsigned i = 0; i < lean_ctor_num_objs(o); i++)
+                todo.push_back(lean_ctor_get(o, i));
+        } else if (tag == LeanClosure) {
+            for (unsigned i = 0; i < lean_closure_num_fixed(o); i++)
+                todo.push_back(lean_closure_get(o, i));
+        } else if (tag == LeanArray) {
+            for (size_t i = 0; i < lean_array_size(o); i++)
+                todo.push_back(lean_array_get_core(o, i));
+        } else if (tag == LeanThunk) {
+            if (object * v = lean_to_thunk(o)->m_value)
+                todo.push_back(v);
+        }
+    }
+    return sz;
+}
+
+/* Values of constants (nullary functions) evaluated by any interpreter, keyed by their `decl` objects, which are kept
+   alive by the cache. A `decl` object is only shared by environments that agree on all declarations it may refer to, so
+   the value can be reused by all threads and environments that see the same object. This matters for large tables and
+   parsers that would otherwise be recomputed by every elaboration task. The values are marked as multi-threaded; the
+   cache retains at most `interpreter.shared_constant_cache` MiB as estimated by `unshared_byte_size` and evicts the
+   least recently used entries beyond that. */
+struct shared_constant_cache {
+    struct entry {
+        constant_cache_entry m_entry;
+        size_t m_byte_size;
+        uint64 m_last_use;
+    };
+    ptr_hash_map<object, entry> m_entries;
+    size_t m_byte_size = 0;
+    uint64 m_clock     = 0;
+    uint64 m_evictions = 0;
+
+    void erase(object * d, entry const & e) {
+        if (!e.m_entry.m_is_scalar)
+            dec(e.m_entry.m_val.m_obj);
+        m_byte_size -= e.m_byte_size;
+        dec_ref(d);
+    }
+
+    /* Evict least recently used entries until at most `limit` bytes are retained. */
+    void shrink(size_t limit) {
+        if (m_byte_size <= limit)
+            return;
+        std::vector<std::pair<uint64, object *>> order;
+        for (auto const & p : m_entries)
+            order.emplace_back(p.second.m_last_use, p.first);
+        std::sort(order.begin(), order.end());
+        for (auto const & p : order) {
+            if (m_byte_size <= limit)
+                break;
+            auto it = m_entries.find(p.second);
+            erase(it->first, it->second);
+            m_entries.erase(it);
+            m_evictions++;
+        }
+    }
+
+    void clear() {
+        for (auto const & p : m_entries)
+            erase(p.first, p.second);
+        m_entries.clear();
+    }
+};
+static shared_constant_cache * g_constant_cache;
+static std::mutex * g_constant_cache_mutex;
+
+struct cache_stats {
+    // hits in the cache of the current interpreter
+    uint64 m_hits = 0;
+    // hits in the process-wide caches `g_imported_cache` and `g_constant_cache`
+    uint64 m_shared_hits = 0;
+    uint64 m_misses = 0;
+
+    void report(char const * cache) const {
+        std::string prefix = std::string("interpreter ") + cache + " cache ";
+        report_profiling_count(prefix + "hits", m_hits);
+        report_profiling_count(prefix + "hits (shared)", m_shared_hits);
+        report_profiling_count(prefix + "misses", m_misses);
+    }
+};
+
+// JIT-compiled native code of interpreted functions, keyed by their `decl` objects, which are kept alive by the cache so
+// that redefined declarations cannot be confused with earlier versions. An entry without address marks a declaration
+// that could not be compiled.
+static ptr_hash_map<object, native_symbol_cache_entry> * g_jit_cache;
+static std::mutex * g_jit_mutex;
+
+extern "C" object * lean_init_llvm(object * w);
+extern "C" object * lean_ir_jit_compile(object * env, object * fn, object * w);
+
+/** \brief Return the native version of `d` compiled with the ORC JIT (see `Lean.IR.jitCompile`), or an entry without
+    address if `d` cannot be compiled. */
+static native_symbol_cache_entry jit_compile(elab_environment const & env, decl const & d) {
+    {
+        std::lock_guard<std::mutex> lock(*g_jit_mutex);
+        auto it = g_jit_cache->find(d.raw());
+        if (it != g_jit_cache->end()) {
+            return it->second;
+        }
+    }
+    native_symbol_cache_entry ne {nullptr, false, nullptr, false};
+#ifdef LEAN_LLVM
+    static std::once_flag init_llvm;
+    try {
+        std::call_once(init_llvm, []() { consume_io_result(lean_init_llvm(io_mk_world())); });
+        object_ref r = get_io_result<object_ref>(lean_ir_jit_compile(env.to_obj_arg(), decl_fun_id(d).to_obj_arg(), io_mk_world()));
+        void * addr       = reinterpret_cast<void *>(unbox_size_t(cnstr_get(r.raw(), 0)));
+        void * boxed_addr = reinterpret_cast<void *>(unbox_size_t(cnstr_get(r.raw(), 1)));
+        if (boxed_addr) {
+            ne = {boxed_addr, true, addr, false};
+        } else {
+            ne = {addr, false, nullptr, false};
+        }
+    } catch (exception & ex) {
+        lean_trace(name({"interpreter", "jit"}), tout() << ex.what() << "\n";);
+    }
+#endif
+    std::lock_guard<std::mutex> lock(*g_jit_mutex);
+    auto r = g_jit_cache->insert(std::make_pair(d.raw(), ne));
+    if (r.second) {
+        mark_mt(d.raw());
+        inc_ref(d.raw());
+    }
+    return r.first->second;
+}
+
+// Sampling profiler, see the module documentation above.
+
+struct profiler_sample {
+    uint64 m_tid;
+    // `IO.monoNanosNow` at the time of the sample
+    uint64 m_time;
+    // indices into `profiler_state::m_frames`, outermost frame first
+    std::vector<unsigned> m_stack;
+    // number of ticks since the previous sample of the thread
+    uint64 m_ticks;
+};
+
+struct profiler_state {
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread * m_thread = nullptr;
+    bool m_stop = false;
+    // `g_profiler_tick` when the profiler was started
+    uint64 m_start_tick = 0;
+    // function names of all sampled frames
+    std::vector<std::string> m_frames;
+    std::unordered_map<std::string, unsigned> m_frame_idx;
+    std::vector<profiler_sample> m_samples;
+};
+
+static profiler_state * g_profiler;
+// advanced by the profiler thread at each sampling interval
+static std::atomic<uint64> g_profiler_tick(0);
+// last tick that has been sampled by the current thread
+LEAN_THREAD_VALUE(uint64, g_profiler_last_tick, 0);
+
+extern "C" obj_res lean_io_get_tid(obj_arg);
+
+static void record_profiler_sample(std::vector<std::string> const & stack, uint64 tick, uint64 last_tick) {
+    object * tid_r = lean_io_get_tid(io_mk_world());
+    uint64 tid = unbox_uint64(io_result_get_value(tid_r));
+    dec_ref(tid_r);
+    uint64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    std::lock_guard<std::mutex> lock(g_profiler->m_mutex);
+    if (!g_profiler->m_thread || tick <= g_profiler->m_start_tick) {
+        return;
+    }
+    // ticks before the profiler was started are not attributed to this sample
+    profiler_sample sample { tid, time, {}, tick - std::max(last_tick, g_profiler->m_start_tick) };
+    sample.m_stack.reserve(stack.size());
+    for (std::string const & fn : stack) {
+        auto r = g_profiler->m_frame_idx.insert(std::make_pair(fn, g_profiler->m_frames.size()));
+        if (r.second) {
+            g_profiler->m_frames.push_back(fn);
+        }
+        sample.m_stack.push_back(r.first->second);
+    }
+    g_profiler->m_samples.push_back(std::move(sample));
+}
+
+// Register bytecode, see the module documentation above.
+
+enum class opcode : uint8 {
+    // variable declarations `x := e`, storing the result in register `m_dst`
+    Ctor, Reset, Reuse, Proj, UProj, SProj, FAp, Load, PAp, Ap, Box, Unbox, Lit, ObjLit, IsShared, IsTaggedPtr,
+    // other statements
+    Set, SetTag, USet, SSet, Inc, Dec, Del, Case, Ret, Jmp, TailCall, TailFAp, Unreachable
+};
+
+/* Register index used for irrelevant arguments, which evaluate to `box(0)` */
+static constexpr uint32 g_irrelevant_reg = std::numeric_limits<uint32>::max();
+/* Jump table entry of constructor tags without `case` alternative */
+static constexpr uint32 g_no_target = std::numeric_limits<uint32>::max();
+
+/* Meaning of the operands `m_a`, `m_b`, and `m_c` for each opcode (`r` is a register, `arg` a register or
+   `g_irrelevant_reg`, `ops` is the operand list `m_ops` of length `m_num_ops` in `bytecode::m_operands`):
+   * `Ctor`: `m_a` ctor layout, `ops` field args
+   * `Reset`: `m_a` r, `m_b` number of object fields
+   * `Reuse`: `m_a` r, `m_b` ctor layout, `m_flag` update header, `ops` field args
+   * `Proj`/`UProj`: `m_a` r, `m_b` field index
+   * `SProj`: `m_a` r, `m_b` byte offset
+   * `FAp`/`PAp`: `m_a` callee, `ops` args
+   * `Load`: `m_a` callee
+   * `Ap`: `m_a` r of closure, `ops` args
+   * `Box`/`Unbox`/`IsShared`/`IsTaggedPtr`: `m_a` r
+   * `Lit`: `m_a` index into `bytecode::m_lits`; `ObjLit`: `m_a` index into `bytecode::m_obj_lits`
+   * `Set`: `m_a` r, `m_b` field index, `m_c` arg
+   * `SetTag`: `m_a` r, `m_b` tag
+   * `USet`: `m_a` r, `m_b` field index, `m_c` r of value
+   * `SSet`: `m_a` r, `m_b` byte offset, `m_c` r of value
+   * `Inc`/`Dec`: `m_a` r, `m_b` count; `Del`: `m_a` r
+   * `Case`: `m_a` r, `m_b` jump table
+   * `Ret`: `m_a` arg
+   * `Jmp`: `m_a` target instruction, `ops` args followed by the registers of the join point parameters
+   * `TailCall`: `ops` args followed by the registers of the function parameters
+   * `TailFAp`: `m_a` callee, `ops` args; a call of another function whose result is returned */
+struct instr {
+    opcode m_op;
+    type   m_type; // type of the variable declared or stored
+    bool   m_flag;
+    uint32 m_dst;
+    uint32 m_a;
+    uint32 m_b;
+    uint32 m_c;
+    uint32 m_ops;
+    uint32 m_num_ops;
+};
+
+struct ctor_layout {
+    unsigned m_tag;
+    // number of boxed object fields
+    unsigned m_num_objs;
+    // byte size of all unboxed fields
+    unsigned m_scalar_sz;
+};
+
+struct callee {
+    fun_id             m_fn;
+    // resolved by `interpreter::resolve` on first use
+    bool               m_resolved = false;
+    symbol_cache_entry m_sym;
+    explicit callee(fun_id const & fn):m_fn(fn) {}
+};
+
+struct bytecode {
+    decl                              m_decl;
+    // `false` if the declaration could not be lowered
+    bool                              m_ok = false;
+    unsigned                          m_num_regs = 0;
+    std::vector<instr>                m_code;
+    std::vector<uint32>               m_operands;
+    std::vector<ctor_layout>          m_ctors;
+    std::vector<callee>               m_callees;
+    std::vector<value>                m_lits;
+    std::vector<object_ref>           m_obj_lits;
+    // indexed by constructor tag, the last entry is the target for all larger tags
+    std::vector<std::vector<uint32>>  m_jump_tables;
+    explicit bytecode(decl const & d):m_decl(d) {}
+};
+
+/** \brief Lower the body of a `Fun` declaration to register bytecode. Throws an exception on unsupported IR. */
+class lower_fn {
+    bytecode &                m_bc;
+    fun_id                    m_fn;
+    struct jp_scope {
+        jp_id           m_id;
+        unsigned        m_label;
+        fn_body const * m_jdecl;
+    };
+    // join points in scope, innermost last
+    std::vector<jp_scope>     m_jps;
+    // label -> instruction
+    std::vector<uint32>       m_labels;
+    name_map<unsigned>        m_callee_idx;
+
+    uint32 reg(var_id const & x) {
+        uint32 r = x.get_small_value() - 1; // variables are 1-indexed
+        m_bc.m_num_regs = std::max(m_bc.m_num_regs, r + 1);
+        return r;
+    }
+
+    uint32 arg_reg(arg const & a) {
+        return arg_is_irrelevant(a) ? g_irrelevant_reg : reg(arg_var_id(a));
+    }
+
+    uint32 pc() const { return m_bc.m_code.size(); }
+
+    instr & emit(opcode op, uint32 a = 0, uint32 b = 0, uint32 c = 0) {
+        instr i;
+        i.m_op = op; i.m_type = type::Object; i.m_flag = false; i.m_dst = 0;
+        i.m_a = a; i.m_b = b; i.m_c = c; i.m_ops = m_bc.m_operands.size(); i.m_num_ops = 0;
+        m_bc.m_code.push_back(i);
+        return m_bc.m_code.back();
+    }
+
+    void add_operand(instr & i, uint32 r) {
+        m_bc.m_operands.push_back(r);
+        i.m_num_ops++;
+    }
+
+    void add_args(instr & i, array_ref<arg> const & args) {
+        for (arg const & a : args)
+            add_operand(i, arg_reg(a));
+    }
+
+    uint32 mk_ctor(ctor_info const & c) {
+        ctor_layout l;
+        l.m_tag       = ctor_info_tag(c).get_small_value();
+        l.m_num_objs  = ctor_info_size(c).get_small_value();
+        // number of unboxed USize fields (whose byte size the IR is ignorant of) and byte size of all other unboxed fields
+        l.m_scalar_sz = ctor_info_usize(c).get_small_value() * sizeof(void *) + ctor_info_ssize(c).get_small_value();
+        m_bc.m_ctors.push_back(l);
+        return m_bc.m_ctors.size() - 1;
+    }
+
+    uint32 mk_callee(fun_id const & fn) {
+        if (unsigned const * i = m_callee_idx.find(fn))
+            return *i;
+        m_bc.m_callees.emplace_back(fn);
+        m_callee_idx.insert(fn, m_bc.m_callees.size() - 1);
+        return m_bc.m_callees.size() - 1;
+    }
+
+    uint32 mk_lit(value v) {
+        m_bc.m_lits.push_back(v);
+        return m_bc.m_lits.size() - 1;
+    }
+
+    void lower_lit(instr & i, lit_val const & l, type t) {
+        if (lit_val_tag(l) == lit_val_kind::Str) {
+            i.m_op = opcode::ObjLit;
+            m_bc.m_obj_lits.push_back(lit_val_str(l));
+            i.m_a = m_bc.m_obj_lits.size() - 1;
+            return;
+        }
+        nat const & n = lit_val_num(l);
+        switch (t) {
+        case type::Float:
+            lean_inc(n.raw());
+            i.m_a = mk_lit(value::from_float(lean_float_of_nat(n.raw())));
+            return;
+        case type::Float32:
+            lean_inc(n.raw());
+            i.m_a = mk_lit(value::from_float32(lean_float32_of_nat(n.raw())));
+            return;
+        case type::UInt8: case type::UInt16: case type::UInt32: case type::USize:
+            i.m_a = mk_lit(lean_usize_of_nat(n.raw()));
+            return;
+        case type::UInt64:
+            i.m_a = mk_lit(lean_uint64_of_nat(n.raw()));
+            return;
+        case type::Object: case type::Tagged: case type::TObject:
+            // `nat` literal
+            i.m_op = opcode::ObjLit;
+            m_bc.m_obj_lits.push_back(n);
+            i.m_a = m_bc.m_obj_lits.size() - 1;
+            return;
+        case type::Irrelevant: case type::Union: case type::Struct:
+            break;
+        }
+        throw exception("invalid instruction");
+    }
+
+    void lower_vdecl(fn_body const & b) {
+        expr const & e = fn_body_vdecl_expr(b);
+        type t         = fn_body_vdecl_type(b);
+        uint32 dst     = reg(fn_body_vdecl_var(b));
+        instr * i;
+        switch (expr_tag(e)) {
+        case expr_kind::Ctor:
+            i = &emit(opcode::Ctor, mk_ctor(expr_ctor_info(e)));
+            add_args(*i, expr_ctor_args(e));
+            break;
+        case expr_kind::Reset:
+            i = &emit(opcode::Reset, reg(expr_reset_obj(e)), expr_reset_num_objs(e).get_small_value());
+            break;
+        case expr_kind::Reuse: {
+            uint32 c = mk_ctor(expr_reuse_ctor(e));
+            i = &emit(opcode::Reuse, reg(expr_reuse_obj(e)), c);
+            i->m_flag = expr_reuse_update_header(e);
+            add_args(*i, expr_reuse_args(e));
+            break;
+        }
+        case expr_kind::Proj:
+            i = &emit(opcode::Proj, reg(expr_proj_obj(e)), expr_proj_idx(e).get_small_value());
+            break;
+        case expr_kind::UProj:
+            i = &emit(opcode::UProj, reg(expr_uproj_obj(e)), expr_uproj_idx(e).get_small_value());
+            break;
+        case expr_kind::SProj:
+            i = &emit(opcode::SProj, reg(expr_sproj_obj(e)),
+                      expr_sproj_idx(e).get_small_value() * sizeof(void *) + expr_sproj_offset(e).get_small_value());
+            break;
+        case expr_kind::FAp:
+            if (expr_fap_args(e).size()) {
+                i = &emit(opcode::FAp, mk_callee(expr_fap_fun(e)));
+                add_args(*i, expr_fap_args(e));
+            } else {
+                // nullary function ("constant")
+                i = &emit(opcode::Load, mk_callee(expr_fap_fun(e)));
+            }
+            break;
+        case expr_kind::PAp:
+            i = &emit(opcode::PAp, mk_callee(expr_pap_fun(e)));
+            add_args(*i, expr_pap_args(e));
+            break;
+        case expr_kind::Ap:
+            i = &emit(opcode::Ap, reg(expr_ap_fun(e)));
+            add_args(*i, expr_ap_args(e));
+            break;
+        case expr_kind::Box:
+            i = &emit(opcode::Box, reg(expr_box_obj(e)));
+            // the type of the boxed value rather than of the result
+            t = expr_box_type(e);
+            break;
+        case expr_kind::Unbox:
+            i = &emit(opcode::Unbox, reg(expr_unbox_obj(e)));
+            break;
+        case expr_kind::Lit:
+            i = &emit(opcode::Lit);
+            lower_lit(*i, expr_lit_val(e), t);
+            break;
+        case expr_kind::IsShared:
+            i = &emit(opcode::IsShared, reg(expr_is_shared_obj(e)));
+            break;
+        case expr_kind::IsTaggedPtr:
+            i = &emit(opcode::IsTaggedPtr, reg(expr_is_tagged_ptr_obj(e)));
+            break;
+        default:
+            throw exception(sstream() << "unexpected instruction kind " << static_cast<unsigned>(expr_tag(e)));
+        }
+        i->m_dst  = dst;
+        i->m_type = t;
+    }
+
+    jp_scope const & find_jp(jp_id const & id) const {
+        for (auto it = m_jps.rbegin(); it != m_jps.rend(); it++) {
+            if (it->m_id == id)
+                return *it;
+        }
+        throw exception("unknown join point");
+    }
+
+    void lower_case(fn_body const & b) {
+        uint32 table = m_bc.m_jump_tables.size();
+        m_bc.m_jump_tables.emplace_back();
+        instr & i = emit(opcode::Case, reg(fn_body_case_var(b)), table);
+        i.m_type = fn_body_case_var_type(b);
+        std::vector<uint32> targets;
+        uint32 default_target = g_no_target;
+        for (alt_core const & a : fn_body_case_alts(b)) {
+            if (alt_core_tag(a) == alt_core_kind::Default) {
+                // later alternatives are unreachable
+                default_target = pc();
+                lower(alt_core_default_cont(a));
+                break;
+            }
+            unsigned tag = ctor_info_tag(alt_core_ctor_info(a)).get_small_value();
+            if (tag >= targets.size())
+                targets.resize(tag + 1, g_no_target);
+            if (targets[tag] == g_no_target) {
+                targets[tag] = pc();
+                lower(alt_core_ctor_cont(a));
+            }
+        }
+        for (uint32 & t : targets) {
+            if (t == g_no_target)
+                t = default_target;
+        }
+        targets.push_back(default_target);
+        m_bc.m_jump_tables[table] = std::move(targets);
+    }
+
+    void lower(fn_body const & b0) {
+        std::reference_wrapper<fn_body const> b(b0);
+        while (true) {
+            switch (fn_body_tag(b)) {
+            case fn_body_kind::VDecl: {
+                expr const & e = fn_body_vdecl_expr(b);
+                fn_body const & cont = fn_body_vdecl_cont(b);
+                // tail recursion?
+                if (expr_tag(e) == expr_kind::FAp && expr_fap_fun(e) == m_fn &&
+                    fn_body_tag(cont) == fn_body_kind::Ret && !arg_is_irrelevant(fn_body_ret_arg(cont)) &&
+                    arg_var_id(fn_body_ret_arg(cont)) == fn_body_vdecl_var(b)) {
+                    instr & i = emit(opcode::TailCall);
+                    add_args(i, expr_fap_args(e));
+                    for (param const & p : decl_params(m_bc.m_decl))
+                        add_operand(i, reg(param_var(p)));
+                    return;
+                }
+                // tail call of another function?
+                if (expr_tag(e) == expr_kind::FAp && expr_fap_args(e).size() &&
+                    fn_body_tag(cont) == fn_body_kind::Ret && !arg_is_irrelevant(fn_body_ret_arg(cont)) &&
+                    arg_var_id(fn_body_ret_arg(cont)) == fn_body_vdecl_var(b)) {
+                    instr & i = emit(opcode::TailFAp, mk_callee(expr_fap_fun(e)));
+                    add_args(i, expr_fap_args(e));
+                    return;
+                }
+                lower_vdecl(b);
+                b = cont;
+                break;
+            }
+            case fn_body_kind::JDecl: {
+                unsigned label = m_labels.size();
+                m_labels.push_back(g_no_target);
+                for (param const & p : fn_body_jdecl_params(b))
+                    reg(param_var(p));
+                m_jps.push_back(jp_scope { fn_body_jdecl_id(b), label, &b.get() });
+                lower(fn_body_jdecl_cont(b));
+                m_jps.pop_back();
+                m_labels[label] = pc();
+                b = fn_body_jdecl_body(b);
+                break;
+            }
+            case fn_body_kind::Set:
+                emit(opcode::Set, reg(fn_body_set_var(b)), fn_body_set_idx(b).get_small_value(), arg_reg(fn_body_set_arg(b)));
+                b = fn_body_set_cont(b);
+                break;
+            case fn_body_kind::SetTag:
+                emit(opcode::SetTag, reg(fn_body_set_tag_var(b)), fn_body_set_tag_cidx(b).get_small_value());
+                b = fn_body_set_tag_cont(b);
+                break;
+            case fn_body_kind::USet:
+                emit(opcode::USet, reg(fn_body_uset_target(b)), fn_body_uset_idx(b).get_small_value(), reg(fn_body_uset_source(b)));
+                b = fn_body_uset_cont(b);
+                break;
+            case fn_body_kind::SSet: {
+                instr & i = emit(opcode::SSet, reg(fn_body_sset_target(b)),
+                                 fn_body_sset_idx(b).get_small_value() * sizeof(void *) + fn_body_sset_offset(b).get_small_value(),
+                                 reg(fn_body_sset_source(b)));
+                i.m_type = fn_body_sset_type(b);
+                b = fn_body_sset_cont(b);
+                break;
+            }
+            case fn_body_kind::Inc:
+                emit(opcode::Inc, reg(fn_body_inc_var(b)), fn_body_inc_val(b).get_small_value());
+                b = fn_body_inc_cont(b);
+                break;
+            case fn_body_kind::Dec:
+                emit(opcode::Dec, reg(fn_body_dec_var(b)), fn_body_dec_val(b).get_small_value());
+                b = fn_body_dec_cont(b);
+                break;
+            case fn_body_kind::Del:
+                emit(opcode::Del, reg(fn_body_del_var(b)));
+                b = fn_body_del_cont(b);
+                break;
+            case fn_body_kind::MData:
+                b = fn_body_mdata_cont(b);
+                break;
+            case fn_body_kind::Case:
+                lower_case(b);
+                return;
+            case fn_body_kind::Ret:
+                emit(opcode::Ret, arg_reg(fn_body_ret_arg(b)));
+                return;
+            case fn_body_kind::Jmp: {
+                jp_scope const & jp = find_jp(fn_body_jmp_jp(b));
+                array_ref<param> const & params = fn_body_jdecl_params(*jp.m_jdecl);
+                array_ref<arg> const & args     = fn_body_jmp_args(b);
+                if (params.size() != args.size())
+                    throw exception("invalid jump");
+                // the target is resolved in `operator()`
+                instr & i = emit(opcode::Jmp, jp.m_label);
+                add_args(i, args);
+                for (param const & p : params)
+                    add_operand(i, reg(param_var(p)));
+                return;
+            }
+            case fn_body_kind::Unreachable:
+                emit(opcode::Unreachable);
+                return;
+            }
+        }
+    }
+public:
+    explicit lower_fn(bytecode & bc):m_bc(bc), m_fn(decl_fun_id(bc.m_decl)) {}
+
+    void operator()() {
+        for (param const & p : decl_params(m_bc.m_decl))
+            reg(param_var(p));
+        lower(decl_fun_body(m_bc.m_decl));
+        for (instr & i : m_bc.m_code) {
+            if (i.m_op == opcode::Jmp)
+                i.m_a = m_labels[i.m_a];
+        }
+        m_bc.m_ok = true;
+    }
+};
+
 class interpreter {
     // stack of IR variable slots
     std::vector<value> m_arg_stack;
@@ -363,28 +1154,45 @@ class interpreter {
         // base pointers into the stack above
         size_t m_arg_bp;
         size_t m_jp_bp;
+        // true iff the function is run natively
+        bool m_native;
 
-        frame(name const & mFn, size_t mArgBp, size_t mJpBp) : m_fn(mFn), m_arg_bp(mArgBp), m_jp_bp(mJpBp) {}
+        frame(name const & mFn, size_t mArgBp, size_t mJpBp, bool mNative) :
+            m_fn(mFn), m_arg_bp(mArgBp), m_jp_bp(mJpBp), m_native(mNative) {}
     };
     std::vector<frame> m_call_stack;
     elab_environment const & m_env;
     options const & m_opts;
     // if `false`, use IR code where possible
     bool m_prefer_native;
-    struct constant_cache_entry {
-      bool m_is_scalar;
-      value m_val;
-    };
-    // caches values of nullary functions ("constants")
+    // caches values of nullary functions ("constants"); see also `g_imported_cache`
     name_map<constant_cache_entry> m_constant_cache;
-    struct symbol_cache_entry {
-        // looking up IR from .oleans is slow enough to warrant its own cache; but as local IR can
-        // be backtracked, this cache needs to be local as well.
-        decl m_decl;
-        native_symbol_cache_entry m_native;
-    };
     // caches symbol lookup successes _and_ failures
     name_map<symbol_cache_entry> m_symbol_cache;
+    // identity of the imports of `m_env`, see `imported_cache`
+    object_ref m_imports;
+    cache_stats m_constant_stats;
+    cache_stats m_symbol_stats;
+    // if `true`, interpret lowered bytecode instead of the IR where possible
+    bool m_use_bytecode;
+    // if true, call the unboxed version of native functions when possible, see `find_trampoline`
+    bool m_unboxed_calls;
+    // lowered declarations, keyed by the `decl` object
+    ptr_hash_map<object, bytecode *> m_bytecode;
+    // number of calls after which interpreted functions are JIT-compiled, or `0` if disabled
+    unsigned m_jit_threshold;
+    // maximal size in bytes of `g_constant_cache`, or `0` if it is not used
+    size_t m_shared_constant_limit;
+    struct jit_state {
+        // interpreted calls so far
+        unsigned m_calls = 0;
+        // true iff `m_native` is final
+        bool m_done = false;
+        native_symbol_cache_entry m_native {nullptr, false, nullptr, false};
+        trampoline m_trampoline = nullptr;
+    };
+    // JIT state of interpreted functions, keyed by the `decl` object
+    ptr_hash_map<object, jit_state> m_jit;
 
     /** \brief Get current stack frame */
     inline frame & get_frame() {
@@ -424,6 +1232,20 @@ private:
         return arg_is_irrelevant(a) ? box(0) : var(arg_var_id(a));
     }
 
+    /** \brief Allocate constructor object with the given layout, `get_arg(i)` returns the `i`-th object field */
+    template<class F> static object * alloc_ctor_core(ctor_layout const & l, size_t n, F const & get_arg) {
+        if (l.m_num_objs == 0 && l.m_scalar_sz == 0) {
+            // a constructor without data is optimized to a tagged pointer
+            return box(l.m_tag);
+        } else {
+            object * o = alloc_cnstr(l.m_tag, l.m_num_objs, l.m_scalar_sz);
+            for (size_t i = 0; i < n; i++) {
+                cnstr_set(o, i, get_arg(i).m_obj);
+            }
+            return o;
+        }
+    }
+
     /** \brief Allocate constructor object with given tag and arguments */
     object * alloc_ctor(ctor_info const & i, array_ref<arg> const & args) {
         size_t tag = ctor_info_tag(i).get_small_value();
@@ -458,6 +1280,25 @@ private:
         return cls;
     }
 
+    /** \brief Partially apply `sym` to `n` arguments, `get_arg(i)` returns the `i`-th argument */
+    template<class F> object * mk_pap(symbol_cache_entry const & sym, size_t n, F const & get_arg) {
+        if (sym.m_native.m_addr) {
+            // point closure directly at native symbol
+            object * cls = alloc_closure(sym.m_native.m_addr, decl_params(sym.m_decl).size(), n);
+            for (unsigned i = 0; i < n; i++) {
+                closure_set(cls, i, get_arg(i).m_obj);
+            }
+            return cls;
+        } else {
+            // point closure at interpreter stub
+            object ** args = static_cast<object **>(LEAN_ALLOCA(n * sizeof(object *))); // NOLINT
+            for (size_t i = 0; i < n; i++) {
+                args[i] = get_arg(i).m_obj;
+            }
+            return mk_stub_closure(sym.m_decl, n, args);
+        }
+    }
+
     value eval_expr(expr const & e, type t) {
         switch (expr_tag(e)) {
             case expr_kind::Ctor:
@@ -526,22 +1367,8 @@ private:
                 }
             }
             case expr_kind::PAp: { // unsatured (partial) application of top-level function
-                symbol_cache_entry sym = lookup_symbol(expr_pap_fun(e));
-                if (sym.m_native.m_addr) {
-                    // point closure directly at native symbol
-                    object * cls = alloc_closure(sym.m_native.m_addr, decl_params(sym.m_decl).size(), expr_pap_args(e).size());
-                    for (unsigned i = 0; i < expr_pap_args(e).size(); i++) {
-                        closure_set(cls, i, eval_arg(expr_pap_args(e)[i]).m_obj);
-                    }
-                    return cls;
-                } else {
-                    // point closure at interpreter stub
-                    object ** args = static_cast<object **>(LEAN_ALLOCA(expr_pap_args(e).size() * sizeof(object *))); // NOLINT
-                    for (size_t i = 0; i < expr_pap_args(e).size(); i++) {
-                        args[i] = eval_arg(expr_pap_args(e)[i]).m_obj;
-                    }
-                    return mk_stub_closure(sym.m_decl, expr_pap_args(e).size(), args);
-                }
+                array_ref<arg> const & args = expr_pap_args(e);
+                return mk_pap(lookup_symbol(expr_pap_fun(e)), args.size(), [&](size_t i) { return eval_arg(args[i]); });
             }
             case expr_kind::Ap: { // (saturated or unsatured) application of closure; mostly handled by runtime
                 object ** args = static_cast<object **>(LEAN_ALLOCA(expr_ap_args(e).size() * sizeof(object *))); // NOLINT
@@ -598,7 +1425,24 @@ private:
         throw exception(sstream() << "unexpected instruction kind " << static_cast<unsigned>(expr_tag(e)));
     }
 
+    /** \brief Record the current call stack if the sampling profiler has advanced since the last sample of this
+        thread. */
+    inline void check_profiler() {
+        uint64 tick = g_profiler_tick.load(std::memory_order_relaxed);
+        if (LEAN_UNLIKELY(tick != g_profiler_last_tick)) {
+            uint64 last_tick = g_profiler_last_tick;
+            g_profiler_last_tick = tick;
+            std::vector<std::string> stack;
+            stack.reserve(m_call_stack.size());
+            for (frame const & f : m_call_stack) {
+                stack.push_back(f.m_native ? f.m_fn.to_string() + " [native]" : f.m_fn.to_string());
+            }
+            record_profiler_sample(stack, tick, last_tick);
+        }
+    }
+
     void check_system() {
+        check_profiler();
         try {
             lean::check_system("interpreter");
         } catch (stack_space_exception & ex) {
@@ -772,8 +1616,266 @@ private:
         }
     }
 
+    /** \brief Return the lowered code of `d`, lowering it on first use. Returns `nullptr` if it cannot be lowered. */
+    bytecode * get_bytecode(decl const & d) {
+        auto it = m_bytecode.find(d.raw());
+        if (it != m_bytecode.end())
+            return it->second->m_ok ? it->second : nullptr;
+        bytecode * bc = new bytecode(d);
+        m_bytecode.insert(std::make_pair(d.raw(), bc));
+        try {
+            lower_fn lower(*bc);
+            lower();
+        } catch (exception &) {
+            // fall back to `eval_body`, which reports the error if the code is actually reached
+            bc->m_ok = false;
+            return nullptr;
+        }
+        return bc;
+    }
+
+    /** \brief Evaluate body of the function of the current frame. */
+    value eval_fn(decl const & d) {
+        if (m_use_bytecode) {
+            if (bytecode * bc = get_bytecode(d))
+                return eval_bytecode(*bc);
+        }
+        return eval_body(decl_fun_body(d));
+    }
+
+    symbol_cache_entry const & resolve(callee & c) {
+        if (!c.m_resolved) {
+            c.m_sym      = lookup_symbol(c.m_fn);
+            c.m_resolved = true;
+        }
+        return c.m_sym;
+    }
+
+    value eval_bytecode(bytecode & bc0) {
+        // replaced by tail calls of other functions
+        bytecode * bc = &bc0;
+        check_system();
+        size_t bp = get_frame().m_arg_bp;
+        // arguments have already been pushed
+        if (m_arg_stack.size() < bp + bc->m_num_regs)
+            m_arg_stack.resize(bp + bc->m_num_regs);
+        // NOTE: calls may resize `m_arg_stack`, so we must not hold on to register references across them
+        auto reg = [&](uint32 r) -> value & { return m_arg_stack[bp + r]; };
+        auto arg = [&](uint32 r) -> value { return r == g_irrelevant_reg ? value(box(0)) : m_arg_stack[bp + r]; };
+        uint32 pc = 0;
+        while (true) {
+            instr const & i  = bc->m_code[pc++];
+            uint32 const * ops = bc->m_operands.data() + i.m_ops;
+            auto get_op_arg  = [&](size_t j) { return arg(ops[j]); };
+            switch (i.m_op) {
+            case opcode::Ctor:
+                reg(i.m_dst) = alloc_ctor_core(bc->m_ctors[i.m_a], i.m_num_ops, get_op_arg);
+                break;
+            case opcode::Reset: { // release fields if unique reference in preparation for `Reuse` below
+                object * o = reg(i.m_a).m_obj;
+                if (is_exclusive(o)) {
+                    for (size_t j = 0; j < i.m_b; j++) {
+                        cnstr_release(o, j);
+                    }
+                    reg(i.m_dst) = o;
+                } else {
+                    dec_ref(o);
+                    reg(i.m_dst) = box(0);
+                }
+                break;
+            }
+            case opcode::Reuse: { // reuse dead allocation if possible
+                object * o = reg(i.m_a).m_obj;
+                ctor_layout const & l = bc->m_ctors[i.m_b];
+                if (is_scalar(o)) {
+                    o = alloc_ctor_core(l, i.m_num_ops, get_op_arg);
+                } else {
+                    if (i.m_flag) {
+                        cnstr_set_tag(o, l.m_tag);
+                    }
+                    for (size_t j = 0; j < i.m_num_ops; j++) {
+                        cnstr_set(o, j, arg(ops[j]).m_obj);
+                    }
+                }
+                reg(i.m_dst) = o;
+                break;
+            }
+            case opcode::Proj:
+                reg(i.m_dst) = cnstr_get(reg(i.m_a).m_obj, i.m_b);
+                break;
+            case opcode::UProj:
+                reg(i.m_dst) = cnstr_get_usize(reg(i.m_a).m_obj, i.m_b);
+                break;
+            case opcode::SProj: {
+                object * o = reg(i.m_a).m_obj;
+                value v;
+                switch (i.m_type) {
+                    case type::Float: v = value::from_float(cnstr_get_float(o, i.m_b)); break;
+                    case type::Float32: v = value::from_float32(cnstr_get_float32(o, i.m_b)); break;
+                    case type::UInt8: v = cnstr_get_uint8(o, i.m_b); break;
+                    case type::UInt16: v = cnstr_get_uint16(o, i.m_b); break;
+                    case type::UInt32: v = cnstr_get_uint32(o, i.m_b); break;
+                    case type::UInt64: v = cnstr_get_uint64(o, i.m_b); break;
+                    default: throw exception("invalid instruction");
+                }
+                reg(i.m_dst) = v;
+                break;
+            }
+            case opcode::FAp: {
+                value v = call_core(resolve(bc->m_callees[i.m_a]), i.m_num_ops, get_op_arg);
+                reg(i.m_dst) = v;
+                break;
+            }
+            case opcode::Load: {
+                value v = load(bc->m_callees[i.m_a].m_fn, i.m_type);
+                reg(i.m_dst) = v;
+                break;
+            }
+            case opcode::PAp:
+                reg(i.m_dst) = mk_pap(resolve(bc->m_callees[i.m_a]), i.m_num_ops, get_op_arg);
+                break;
+            case opcode::Ap: {
+                // not `LEAN_ALLOCA`, which would only be freed when the loop returns
+                buffer<object *> args;
+                for (size_t j = 0; j < i.m_num_ops; j++) {
+                    args.push_back(arg(ops[j]).m_obj);
+                }
+                object * r = apply_n(reg(i.m_a).m_obj, i.m_num_ops, args.data());
+                reg(i.m_dst) = r;
+                break;
+            }
+            case opcode::Box:
+                reg(i.m_dst) = box_t(reg(i.m_a), i.m_type);
+                break;
+            case opcode::Unbox:
+                reg(i.m_dst) = unbox_t(reg(i.m_a).m_obj, i.m_type);
+                break;
+            case opcode::Lit:
+                reg(i.m_dst) = bc->m_lits[i.m_a];
+                break;
+            case opcode::ObjLit:
+                reg(i.m_dst) = bc->m_obj_lits[i.m_a].to_obj_arg();
+                break;
+            case opcode::IsShared:
+                reg(i.m_dst) = static_cast<uint64>(!is_exclusive(reg(i.m_a).m_obj));
+                break;
+            case opcode::IsTaggedPtr:
+                reg(i.m_dst) = static_cast<uint64>(!is_scalar(reg(i.m_a).m_obj));
+                break;
+            case opcode::Set: { // set boxed field of unique reference
+                object * o = reg(i.m_a).m_obj;
+                lean_assert(is_exclusive(o));
+                cnstr_set(o, i.m_b, arg(i.m_c).m_obj);
+                break;
+            }
+            case opcode::SetTag: // set constructor tag of unique reference
+                lean_assert(is_exclusive(reg(i.m_a).m_obj));
+                cnstr_set_tag(reg(i.m_a).m_obj, i.m_b);
+                break;
+            case opcode::USet: // set USize field of unique reference
+                lean_assert(is_exclusive(reg(i.m_a).m_obj));
+                cnstr_set_usize(reg(i.m_a).m_obj, i.m_b, reg(i.m_c).m_num);
+                break;
+            case opcode::SSet: { // set other unboxed field of unique reference
+                object * o = reg(i.m_a).m_obj;
+                value v = reg(i.m_c);
+                lean_assert(is_exclusive(o));
+                switch (i.m_type) {
+                    case type::Float: cnstr_set_float(o, i.m_b, v.m_float); break;
+                    case type::Float32: cnstr_set_float32(o, i.m_b, v.m_float32); break;
+                    case type::UInt8: cnstr_set_uint8(o, i.m_b, v.m_num); break;
+                    case type::UInt16: cnstr_set_uint16(o, i.m_b, v.m_num); break;
+                    case type::UInt32: cnstr_set_uint32(o, i.m_b, v.m_num); break;
+                    case type::UInt64: cnstr_set_uint64(o, i.m_b, v.m_num); break;
+                    default: throw exception("invalid instruction");
+                }
+                break;
+            }
+            case opcode::Inc:
+                inc(reg(i.m_a).m_obj, i.m_b);
+                break;
+            case opcode::Dec:
+                for (size_t j = 0; j < i.m_b; j++) {
+                    dec(reg(i.m_a).m_obj);
+                }
+                break;
+            case opcode::Del:
+                lean_free_object(reg(i.m_a).m_obj);
+                break;
+            case opcode::Case: { // branch according to constructor tag
+                value v = reg(i.m_a);
+                size_t tag = type_is_scalar(i.m_type) ? v.m_num : lean_obj_tag(v.m_obj);
+                std::vector<uint32> const & table = bc->m_jump_tables[i.m_b];
+                pc = tag < table.size() - 1 ? table[tag] : table.back();
+                if (pc == g_no_target)
+                    throw exception("incomplete case");
+                break;
+            }
+            case opcode::Ret:
+                return arg(i.m_a);
+            case opcode::Jmp: { // jump to join point after assigning its parameters
+                size_t n = i.m_num_ops / 2;
+                for (size_t j = 0; j < n; j++) {
+                    reg(ops[n + j]) = arg(ops[j]);
+                }
+                pc = i.m_a;
+                break;
+            }
+            case opcode::TailCall: {
+                // argument and parameter registers may overlap, so first copy the arguments to the top of the stack
+                size_t n = i.m_num_ops / 2;
+                size_t top = m_arg_stack.size();
+                for (size_t j = 0; j < n; j++) {
+                    m_arg_stack.push_back(arg(ops[j]));
+                }
+                for (size_t j = 0; j < n; j++) {
+                    reg(ops[n + j]) = m_arg_stack[top + j];
+                }
+                m_arg_stack.resize(top);
+                pc = 0;
+                check_system();
+                break;
+            }
+            case opcode::TailFAp: {
+                symbol_cache_entry const & e = resolve(bc->m_callees[i.m_a]);
+                bytecode * callee_bc = nullptr;
+                if (!e.m_native.m_addr && !(e.m_trampoline && m_unboxed_calls) && decl_tag(e.m_decl) == decl_kind::Fun)
+                    callee_bc = get_bytecode(e.m_decl);
+                if (!callee_bc)
+                    return call_core(e, i.m_num_ops, get_op_arg);
+                if (m_jit_threshold) {
+                    if (optional<symbol_cache_entry> jitted = jit(e))
+                        return call_core(*jitted, i.m_num_ops, get_op_arg);
+                }
+                // replace the current frame by the one of the callee, so that loops made of mutual tail calls run
+                // in constant space like they do in compiled code
+                // the arguments are staged on top of the stack; copying them down in ascending order is safe even if
+                // the two ranges overlap
+                size_t n = i.m_num_ops;
+                size_t top = m_arg_stack.size();
+                for (size_t j = 0; j < n; j++) {
+                    m_arg_stack.push_back(arg(ops[j]));
+                }
+                for (size_t j = 0; j < n; j++) {
+                    m_arg_stack[bp + j] = m_arg_stack[top + j];
+                }
+                m_arg_stack.resize(bp + n);
+                get_frame().m_fn = decl_fun_id(e.m_decl);
+                bc = callee_bc;
+                if (m_arg_stack.size() < bp + bc->m_num_regs)
+                    m_arg_stack.resize(bp + bc->m_num_regs);
+                pc = 0;
+                check_system();
+                break;
+            }
+            case opcode::Unreachable:
+                throw exception("unreachable code");
+            }
+        }
+    }
+
     // specify argument base pointer explicitly because we've usually already pushed some function arguments
-    void push_frame(decl const & d, size_t arg_bp) {
+    void push_frame(decl const & d, size_t arg_bp, bool native = false) {
         DEBUG_CODE({
             lean_trace(name({"interpreter", "call"}),
                        tout() << std::string(m_call_stack.size(), ' ')
@@ -783,7 +1885,7 @@ private:
                        }
                        tout() << "\n";);
         });
-        m_call_stack.emplace_back(decl_fun_id(d), arg_bp, m_jp_stack.size());
+        m_call_stack.emplace_back(decl_fun_id(d), arg_bp, m_jp_stack.size(), native);
     }
 
     void pop_frame(value DEBUG_CODE(r), type DEBUG_CODE(t)) {
@@ -802,37 +1904,78 @@ private:
     /** \brief Return cached lookup result for given unmangled function name in the current binary. */
     symbol_cache_entry lookup_symbol(name const & fn) {
         if (symbol_cache_entry const * e = m_symbol_cache.find(fn)) {
+            m_symbol_stats.m_hits++;
             return *e;
         }
+        bool imported = is_imported(fn);
+        if (imported) {
+            std::shared_lock<std::shared_timed_mutex> lock(*g_imported_cache_mutex);
+            if (g_imported_cache->m_imports == m_imports.raw()) {
+                auto it = g_imported_cache->m_symbols.find(fn);
+                if (it != g_imported_cache->m_symbols.end()) {
+                    m_symbol_stats.m_shared_hits++;
+                    m_symbol_cache.insert(fn, it->second);
+                    return it->second;
+                }
+            }
+        }
+        m_symbol_stats.m_misses++;
+        decl d = get_decl(fn);
+        symbol_cache_entry e_new { d, lookup_native_symbol(fn, d) };
+        e_new.m_trampoline = find_trampoline(d, e_new.m_native);
+        m_symbol_cache.insert(fn, e_new);
+        if (imported) {
+            std::unique_lock<std::shared_timed_mutex> lock(*g_imported_cache_mutex);
+            if (g_imported_cache->m_imports != m_imports.raw())
+                g_imported_cache->reset(m_imports.raw());
+            name key = fn;
+            mark_mt(key.raw());
+            mark_mt(d.raw());
+            g_imported_cache->m_symbols.insert(std::make_pair(key, e_new));
+        }
+        return e_new;
+    }
+
+    /** \brief Return cached native symbol of `fn` with IR declaration `d`. */
+    native_symbol_cache_entry lookup_native_symbol(name const & fn, decl const & d) {
         std::shared_lock<std::shared_timed_mutex> lock(*g_native_symbol_cache_mutex);
         if (native_symbol_cache_entry const * ne = g_native_symbol_cache->find(fn)) {
-            symbol_cache_entry e_new { get_decl(fn), *ne };
-            m_symbol_cache.insert(fn, e_new);
-            return e_new;
+            return *ne;
         }
         lock.unlock();
         std::unique_lock<std::shared_timed_mutex> unique_lock(*g_native_symbol_cache_mutex);
         if (native_symbol_cache_entry const * ne = g_native_symbol_cache->find(fn)) {
-            symbol_cache_entry e_new { get_decl(fn), *ne };
-            m_symbol_cache.insert(fn, e_new);
-            return e_new;
+            return *ne;
         }
-        symbol_cache_entry e_new { get_decl(fn), {nullptr, false} };
-        if (m_prefer_native || decl_tag(e_new.m_decl) == decl_kind::Extern || has_init_attribute(m_env, fn)) {
+        native_symbol_cache_entry ne {nullptr, false, nullptr, false};
+        if (m_prefer_native || decl_tag(d) == decl_kind::Extern || has_init_attribute(m_env, fn)) {
             string_ref mangled = name_mangle(fn, *g_mangle_prefix);
             string_ref boxed_mangled(string_append(mangled.to_obj_arg(), g_boxed_mangled_suffix->raw()));
             // check for boxed version first
             if (void *p_boxed = lookup_symbol_in_cur_exe(boxed_mangled.data())) {
-                e_new.m_native.m_addr = p_boxed;
-                e_new.m_native.m_boxed = true;
+                ne.m_addr = p_boxed;
+                ne.m_boxed = true;
+                if (decl_tag(d) == decl_kind::Extern) {
+                    // the boxed version wraps the C function, which may not be inlined into it
+                    if (optional<string_ref> c_fn = get_extern_c_name_for(m_env, fn).get()) {
+                        ne.m_unboxed_addr = lookup_symbol_in_cur_exe(c_fn->data());
+                        ne.m_unboxed_extern = true;
+                    }
+                } else {
+                    ne.m_unboxed_addr = lookup_symbol_in_cur_exe(mangled.data());
+                }
             } else if (void *p = lookup_symbol_in_cur_exe(mangled.data())) {
                 // if there is no boxed version, there are no unboxed parameters, so use default version
-                e_new.m_native.m_addr = p;
+                ne.m_addr = p;
             }
         }
-        g_native_symbol_cache->insert(fn, e_new.m_native);
-        m_symbol_cache.insert(fn, e_new);
-        return e_new;
+        g_native_symbol_cache->insert(fn, ne);
+        return ne;
+    }
+
+    /** \brief Return true iff `fn` is imported, i.e. its IR cannot change when the environment is extended. */
+    bool is_imported(name const & fn) const {
+        return lean_elab_environment_is_imported_const(m_env.to_obj_arg(), fn.to_obj_arg()) != 0;
     }
 
     /** \brief Retrieve Lean declaration from elab_environment. */
@@ -847,6 +1990,7 @@ private:
     /** \brief Evaluate nullary function ("constant"). */
     value load(name const & fn, type t) {
         if (constant_cache_entry const * cached = m_constant_cache.find(fn)) {
+            m_constant_stats.m_hits++;
             if (!cached->m_is_scalar) {
                 inc(cached->m_val.m_obj);
             }
@@ -886,26 +2030,117 @@ private:
             // We don't know whether `[init]` decls can be re-executed, so let's not.
             throw exception(sstream() << "cannot evaluate `[init]` declaration '" << fn << "' in the same module");
         }
+        if (m_shared_constant_limit) {
+            lock_guard<std::mutex> lock(*g_constant_cache_mutex);
+            auto it = g_constant_cache->m_entries.find(e.m_decl.raw());
+            if (it != g_constant_cache->m_entries.end()) {
+                m_constant_stats.m_shared_hits++;
+                it->second.m_last_use = ++g_constant_cache->m_clock;
+                constant_cache_entry const & c = it->second.m_entry;
+                if (!c.m_is_scalar) {
+                    // one reference for `m_constant_cache` and one for the caller
+                    inc(c.m_val.m_obj, 2);
+                }
+                m_constant_cache.insert(fn, c);
+                return c.m_val;
+            }
+        }
+        m_constant_stats.m_misses++;
         push_frame(e.m_decl, m_arg_stack.size());
         lean_always_assert(decl_tag(e.m_decl) == decl_kind::Fun);
-        value r = eval_body(decl_fun_body(e.m_decl));
+        value r = eval_fn(e.m_decl);
         pop_frame(r, decl_type(e.m_decl));
         if (!type_is_scalar(t)) {
             inc(r.m_obj);
         }
         m_constant_cache.insert(fn, constant_cache_entry { type_is_scalar(t), r });
+        if (m_shared_constant_limit) {
+            size_t byte_size = sizeof(shared_constant_cache::entry);
+            if (!type_is_scalar(t)) {
+                // measure before marking, as only objects that are not shared yet are counted
+                byte_size += unshared_byte_size(r.m_obj);
+                mark_mt(r.m_obj);
+            }
+            if (byte_size <= m_shared_constant_limit) {
+                lock_guard<std::mutex> lock(*g_constant_cache_mutex);
+                // another thread may have evaluated the constant concurrently
+                if (g_constant_cache->m_entries.find(e.m_decl.raw()) == g_constant_cache->m_entries.end()) {
+                    if (!type_is_scalar(t)) {
+                        inc(r.m_obj);
+                    }
+                    mark_mt(e.m_decl.raw());
+                    inc_ref(e.m_decl.raw());
+                    g_constant_cache->m_entries.insert(std::make_pair(e.m_decl.raw(), shared_constant_cache::entry {
+                        constant_cache_entry { type_is_scalar(t), r }, byte_size, ++g_constant_cache->m_clock }));
+                    g_constant_cache->m_byte_size += byte_size;
+                    g_constant_cache->shrink(m_shared_constant_limit);
+                }
+            }
+        }
         return r;
     }
 
+    /** \brief Count an interpreted call of `e` and return its native version once `e` has been called
+        `m_jit_threshold` times and could be JIT-compiled. */
+    optional<symbol_cache_entry> jit(symbol_cache_entry const & e) {
+        auto p = m_jit.try_emplace(e.m_decl.raw());
+        jit_state & s = p.first->second;
+        if (!s.m_done) {
+            if (p.second) {
+                // it may have been compiled by another interpreter
+                std::lock_guard<std::mutex> lock(*g_jit_mutex);
+                auto it = g_jit_cache->find(e.m_decl.raw());
+                if (it != g_jit_cache->end()) {
+                    s.m_done   = true;
+                    s.m_native = it->second;
+                }
+            }
+            if (!s.m_done && ++s.m_calls >= m_jit_threshold) {
+                s.m_done   = true;
+                s.m_native = jit_compile(m_env, e.m_decl);
+            }
+            if (s.m_native.m_addr) {
+                s.m_trampoline = find_trampoline(e.m_decl, s.m_native);
+                // later lookups of the function can use the native code directly
+                symbol_cache_entry r { e.m_decl, s.m_native };
+                r.m_trampoline = s.m_trampoline;
+                m_symbol_cache.insert(decl_fun_id(e.m_decl), r);
+            }
+        }
+        if (!s.m_native.m_addr) {
+            return optional<symbol_cache_entry>();
+        }
+        symbol_cache_entry r { e.m_decl, s.m_native };
+        r.m_trampoline = s.m_trampoline;
+        return optional<symbol_cache_entry>(r);
+    }
+
     value call(name const & fn, array_ref<arg> const & args) {
+        return call_core(lookup_symbol(fn), args.size(), [&](size_t i) { return eval_arg(args[i]); });
+    }
+
+    /** \brief Call `e` with `n` arguments, `get_arg(i)` returns the `i`-th argument in the current frame */
+    template<class F> value call_core(symbol_cache_entry const & e, size_t n, F const & get_arg) {
         size_t old_size = m_arg_stack.size();
         value r;
-        symbol_cache_entry e = lookup_symbol(fn);
-        if (e.m_native.m_addr) {
-            object ** args2 = static_cast<object **>(LEAN_ALLOCA(args.size() * sizeof(object *))); // NOLINT
-            for (size_t i = 0; i < args.size(); i++) {
+        if (e.m_trampoline && m_unboxed_calls) {
+            // call the unboxed version with the IR calling convention, so no boxing or reference counting is needed
+            value * args2 = static_cast<value *>(LEAN_ALLOCA(n * sizeof(value))); // NOLINT
+            size_t j = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (e.m_native.m_unboxed_extern && param_type(decl_params(e.m_decl)[i]) == type::Irrelevant) {
+                    continue;
+                }
+                args2[j++] = get_arg(i);
+            }
+            push_frame(e.m_decl, old_size, true);
+            r = truncate_t(e.m_trampoline(e.m_native.m_unboxed_addr, args2), decl_type(e.m_decl));
+            check_profiler();
+        } else if (e.m_native.m_addr) {
+            object ** args2 = static_cast<object **>(LEAN_ALLOCA(n * sizeof(object *))); // NOLINT
+            for (size_t i = 0; i < n; i++) {
                 type t = param_type(decl_params(e.m_decl)[i]);
-                args2[i] = box_t(eval_arg(args[i]), t);
+                args2[i] = box_t(get_arg(i), t);
                 if (e.m_native.m_boxed && param_borrow(decl_params(e.m_decl)[i])) {
                     // NOTE: If we chose the boxed version where the IR chose the unboxed one, we need to manually increment
                     // originally borrowed parameters because the wrapper will decrement these after the call.
@@ -914,8 +2149,9 @@ private:
                     inc(args2[i]);
                 }
             }
-            push_frame(e.m_decl, old_size);
-            object * o = curry(e.m_native.m_addr, args.size(), args2);
+            push_frame(e.m_decl, old_size, true);
+            object * o = curry(e.m_native.m_addr, n, args2);
+            check_profiler();
             type t = decl_type(e.m_decl);
             if (type_is_scalar(t)) {
                 lean_assert(e.m_native.m_boxed);
@@ -926,7 +2162,13 @@ private:
                 r = o;
             }
         } else {
+            if (m_jit_threshold) {
+                if (optional<symbol_cache_entry> jitted = jit(e)) {
+                    return call_core(*jitted, n, get_arg);
+                }
+            }
             if (decl_tag(e.m_decl) == decl_kind::Extern) {
+                name const & fn = decl_fun_id(e.m_decl);
                 string_ref mangled = name_mangle(fn, *g_mangle_prefix);
                 string_ref boxed_mangled(string_append(mangled.to_obj_arg(), g_boxed_mangled_suffix->raw()));
                 throw exception(sstream() << "Could not find native implementation of external declaration '" << fn
@@ -935,11 +2177,11 @@ private:
                                           << "in the relevant `lean_exe` statement in your `lakefile.lean`.");
             }
             // evaluate args in old stack frame
-            for (const auto & arg : args) {
-                m_arg_stack.push_back(eval_arg(arg));
+            for (size_t i = 0; i < n; i++) {
+                m_arg_stack.push_back(get_arg(i));
             }
             push_frame(e.m_decl, old_size);
-            r = eval_body(decl_fun_body(e.m_decl));
+            r = eval_fn(e.m_decl);
         }
         pop_frame(r, decl_type(e.m_decl));
         return r;
@@ -948,12 +2190,17 @@ private:
     // closure stub
     object * stub_m(object ** args) {
         decl d(args[2]);
+        if (m_jit_threshold) {
+            if (optional<symbol_cache_entry> jitted = jit(symbol_cache_entry { d, {nullptr, false, nullptr, false} })) {
+                return call_core(*jitted, decl_params(d).size(), [&](size_t i) { return value(args[3 + i]); }).m_obj;
+            }
+        }
         size_t old_size = m_arg_stack.size();
         for (size_t i = 0; i < decl_params(d).size(); i++) {
             m_arg_stack.push_back(args[3 + i]);
         }
         push_frame(d, old_size);
-        object * r = eval_body(decl_fun_body(d)).m_obj;
+        object * r = eval_fn(d).m_obj;
         pop_frame(r, type::TObject);
         return r;
     }
@@ -1008,8 +2255,18 @@ private:
         }
     }
 public:
-    explicit interpreter(elab_environment const & env, options const & opts) : m_env(env), m_opts(opts) {
+    explicit interpreter(elab_environment const & env, options const & opts) :
+        m_env(env), m_opts(opts), m_imports(lean_elab_environment_imports_id(env.to_obj_arg())) {
         m_prefer_native = opts.get_bool(*g_interpreter_prefer_native, LEAN_DEFAULT_INTERPRETER_PREFER_NATIVE);
+        m_use_bytecode = opts.get_bool(*g_interpreter_bytecode, LEAN_DEFAULT_INTERPRETER_BYTECODE);
+        m_unboxed_calls = opts.get_bool(*g_interpreter_unboxed_calls, LEAN_DEFAULT_INTERPRETER_UNBOXED_CALLS);
+        m_shared_constant_limit = static_cast<size_t>(opts.get_unsigned(*g_interpreter_shared_constant_cache,
+            LEAN_DEFAULT_INTERPRETER_SHARED_CONSTANT_CACHE)) << 20;
+#ifdef LEAN_LLVM
+        m_jit_threshold = opts.get_unsigned(*g_interpreter_jit_threshold, LEAN_DEFAULT_INTERPRETER_JIT_THRESHOLD);
+#else
+        m_jit_threshold = 0;
+#endif
     }
 
     interpreter(interpreter const &) = delete;
@@ -1020,6 +2277,13 @@ public:
                 dec(e.m_val.m_obj);
             }
         });
+        for (auto const & p : m_bytecode) {
+            delete p.second;
+        }
+        if (get_profiler(m_opts)) {
+            m_symbol_stats.report("symbol");
+            m_constant_stats.report("constant");
+        }
     }
 
     /** A variant of `call` designed for external uses.
@@ -1135,6 +2399,78 @@ uint32 run_main(elab_environment const & env, options const & opts, list_ref<str
     return interpreter::with_interpreter<uint32>(env, opts, "main", [&](interpreter & interp) { return interp.run_main(args); });
 }
 
+/* hasNativeSymbol (sym : @& String) : BaseIO Bool */
+extern "C" LEAN_EXPORT obj_res lean_ir_has_native_symbol(b_obj_arg sym, obj_arg) {
+    return io_result_mk_ok(box(lookup_symbol_in_cur_exe(string_cstr(sym)) != nullptr));
+}
+
+/* startInterpreterProfiler (intervalUs : UInt32) : BaseIO Unit */
+extern "C" LEAN_EXPORT obj_res lean_interpreter_profiler_start(uint32 interval_us, obj_arg) {
+#if defined(LEAN_MULTI_THREAD)
+    std::lock_guard<std::mutex> lock(g_profiler->m_mutex);
+    if (g_profiler->m_thread || interval_us == 0) {
+        return io_result_mk_ok(box(0));
+    }
+    g_profiler->m_stop = false;
+    g_profiler->m_start_tick = g_profiler_tick.load(std::memory_order_relaxed);
+    g_profiler->m_frames.clear();
+    g_profiler->m_frame_idx.clear();
+    g_profiler->m_samples.clear();
+    g_profiler->m_thread = new std::thread([=]() {
+        std::unique_lock<std::mutex> lock(g_profiler->m_mutex);
+        auto interval = std::chrono::microseconds(interval_us);
+        auto next = std::chrono::steady_clock::now() + interval;
+        while (!g_profiler->m_cv.wait_until(lock, next, []() { return g_profiler->m_stop; })) {
+            g_profiler_tick.fetch_add(1, std::memory_order_relaxed);
+            next += interval;
+        }
+    });
+#endif
+    return io_result_mk_ok(box(0));
+}
+
+/* stopInterpreterProfiler : BaseIO InterpreterProfile */
+extern "C" LEAN_EXPORT obj_res lean_interpreter_profiler_stop(obj_arg) {
+    std::thread * thread;
+    {
+        std::lock_guard<std::mutex> lock(g_profiler->m_mutex);
+        thread = g_profiler->m_thread;
+        g_profiler->m_stop = true;
+    }
+    if (thread) {
+        g_profiler->m_cv.notify_all();
+        thread->join();
+        delete thread;
+    }
+    std::lock_guard<std::mutex> lock(g_profiler->m_mutex);
+    g_profiler->m_thread = nullptr;
+    object * frames = alloc_array(g_profiler->m_frames.size(), g_profiler->m_frames.size());
+    for (size_t i = 0; i < g_profiler->m_frames.size(); i++) {
+        array_set(frames, i, mk_string(g_profiler->m_frames[i]));
+    }
+    object * samples = alloc_array(g_profiler->m_samples.size(), g_profiler->m_samples.size());
+    for (size_t i = 0; i < g_profiler->m_samples.size(); i++) {
+        profiler_sample const & s = g_profiler->m_samples[i];
+        object * stack = alloc_array(s.m_stack.size(), s.m_stack.size());
+        for (size_t j = 0; j < s.m_stack.size(); j++) {
+            array_set(stack, j, mk_nat_obj(s.m_stack[j]));
+        }
+        object * sample = alloc_cnstr(0, 4, 0);
+        cnstr_set(sample, 0, uint64_to_nat(s.m_tid));
+        cnstr_set(sample, 1, uint64_to_nat(s.m_time));
+        cnstr_set(sample, 2, stack);
+        cnstr_set(sample, 3, uint64_to_nat(s.m_ticks));
+        array_set(samples, i, sample);
+    }
+    g_profiler->m_frames.clear();
+    g_profiler->m_frame_idx.clear();
+    g_profiler->m_samples.clear();
+    object * r = alloc_cnstr(0, 2, 0);
+    cnstr_set(r, 0, frames);
+    cnstr_set(r, 1, samples);
+    return io_result_mk_ok(r);
+}
+
 /* runMain (env : Environment) (opts : Iptions) (args : List String) : BaseIO UInt32 */
 extern "C" LEAN_EXPORT obj_res lean_run_main(b_obj_arg env, b_obj_arg opts, b_obj_arg args, obj_arg) {
     uint32 ret = run_main(TO_REF(elab_environment, env), TO_REF(options, opts), TO_REF(list_ref<string_ref>, args));
@@ -1184,8 +2520,17 @@ void initialize_ir_interpreter() {
     ir::g_boxed_mangled_suffix = new string_ref("___boxed");
     mark_persistent(ir::g_boxed_mangled_suffix->raw());
     ir::g_interpreter_prefer_native = new name({"interpreter", "prefer_native"});
+    ir::g_interpreter_bytecode = new name({"interpreter", "bytecode"});
+    ir::g_interpreter_unboxed_calls = new name({"interpreter", "unboxed_calls"});
+    ir::g_interpreter_jit_threshold = new name({"interpreter", "jit_threshold"});
+    ir::g_interpreter_shared_constant_cache = new name({"interpreter", "shared_constant_cache"});
     ir::g_init_globals = new name_map<object *>();
     register_bool_option(*ir::g_interpreter_prefer_native, LEAN_DEFAULT_INTERPRETER_PREFER_NATIVE, "(interpreter) whether to use precompiled code where available");
+    register_bool_option(*ir::g_interpreter_bytecode, LEAN_DEFAULT_INTERPRETER_BYTECODE, "(interpreter) whether to lower IR to register bytecode before interpreting it");
+    register_bool_option(*ir::g_interpreter_unboxed_calls, LEAN_DEFAULT_INTERPRETER_UNBOXED_CALLS, "(interpreter) whether to call native functions with unboxed parameters or results directly instead of via their boxed version");
+    register_unsigned_option(*ir::g_interpreter_jit_threshold, LEAN_DEFAULT_INTERPRETER_JIT_THRESHOLD, "(interpreter) number of calls after which an interpreted function is compiled with the LLVM JIT (0 = never); requires a build with LLVM support");
+    register_unsigned_option(*ir::g_interpreter_shared_constant_cache, LEAN_DEFAULT_INTERPRETER_SHARED_CONSTANT_CACHE, "(interpreter) maximal size in MiB of the values of constants shared by interpreters on all threads (0 = do not share)");
+    register_trace_class({"interpreter", "jit"});
     DEBUG_CODE({
         register_trace_class({"interpreter"});
         register_trace_class({"interpreter", "call"});
@@ -1193,12 +2538,36 @@ void initialize_ir_interpreter() {
     });
     ir::g_native_symbol_cache = new name_map<ir::native_symbol_cache_entry>();
     ir::g_native_symbol_cache_mutex = new std::shared_timed_mutex();
+    ir::g_imported_cache = new ir::imported_cache();
+    ir::g_imported_cache_mutex = new std::shared_timed_mutex();
+    ir::g_jit_cache = new ptr_hash_map<object, ir::native_symbol_cache_entry>();
+    ir::g_jit_mutex = new std::mutex();
+    ir::g_constant_cache = new ir::shared_constant_cache();
+    ir::g_constant_cache_mutex = new std::mutex();
+    ir::g_profiler = new ir::profiler_state();
 }
 
 void finalize_ir_interpreter() {
+    dec_ref(ir::lean_interpreter_profiler_stop(io_mk_world()));
+    delete ir::g_profiler;
+    for (auto const & p : *ir::g_jit_cache) {
+        dec_ref(p.first);
+    }
+    delete ir::g_jit_mutex;
+    delete ir::g_jit_cache;
+    ir::g_constant_cache->clear();
+    delete ir::g_constant_cache_mutex;
+    delete ir::g_constant_cache;
+    ir::g_imported_cache->reset(nullptr);
+    delete ir::g_imported_cache_mutex;
+    delete ir::g_imported_cache;
     delete ir::g_native_symbol_cache_mutex;
     delete ir::g_native_symbol_cache;
     delete ir::g_init_globals;
+    delete ir::g_interpreter_shared_constant_cache;
+    delete ir::g_interpreter_jit_threshold;
+    delete ir::g_interpreter_unboxed_calls;
+    delete ir::g_interpreter_bytecode;
     delete ir::g_interpreter_prefer_native;
     delete ir::g_boxed_mangled_suffix;
     delete ir::g_boxed_suffix;
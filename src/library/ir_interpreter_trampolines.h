@@ -0,0 +1,768 @@
+/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+// DO NOT EDIT, this is an automatically generated file
+// Generated using script: ../../script/gen_interpreter_trampolines.py
+// Included by `ir_interpreter.cpp` after the definition of `value`.
+#pragma once
+
+namespace lean {
+namespace ir {
+typedef value (*trampoline)(void * f, value const * args);
+
+/* Number of parameters up to which `get_trampoline` has an entry. */
+static constexpr unsigned g_max_trampoline_arity = 4;
+/* Number of calling convention classes: `0` (integers and pointers), `1` (`double`), `2` (`float`). */
+static constexpr unsigned g_num_trampoline_classes = 3;
+
+static value trampoline_i_v(void * f, value const * ) { return value(reinterpret_cast<uint64 (*)()>(f)()); } // NOLINT
+static value trampoline_i_i(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64)>(f)(args[0].m_num)); } // NOLINT
+static value trampoline_i_d(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double)>(f)(args[0].m_float)); } // NOLINT
+static value trampoline_i_f(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float)>(f)(args[0].m_float32)); } // NOLINT
+static value trampoline_i_ii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64)>(f)(args[0].m_num, args[1].m_num)); } // NOLINT
+static value trampoline_i_di(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64)>(f)(args[0].m_float, args[1].m_num)); } // NOLINT
+static value trampoline_i_fi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64)>(f)(args[0].m_float32, args[1].m_num)); } // NOLINT
+static value trampoline_i_id(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double)>(f)(args[0].m_num, args[1].m_float)); } // NOLINT
+static value trampoline_i_dd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double)>(f)(args[0].m_float, args[1].m_float)); } // NOLINT
+static value trampoline_i_fd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double)>(f)(args[0].m_float32, args[1].m_float)); } // NOLINT
+static value trampoline_i_if(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float)>(f)(args[0].m_num, args[1].m_float32)); } // NOLINT
+static value trampoline_i_df(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float)>(f)(args[0].m_float, args[1].m_float32)); } // NOLINT
+static value trampoline_i_ff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float)>(f)(args[0].m_float32, args[1].m_float32)); } // NOLINT
+static value trampoline_i_iii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_num)); } // NOLINT
+static value trampoline_i_dii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_num)); } // NOLINT
+static value trampoline_i_fii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num)); } // NOLINT
+static value trampoline_i_idi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_num)); } // NOLINT
+static value trampoline_i_ddi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_num)); } // NOLINT
+static value trampoline_i_fdi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num)); } // NOLINT
+static value trampoline_i_ifi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num)); } // NOLINT
+static value trampoline_i_dfi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num)); } // NOLINT
+static value trampoline_i_ffi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num)); } // NOLINT
+static value trampoline_i_iid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_float)); } // NOLINT
+static value trampoline_i_did(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_float)); } // NOLINT
+static value trampoline_i_fid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float)); } // NOLINT
+static value trampoline_i_idd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_float)); } // NOLINT
+static value trampoline_i_ddd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_float)); } // NOLINT
+static value trampoline_i_fdd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float)); } // NOLINT
+static value trampoline_i_ifd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float)); } // NOLINT
+static value trampoline_i_dfd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float)); } // NOLINT
+static value trampoline_i_ffd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float)); } // NOLINT
+static value trampoline_i_iif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32)); } // NOLINT
+static value trampoline_i_dif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32)); } // NOLINT
+static value trampoline_i_fif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32)); } // NOLINT
+static value trampoline_i_idf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32)); } // NOLINT
+static value trampoline_i_ddf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32)); } // NOLINT
+static value trampoline_i_fdf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32)); } // NOLINT
+static value trampoline_i_iff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32)); } // NOLINT
+static value trampoline_i_dff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32)); } // NOLINT
+static value trampoline_i_fff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32)); } // NOLINT
+static value trampoline_i_iiii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, uint64, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_i_diii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, uint64, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_i_fiii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, uint64, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_i_idii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, uint64, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_i_ddii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, uint64, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_i_fdii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, uint64, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_i_ifii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, uint64, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_i_dfii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, uint64, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_i_ffii(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, uint64, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_i_iidi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, double, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_i_didi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, double, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_i_fidi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, double, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_i_iddi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, double, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_i_dddi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, double, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_i_fddi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, double, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_i_ifdi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, double, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_i_dfdi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, double, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_i_ffdi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, double, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_i_iifi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, float, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_i_difi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, float, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_i_fifi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, float, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_i_idfi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, float, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_i_ddfi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, float, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_i_fdfi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, float, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_i_iffi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, float, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_i_dffi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, float, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_i_fffi(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, float, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_i_iiid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, uint64, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_i_diid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, uint64, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_i_fiid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, uint64, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_i_idid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, uint64, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_i_ddid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, uint64, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_i_fdid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, uint64, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_i_ifid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, uint64, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_i_dfid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, uint64, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_i_ffid(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, uint64, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_i_iidd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, double, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_i_didd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, double, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_i_fidd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, double, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_i_iddd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, double, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_i_dddd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, double, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_i_fddd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, double, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_i_ifdd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, double, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_i_dfdd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, double, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_i_ffdd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, double, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_i_iifd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, float, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_i_difd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, float, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_i_fifd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, float, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_i_idfd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, float, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_i_ddfd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, float, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_i_fdfd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, float, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_i_iffd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, float, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_i_dffd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, float, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_i_fffd(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, float, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_i_iiif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, uint64, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_i_diif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, uint64, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_i_fiif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, uint64, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_i_idif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, uint64, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_i_ddif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, uint64, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_i_fdif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, uint64, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_i_ifif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, uint64, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_i_dfif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, uint64, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_i_ffif(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, uint64, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_i_iidf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, double, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_i_didf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, double, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_i_fidf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, double, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_i_iddf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, double, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_i_dddf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, double, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_i_fddf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, double, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_i_ifdf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, double, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_i_dfdf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, double, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_i_ffdf(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, double, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_i_iiff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, uint64, float, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_i_diff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, uint64, float, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_i_fiff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, uint64, float, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_i_idff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, double, float, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_i_ddff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, double, float, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_i_fdff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, double, float, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_i_ifff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(uint64, float, float, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_i_dfff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(double, float, float, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_i_ffff(void * f, value const * args) { return value(reinterpret_cast<uint64 (*)(float, float, float, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_d_v(void * f, value const * ) { return value::from_float(reinterpret_cast<double (*)()>(f)()); } // NOLINT
+static value trampoline_d_i(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64)>(f)(args[0].m_num)); } // NOLINT
+static value trampoline_d_d(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double)>(f)(args[0].m_float)); } // NOLINT
+static value trampoline_d_f(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float)>(f)(args[0].m_float32)); } // NOLINT
+static value trampoline_d_ii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64)>(f)(args[0].m_num, args[1].m_num)); } // NOLINT
+static value trampoline_d_di(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64)>(f)(args[0].m_float, args[1].m_num)); } // NOLINT
+static value trampoline_d_fi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64)>(f)(args[0].m_float32, args[1].m_num)); } // NOLINT
+static value trampoline_d_id(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double)>(f)(args[0].m_num, args[1].m_float)); } // NOLINT
+static value trampoline_d_dd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double)>(f)(args[0].m_float, args[1].m_float)); } // NOLINT
+static value trampoline_d_fd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double)>(f)(args[0].m_float32, args[1].m_float)); } // NOLINT
+static value trampoline_d_if(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float)>(f)(args[0].m_num, args[1].m_float32)); } // NOLINT
+static value trampoline_d_df(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float)>(f)(args[0].m_float, args[1].m_float32)); } // NOLINT
+static value trampoline_d_ff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float)>(f)(args[0].m_float32, args[1].m_float32)); } // NOLINT
+static value trampoline_d_iii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_num)); } // NOLINT
+static value trampoline_d_dii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_num)); } // NOLINT
+static value trampoline_d_fii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num)); } // NOLINT
+static value trampoline_d_idi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_num)); } // NOLINT
+static value trampoline_d_ddi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_num)); } // NOLINT
+static value trampoline_d_fdi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num)); } // NOLINT
+static value trampoline_d_ifi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num)); } // NOLINT
+static value trampoline_d_dfi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num)); } // NOLINT
+static value trampoline_d_ffi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num)); } // NOLINT
+static value trampoline_d_iid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_float)); } // NOLINT
+static value trampoline_d_did(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_float)); } // NOLINT
+static value trampoline_d_fid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float)); } // NOLINT
+static value trampoline_d_idd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_float)); } // NOLINT
+static value trampoline_d_ddd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_float)); } // NOLINT
+static value trampoline_d_fdd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float)); } // NOLINT
+static value trampoline_d_ifd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float)); } // NOLINT
+static value trampoline_d_dfd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float)); } // NOLINT
+static value trampoline_d_ffd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float)); } // NOLINT
+static value trampoline_d_iif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32)); } // NOLINT
+static value trampoline_d_dif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32)); } // NOLINT
+static value trampoline_d_fif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32)); } // NOLINT
+static value trampoline_d_idf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32)); } // NOLINT
+static value trampoline_d_ddf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32)); } // NOLINT
+static value trampoline_d_fdf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32)); } // NOLINT
+static value trampoline_d_iff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32)); } // NOLINT
+static value trampoline_d_dff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32)); } // NOLINT
+static value trampoline_d_fff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32)); } // NOLINT
+static value trampoline_d_iiii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, uint64, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_d_diii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, uint64, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_d_fiii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, uint64, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_d_idii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, uint64, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_d_ddii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, uint64, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_d_fdii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, uint64, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_d_ifii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, uint64, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_d_dfii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, uint64, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_d_ffii(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, uint64, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_d_iidi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, double, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_d_didi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, double, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_d_fidi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, double, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_d_iddi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, double, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_d_dddi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, double, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_d_fddi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, double, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_d_ifdi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, double, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_d_dfdi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, double, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_d_ffdi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, double, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_d_iifi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, float, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_d_difi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, float, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_d_fifi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, float, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_d_idfi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, float, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_d_ddfi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, float, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_d_fdfi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, float, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_d_iffi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, float, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_d_dffi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, float, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_d_fffi(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, float, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_d_iiid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, uint64, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_d_diid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, uint64, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_d_fiid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, uint64, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_d_idid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, uint64, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_d_ddid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, uint64, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_d_fdid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, uint64, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_d_ifid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, uint64, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_d_dfid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, uint64, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_d_ffid(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, uint64, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_d_iidd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, double, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_d_didd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, double, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_d_fidd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, double, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_d_iddd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, double, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_d_dddd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, double, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_d_fddd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, double, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_d_ifdd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, double, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_d_dfdd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, double, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_d_ffdd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, double, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_d_iifd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, float, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_d_difd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, float, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_d_fifd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, float, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_d_idfd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, float, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_d_ddfd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, float, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_d_fdfd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, float, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_d_iffd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, float, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_d_dffd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, float, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_d_fffd(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, float, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_d_iiif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, uint64, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_d_diif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, uint64, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_d_fiif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, uint64, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_d_idif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, uint64, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_d_ddif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, uint64, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_d_fdif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, uint64, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_d_ifif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, uint64, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_d_dfif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, uint64, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_d_ffif(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, uint64, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_d_iidf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, double, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_d_didf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, double, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_d_fidf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, double, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_d_iddf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, double, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_d_dddf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, double, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_d_fddf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, double, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_d_ifdf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, double, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_d_dfdf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, double, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_d_ffdf(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, double, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_d_iiff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, uint64, float, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_d_diff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, uint64, float, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_d_fiff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, uint64, float, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_d_idff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, double, float, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_d_ddff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, double, float, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_d_fdff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, double, float, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_d_ifff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(uint64, float, float, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_d_dfff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(double, float, float, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_d_ffff(void * f, value const * args) { return value::from_float(reinterpret_cast<double (*)(float, float, float, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_f_v(void * f, value const * ) { return value::from_float32(reinterpret_cast<float (*)()>(f)()); } // NOLINT
+static value trampoline_f_i(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64)>(f)(args[0].m_num)); } // NOLINT
+static value trampoline_f_d(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double)>(f)(args[0].m_float)); } // NOLINT
+static value trampoline_f_f(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float)>(f)(args[0].m_float32)); } // NOLINT
+static value trampoline_f_ii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64)>(f)(args[0].m_num, args[1].m_num)); } // NOLINT
+static value trampoline_f_di(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64)>(f)(args[0].m_float, args[1].m_num)); } // NOLINT
+static value trampoline_f_fi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64)>(f)(args[0].m_float32, args[1].m_num)); } // NOLINT
+static value trampoline_f_id(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double)>(f)(args[0].m_num, args[1].m_float)); } // NOLINT
+static value trampoline_f_dd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double)>(f)(args[0].m_float, args[1].m_float)); } // NOLINT
+static value trampoline_f_fd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double)>(f)(args[0].m_float32, args[1].m_float)); } // NOLINT
+static value trampoline_f_if(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float)>(f)(args[0].m_num, args[1].m_float32)); } // NOLINT
+static value trampoline_f_df(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float)>(f)(args[0].m_float, args[1].m_float32)); } // NOLINT
+static value trampoline_f_ff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float)>(f)(args[0].m_float32, args[1].m_float32)); } // NOLINT
+static value trampoline_f_iii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_num)); } // NOLINT
+static value trampoline_f_dii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_num)); } // NOLINT
+static value trampoline_f_fii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num)); } // NOLINT
+static value trampoline_f_idi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_num)); } // NOLINT
+static value trampoline_f_ddi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_num)); } // NOLINT
+static value trampoline_f_fdi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num)); } // NOLINT
+static value trampoline_f_ifi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num)); } // NOLINT
+static value trampoline_f_dfi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num)); } // NOLINT
+static value trampoline_f_ffi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num)); } // NOLINT
+static value trampoline_f_iid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_float)); } // NOLINT
+static value trampoline_f_did(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_float)); } // NOLINT
+static value trampoline_f_fid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float)); } // NOLINT
+static value trampoline_f_idd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_float)); } // NOLINT
+static value trampoline_f_ddd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_float)); } // NOLINT
+static value trampoline_f_fdd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float)); } // NOLINT
+static value trampoline_f_ifd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float)); } // NOLINT
+static value trampoline_f_dfd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float)); } // NOLINT
+static value trampoline_f_ffd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float)); } // NOLINT
+static value trampoline_f_iif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32)); } // NOLINT
+static value trampoline_f_dif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32)); } // NOLINT
+static value trampoline_f_fif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32)); } // NOLINT
+static value trampoline_f_idf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32)); } // NOLINT
+static value trampoline_f_ddf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32)); } // NOLINT
+static value trampoline_f_fdf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32)); } // NOLINT
+static value trampoline_f_iff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32)); } // NOLINT
+static value trampoline_f_dff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32)); } // NOLINT
+static value trampoline_f_fff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32)); } // NOLINT
+static value trampoline_f_iiii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, uint64, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_f_diii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, uint64, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_f_fiii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, uint64, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_f_idii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, uint64, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_f_ddii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, uint64, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_f_fdii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, uint64, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_f_ifii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, uint64, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_f_dfii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, uint64, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_f_ffii(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, uint64, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num, args[3].m_num)); } // NOLINT
+static value trampoline_f_iidi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, double, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_f_didi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, double, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_f_fidi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, double, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_f_iddi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, double, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_f_dddi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, double, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_f_fddi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, double, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_f_ifdi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, double, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_f_dfdi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, double, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_f_ffdi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, double, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float, args[3].m_num)); } // NOLINT
+static value trampoline_f_iifi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, float, uint64)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_f_difi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, float, uint64)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_f_fifi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, float, uint64)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_f_idfi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, float, uint64)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_f_ddfi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, float, uint64)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_f_fdfi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, float, uint64)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_f_iffi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, float, uint64)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_f_dffi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, float, uint64)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_f_fffi(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, float, uint64)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32, args[3].m_num)); } // NOLINT
+static value trampoline_f_iiid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, uint64, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_f_diid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, uint64, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_f_fiid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, uint64, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_f_idid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, uint64, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_f_ddid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, uint64, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_f_fdid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, uint64, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_f_ifid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, uint64, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_f_dfid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, uint64, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_f_ffid(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, uint64, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num, args[3].m_float)); } // NOLINT
+static value trampoline_f_iidd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, double, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_f_didd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, double, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_f_fidd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, double, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_f_iddd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, double, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_f_dddd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, double, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_f_fddd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, double, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_f_ifdd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, double, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_f_dfdd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, double, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_f_ffdd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, double, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float, args[3].m_float)); } // NOLINT
+static value trampoline_f_iifd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, float, double)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_f_difd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, float, double)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_f_fifd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, float, double)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_f_idfd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, float, double)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_f_ddfd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, float, double)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_f_fdfd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, float, double)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_f_iffd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, float, double)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_f_dffd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, float, double)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_f_fffd(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, float, double)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32, args[3].m_float)); } // NOLINT
+static value trampoline_f_iiif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, uint64, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_f_diif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, uint64, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_f_fiif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, uint64, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_f_idif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, uint64, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_f_ddif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, uint64, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_f_fdif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, uint64, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_f_ifif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, uint64, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_f_dfif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, uint64, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_f_ffif(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, uint64, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_num, args[3].m_float32)); } // NOLINT
+static value trampoline_f_iidf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, double, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_f_didf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, double, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_f_fidf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, double, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_f_iddf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, double, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_f_dddf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, double, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_f_fddf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, double, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_f_ifdf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, double, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_f_dfdf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, double, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_f_ffdf(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, double, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float, args[3].m_float32)); } // NOLINT
+static value trampoline_f_iiff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, uint64, float, float)>(f)(args[0].m_num, args[1].m_num, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_f_diff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, uint64, float, float)>(f)(args[0].m_float, args[1].m_num, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_f_fiff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, uint64, float, float)>(f)(args[0].m_float32, args[1].m_num, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_f_idff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, double, float, float)>(f)(args[0].m_num, args[1].m_float, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_f_ddff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, double, float, float)>(f)(args[0].m_float, args[1].m_float, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_f_fdff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, double, float, float)>(f)(args[0].m_float32, args[1].m_float, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_f_ifff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(uint64, float, float, float)>(f)(args[0].m_num, args[1].m_float32, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_f_dfff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(double, float, float, float)>(f)(args[0].m_float, args[1].m_float32, args[2].m_float32, args[3].m_float32)); } // NOLINT
+static value trampoline_f_ffff(void * f, value const * args) { return value::from_float32(reinterpret_cast<float (*)(float, float, float, float)>(f)(args[0].m_float32, args[1].m_float32, args[2].m_float32, args[3].m_float32)); } // NOLINT
+
+/* Entries are ordered by return class, number of parameters, and then by the parameter classes read as a
+   number in base `g_num_trampoline_classes` with the first parameter as the least significant digit. */
+static trampoline const g_trampolines[] = {
+    trampoline_i_v,
+    trampoline_i_i,
+    trampoline_i_d,
+    trampoline_i_f,
+    trampoline_i_ii,
+    trampoline_i_di,
+    trampoline_i_fi,
+    trampoline_i_id,
+    trampoline_i_dd,
+    trampoline_i_fd,
+    trampoline_i_if,
+    trampoline_i_df,
+    trampoline_i_ff,
+    trampoline_i_iii,
+    trampoline_i_dii,
+    trampoline_i_fii,
+    trampoline_i_idi,
+    trampoline_i_ddi,
+    trampoline_i_fdi,
+    trampoline_i_ifi,
+    trampoline_i_dfi,
+    trampoline_i_ffi,
+    trampoline_i_iid,
+    trampoline_i_did,
+    trampoline_i_fid,
+    trampoline_i_idd,
+    trampoline_i_ddd,
+    trampoline_i_fdd,
+    trampoline_i_ifd,
+    trampoline_i_dfd,
+    trampoline_i_ffd,
+    trampoline_i_iif,
+    trampoline_i_dif,
+    trampoline_i_fif,
+    trampoline_i_idf,
+    trampoline_i_ddf,
+    trampoline_i_fdf,
+    trampoline_i_iff,
+    trampoline_i_dff,
+    trampoline_i_fff,
+    trampoline_i_iiii,
+    trampoline_i_diii,
+    trampoline_i_fiii,
+    trampoline_i_idii,
+    trampoline_i_ddii,
+    trampoline_i_fdii,
+    trampoline_i_ifii,
+    trampoline_i_dfii,
+    trampoline_i_ffii,
+    trampoline_i_iidi,
+    trampoline_i_didi,
+    trampoline_i_fidi,
+    trampoline_i_iddi,
+    trampoline_i_dddi,
+    trampoline_i_fddi,
+    trampoline_i_ifdi,
+    trampoline_i_dfdi,
+    trampoline_i_ffdi,
+    trampoline_i_iifi,
+    trampoline_i_difi,
+    trampoline_i_fifi,
+    trampoline_i_idfi,
+    trampoline_i_ddfi,
+    trampoline_i_fdfi,
+    trampoline_i_iffi,
+    trampoline_i_dffi,
+    trampoline_i_fffi,
+    trampoline_i_iiid,
+    trampoline_i_diid,
+    trampoline_i_fiid,
+    trampoline_i_idid,
+    trampoline_i_ddid,
+    trampoline_i_fdid,
+    trampoline_i_ifid,
+    trampoline_i_dfid,
+    trampoline_i_ffid,
+    trampoline_i_iidd,
+    trampoline_i_didd,
+    trampoline_i_fidd,
+    trampoline_i_iddd,
+    trampoline_i_dddd,
+    trampoline_i_fddd,
+    trampoline_i_ifdd,
+    trampoline_i_dfdd,
+    trampoline_i_ffdd,
+    trampoline_i_iifd,
+    trampoline_i_difd,
+    trampoline_i_fifd,
+    trampoline_i_idfd,
+    trampoline_i_ddfd,
+    trampoline_i_fdfd,
+    trampoline_i_iffd,
+    trampoline_i_dffd,
+    trampoline_i_fffd,
+    trampoline_i_iiif,
+    trampoline_i_diif,
+    trampoline_i_fiif,
+    trampoline_i_idif,
+    trampoline_i_ddif,
+    trampoline_i_fdif,
+    trampoline_i_ifif,
+    trampoline_i_dfif,
+    trampoline_i_ffif,
+    trampoline_i_iidf,
+    trampoline_i_didf,
+    trampoline_i_fidf,
+    trampoline_i_iddf,
+    trampoline_i_dddf,
+    trampoline_i_fddf,
+    trampoline_i_ifdf,
+    trampoline_i_dfdf,
+    trampoline_i_ffdf,
+    trampoline_i_iiff,
+    trampoline_i_diff,
+    trampoline_i_fiff,
+    trampoline_i_idff,
+    trampoline_i_ddff,
+    trampoline_i_fdff,
+    trampoline_i_ifff,
+    trampoline_i_dfff,
+    trampoline_i_ffff,
+    trampoline_d_v,
+    trampoline_d_i,
+    trampoline_d_d,
+    trampoline_d_f,
+    trampoline_d_ii,
+    trampoline_d_di,
+    trampoline_d_fi,
+    trampoline_d_id,
+    trampoline_d_dd,
+    trampoline_d_fd,
+    trampoline_d_if,
+    trampoline_d_df,
+    trampoline_d_ff,
+    trampoline_d_iii,
+    trampoline_d_dii,
+    trampoline_d_fii,
+    trampoline_d_idi,
+    trampoline_d_ddi,
+    trampoline_d_fdi,
+    trampoline_d_ifi,
+    trampoline_d_dfi,
+    trampoline_d_ffi,
+    trampoline_d_iid,
+    trampoline_d_did,
+    trampoline_d_fid,
+    trampoline_d_idd,
+    trampoline_d_ddd,
+    trampoline_d_fdd,
+    trampoline_d_ifd,
+    trampoline_d_dfd,
+    trampoline_d_ffd,
+    trampoline_d_iif,
+    trampoline_d_dif,
+    trampoline_d_fif,
+    trampoline_d_idf,
+    trampoline_d_ddf,
+    trampoline_d_fdf,
+    trampoline_d_iff,
+    trampoline_d_dff,
+    trampoline_d_fff,
+    trampoline_d_iiii,
+    trampoline_d_diii,
+    trampoline_d_fiii,
+    trampoline_d_idii,
+    trampoline_d_ddii,
+    trampoline_d_fdii,
+    trampoline_d_ifii,
+    trampoline_d_dfii,
+    trampoline_d_ffii,
+    trampoline_d_iidi,
+    trampoline_d_didi,
+    trampoline_d_fidi,
+    trampoline_d_iddi,
+    trampoline_d_dddi,
+    trampoline_d_fddi,
+    trampoline_d_ifdi,
+    trampoline_d_dfdi,
+    trampoline_d_ffdi,
+    trampoline_d_iifi,
+    trampoline_d_difi,
+    trampoline_d_fifi,
+    trampoline_d_idfi,
+    trampoline_d_ddfi,
+    trampoline_d_fdfi,
+    trampoline_d_iffi,
+    trampoline_d_dffi,
+    trampoline_d_fffi,
+    trampoline_d_iiid,
+    trampoline_d_diid,
+    trampoline_d_fiid,
+    trampoline_d_idid,
+    trampoline_d_ddid,
+    trampoline_d_fdid,
+    trampoline_d_ifid,
+    trampoline_d_dfid,
+    trampoline_d_ffid,
+    trampoline_d_iidd,
+    trampoline_d_didd,
+    trampoline_d_fidd,
+    trampoline_d_iddd,
+    trampoline_d_dddd,
+    trampoline_d_fddd,
+    trampoline_d_ifdd,
+    trampoline_d_dfdd,
+    trampoline_d_ffdd,
+    trampoline_d_iifd,
+    trampoline_d_difd,
+    trampoline_d_fifd,
+    trampoline_d_idfd,
+    trampoline_d_ddfd,
+    trampoline_d_fdfd,
+    trampoline_d_iffd,
+    trampoline_d_dffd,
+    trampoline_d_fffd,
+    trampoline_d_iiif,
+    trampoline_d_diif,
+    trampoline_d_fiif,
+    trampoline_d_idif,
+    trampoline_d_ddif,
+    trampoline_d_fdif,
+    trampoline_d_ifif,
+    trampoline_d_dfif,
+    trampoline_d_ffif,
+    trampoline_d_iidf,
+    trampoline_d_didf,
+    trampoline_d_fidf,
+    trampoline_d_iddf,
+    trampoline_d_dddf,
+    trampoline_d_fddf,
+    trampoline_d_ifdf,
+    trampoline_d_dfdf,
+    trampoline_d_ffdf,
+    trampoline_d_iiff,
+    trampoline_d_diff,
+    trampoline_d_fiff,
+    trampoline_d_idff,
+    trampoline_d_ddff,
+    trampoline_d_fdff,
+    trampoline_d_ifff,
+    trampoline_d_dfff,
+    trampoline_d_ffff,
+    trampoline_f_v,
+    trampoline_f_i,
+    trampoline_f_d,
+    trampoline_f_f,
+    trampoline_f_ii,
+    trampoline_f_di,
+    trampoline_f_fi,
+    trampoline_f_id,
+    trampoline_f_dd,
+    trampoline_f_fd,
+    trampoline_f_if,
+    trampoline_f_df,
+    trampoline_f_ff,
+    trampoline_f_iii,
+    trampoline_f_dii,
+    trampoline_f_fii,
+    trampoline_f_idi,
+    trampoline_f_ddi,
+    trampoline_f_fdi,
+    trampoline_f_ifi,
+    trampoline_f_dfi,
+    trampoline_f_ffi,
+    trampoline_f_iid,
+    trampoline_f_did,
+    trampoline_f_fid,
+    trampoline_f_idd,
+    trampoline_f_ddd,
+    trampoline_f_fdd,
+    trampoline_f_ifd,
+    trampoline_f_dfd,
+    trampoline_f_ffd,
+    trampoline_f_iif,
+    trampoline_f_dif,
+    trampoline_f_fif,
+    trampoline_f_idf,
+    trampoline_f_ddf,
+    trampoline_f_fdf,
+    trampoline_f_iff,
+    trampoline_f_dff,
+    trampoline_f_fff,
+    trampoline_f_iiii,
+    trampoline_f_diii,
+    trampoline_f_fiii,
+    trampoline_f_idii,
+    trampoline_f_ddii,
+    trampoline_f_fdii,
+    trampoline_f_ifii,
+    trampoline_f_dfii,
+    trampoline_f_ffii,
+    trampoline_f_iidi,
+    trampoline_f_didi,
+    trampoline_f_fidi,
+    trampoline_f_iddi,
+    trampoline_f_dddi,
+    trampoline_f_fddi,
+    trampoline_f_ifdi,
+    trampoline_f_dfdi,
+    trampoline_f_ffdi,
+    trampoline_f_iifi,
+    trampoline_f_difi,
+    trampoline_f_fifi,
+    trampoline_f_idfi,
+    trampoline_f_ddfi,
+    trampoline_f_fdfi,
+    trampoline_f_iffi,
+    trampoline_f_dffi,
+    trampoline_f_fffi,
+    trampoline_f_iiid,
+    trampoline_f_diid,
+    trampoline_f_fiid,
+    trampoline_f_idid,
+    trampoline_f_ddid,
+    trampoline_f_fdid,
+    trampoline_f_ifid,
+    trampoline_f_dfid,
+    trampoline_f_ffid,
+    trampoline_f_iidd,
+    trampoline_f_didd,
+    trampoline_f_fidd,
+    trampoline_f_iddd,
+    trampoline_f_dddd,
+    trampoline_f_fddd,
+    trampoline_f_ifdd,
+    trampoline_f_dfdd,
+    trampoline_f_ffdd,
+    trampoline_f_iifd,
+    trampoline_f_difd,
+    trampoline_f_fifd,
+    trampoline_f_idfd,
+    trampoline_f_ddfd,
+    trampoline_f_fdfd,
+    trampoline_f_iffd,
+    trampoline_f_dffd,
+    trampoline_f_fffd,
+    trampoline_f_iiif,
+    trampoline_f_diif,
+    trampoline_f_fiif,
+    trampoline_f_idif,
+    trampoline_f_ddif,
+    trampoline_f_fdif,
+    trampoline_f_ifif,
+    trampoline_f_dfif,
+    trampoline_f_ffif,
+    trampoline_f_iidf,
+    trampoline_f_didf,
+    trampoline_f_fidf,
+    trampoline_f_iddf,
+    trampoline_f_dddf,
+    trampoline_f_fddf,
+    trampoline_f_ifdf,
+    trampoline_f_dfdf,
+    trampoline_f_ffdf,
+    trampoline_f_iiff,
+    trampoline_f_diff,
+    trampoline_f_fiff,
+    trampoline_f_idff,
+    trampoline_f_ddff,
+    trampoline_f_fdff,
+    trampoline_f_ifff,
+    trampoline_f_dfff,
+    trampoline_f_ffff,
+};
+
+/* \brief Return the trampoline for a function with result class \c ret and parameter classes \c params. */
+static inline trampoline get_trampoline(unsigned ret, unsigned n, unsigned const * params) {
+    if (n > g_max_trampoline_arity)
+        return nullptr;
+    // signatures with fewer parameters come first
+    unsigned offset = 0, num_sigs = 0, k = 1;
+    for (unsigned i = 0; i <= g_max_trampoline_arity; i++, k *= g_num_trampoline_classes) {
+        if (i < n)
+            offset += k;
+        num_sigs += k;
+    }
+    unsigned idx = 0;
+    for (unsigned i = n; i > 0; i--)
+        idx = idx * g_num_trampoline_classes + params[i - 1];
+    return g_trampolines[ret * num_sigs + offset + idx];
+}
+}
+}
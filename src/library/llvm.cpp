@@ -12,6 +12,8 @@ Lean's IR.
 #include <lean/lean.h>
 
 #include <cassert>
+#include <mutex>
+#include <string>
 
 #include "runtime/array_ref.h"
 #include "runtime/debug.h"
@@ -22,7 +24,10 @@ Lean's IR.
 #include "llvm-c/BitReader.h"
 #include "llvm-c/BitWriter.h"
 #include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+#include "llvm-c/LLJIT.h"
 #include "llvm-c/Linker.h"
+#include "llvm-c/Orc.h"
 #include "llvm-c/Target.h"
 #include "llvm-c/TargetMachine.h"
 #include "llvm-c/Types.h"
@@ -251,6 +256,18 @@ extern "C" LEAN_EXPORT lean_object *lean_llvm_create_context(
 #endif  // LEAN_LLVM
 };
 
+extern "C" LEAN_EXPORT lean_object *lean_llvm_dispose_context(
+    size_t ctx, lean_object * /* w */) {
+#ifndef LEAN_LLVM
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with -DLLVM=ON to invoke "
+                  "the LLVM backend function."));
+#else
+    LLVMContextDispose(lean_to_Context(ctx));
+    return lean_io_result_mk_ok(lean_box(0));
+#endif  // LEAN_LLVM
+};
+
 extern "C" LEAN_EXPORT lean_object *lean_llvm_create_module(
     size_t ctx, lean_object *str, lean_object * /* w */) {
 #ifndef LEAN_LLVM
@@ -1513,3 +1530,99 @@ extern "C" LEAN_EXPORT lean_object *lean_llvm_position_builder_before(
     return lean_io_result_mk_ok(lean_box(0));
 #endif  // LEAN_LLVM
 }
+
+// == ORC JIT ==
+// A single LLJIT instance is shared by the whole process. It is used by the interpreter to compile hot functions, see
+// `Lean.IR.jitCompile`. All modules given to the JIT live in the context `g_jit_context`. The instance compiles on the
+// thread that looks up a symbol, so holding `g_jit_mutex` is sufficient to use the context.
+
+#ifdef LEAN_LLVM
+static std::mutex g_jit_mutex;
+static LLVMOrcLLJITRef g_jit = nullptr;
+static LLVMOrcThreadSafeContextRef g_jit_context = nullptr;
+static unsigned g_jit_num_modules = 0;
+
+static lean_object *jit_error(LLVMErrorRef err) {
+    char *msg = LLVMGetErrorMessage(err);
+    lean_object *r = lean_io_result_mk_error(lean_mk_io_user_error(lean_mk_string(msg)));
+    LLVMDisposeErrorMessage(msg);
+    return r;
+}
+
+static LLVMErrorRef jit_initialize() {
+    if (g_jit)
+        return nullptr;
+    LLVMInitializeNativeTarget();
+    LLVMInitializeNativeAsmPrinter();
+    if (LLVMErrorRef err = LLVMOrcCreateLLJIT(&g_jit, nullptr))
+        return err;
+    // resolve all symbols that are not defined by JIT modules in the current process
+    LLVMOrcDefinitionGeneratorRef gen;
+    if (LLVMErrorRef err = LLVMOrcCreateDynamicLibrarySearchGeneratorForProcess(
+            &gen, LLVMOrcLLJITGetGlobalPrefix(g_jit), nullptr, nullptr))
+        return err;
+    LLVMOrcJITDylibAddGenerator(LLVMOrcLLJITGetMainJITDylib(g_jit), gen);
+    g_jit_context = LLVMOrcCreateNewThreadSafeContext();
+    return nullptr;
+}
+#endif  // LEAN_LLVM
+
+/* jitAddModule (m : Module ctx) : IO String */
+extern "C" LEAN_EXPORT lean_object *lean_llvm_jit_add_module(size_t ctx, size_t mod,
+    lean_object * /* w */) {
+#ifndef LEAN_LLVM
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with -DLLVM=ON to invoke "
+                  "the LLVM backend function."));
+#else
+    std::lock_guard<std::mutex> lock(g_jit_mutex);
+    if (LLVMErrorRef err = jit_initialize())
+        return jit_error(err);
+    // Exported functions are renamed so that they do not clash with the ones of earlier modules, which may be
+    // different versions of the same declarations.
+    std::string suffix = ".jit" + std::to_string(g_jit_num_modules++);
+    for (LLVMValueRef fn = LLVMGetFirstFunction(lean_to_Module(mod)); fn; fn = LLVMGetNextFunction(fn)) {
+        if (!LLVMIsDeclaration(fn) && LLVMGetLinkage(fn) == LLVMExternalLinkage) {
+            size_t len;
+            std::string name(LLVMGetValueName2(fn, &len), len);
+            name += suffix;
+            LLVMSetValueName2(fn, name.data(), name.size());
+        }
+    }
+    // The JIT owns the modules it compiles, so we move a copy of `mod` to its context. The caller disposes of `mod`
+    // and its context.
+    LLVMMemoryBufferRef buf = LLVMWriteBitcodeToMemoryBuffer(lean_to_Module(mod));
+    LLVMModuleRef jit_mod;
+    LLVMBool broken = LLVMParseBitcodeInContext2(LLVMOrcThreadSafeContextGetContext(g_jit_context), buf, &jit_mod);
+    LLVMDisposeMemoryBuffer(buf);
+    if (broken) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(lean_mk_string("failed to load module into the JIT")));
+    }
+    // The module shares ownership of `g_jit_context` with the reference that we keep.
+    LLVMOrcThreadSafeModuleRef tsm = LLVMOrcCreateNewThreadSafeModule(jit_mod, g_jit_context);
+    if (LLVMErrorRef err = LLVMOrcLLJITAddLLVMIRModule(g_jit, LLVMOrcLLJITGetMainJITDylib(g_jit), tsm))
+        return jit_error(err);
+    return lean_io_result_mk_ok(lean_mk_string(suffix.c_str()));
+#endif  // LEAN_LLVM
+}
+
+/* jitLookup (name : @& String) : IO USize */
+extern "C" LEAN_EXPORT lean_object *lean_llvm_jit_lookup(b_lean_obj_arg name,
+    lean_object * /* w */) {
+#ifndef LEAN_LLVM
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with -DLLVM=ON to invoke "
+                  "the LLVM backend function."));
+#else
+    std::lock_guard<std::mutex> lock(g_jit_mutex);
+    if (LLVMErrorRef err = jit_initialize())
+        return jit_error(err);
+    LLVMOrcExecutorAddress addr = 0;
+    if (LLVMErrorRef err = LLVMOrcLLJITLookup(g_jit, &addr, lean_string_cstr(name))) {
+        // report missing symbols as `0`
+        LLVMConsumeError(err);
+        addr = 0;
+    }
+    return lean_io_result_mk_ok(lean_box_usize(static_cast<size_t>(addr)));
+#endif  // LEAN_LLVM
+}
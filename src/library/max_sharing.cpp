@@ -5,10 +5,10 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Leonardo de Moura
 */
 #include <tuple>
-#include <unordered_set>
 #include <functional>
 #include "runtime/interrupt.h"
 #include "runtime/buffer.h"
+#include "util/flat_hash_map.h"
 #include "library/max_sharing.h"
 
 namespace lean {
@@ -17,8 +17,8 @@ namespace lean {
    shared sub-expressions.
 */
 struct max_sharing_fn::imp {
-    typedef typename std::unordered_set<expr, expr_hash, is_bi_equal_proc> expr_cache;
-    typedef typename std::unordered_set<level, level_hash>                 level_cache;
+    typedef flat_hash_set<expr, expr_hash, is_bi_equal_proc> expr_cache;
+    typedef flat_hash_set<level, level_hash>                 level_cache;
     expr_cache  m_expr_cache;
     level_cache m_lvl_cache;
 
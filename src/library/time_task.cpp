@@ -12,6 +12,7 @@ Author: Sebastian Ullrich
 namespace lean {
 
 static std::map<std::string, second_duration> * g_cum_times;
+static std::map<std::string, uint64> * g_cum_counts;
 static mutex * g_cum_times_mutex;
 LEAN_THREAD_PTR(time_task, g_current_time_task);
 
@@ -22,18 +23,29 @@ void report_profiling_time(std::string const & category, second_duration time) {
     lock_guard<mutex> _(*g_cum_times_mutex);
     (*g_cum_times)[category] += time;
 }
+void report_profiling_count(std::string const & category, uint64 n) {
+    lock_guard<mutex> _(*g_cum_times_mutex);
+    (*g_cum_counts)[category] += n;
+}
 void exclude_profiling_time_from_current_task(second_duration time) {
     if (g_current_time_task)
         g_current_time_task->exclude_duration(time);
 }
 
 void display_cumulative_profiling_times(std::ostream & out) {
-    if (g_cum_times->empty())
+    if (g_cum_times->empty() && g_cum_counts->empty())
         return;
     sstream ss;
-    ss << "cumulative profiling times:\n";
-    for (auto const & p : *g_cum_times)
-        ss << "\t" << p.first << " " << display_profiling_time{p.second} << "\n";
+    if (!g_cum_times->empty()) {
+        ss << "cumulative profiling times:\n";
+        for (auto const & p : *g_cum_times)
+            ss << "\t" << p.first << " " << display_profiling_time{p.second} << "\n";
+    }
+    if (!g_cum_counts->empty()) {
+        ss << "cumulative profiling counts:\n";
+        for (auto const & p : *g_cum_counts)
+            ss << "\t" << p.first << " " << p.second << "\n";
+    }
     // output atomically, like IO.print
     out << ss.str();
 }
@@ -47,9 +59,11 @@ extern "C" LEAN_EXPORT obj_res lean_display_cumulative_profiling_times(obj_arg)
 void initialize_time_task() {
     g_cum_times_mutex = new mutex;
     g_cum_times = new std::map<std::string, second_duration>;
+    g_cum_counts = new std::map<std::string, uint64>;
 }
 
 void finalize_time_task() {
+    delete g_cum_counts;
     delete g_cum_times;
     delete g_cum_times_mutex;
 }
@@ -13,6 +13,8 @@ Author: Sebastian Ullrich
 namespace lean {
 LEAN_EXPORT bool has_no_block_profiling_task();
 LEAN_EXPORT void report_profiling_time(std::string const & category, second_duration time);
+/** Add `n` to the counter `category` of the final cumulative profile. */
+LEAN_EXPORT void report_profiling_count(std::string const & category, uint64 n);
 LEAN_EXPORT void display_cumulative_profiling_times(std::ostream & out);
 LEAN_EXPORT void exclude_profiling_time_from_current_task(second_duration time);
 
@@ -11,26 +11,46 @@ namespace lean {
 #define obj lean_object
 #define fx(i) lean_closure_arg_cptr(f)[i]
 
+static inline unsigned closure_byte_size(unsigned num_fixed) {
+    return sizeof(lean_closure_object) + sizeof(void*)*num_fixed;
+}
+
+/* Number of argument slots that `fix_args` reserves in new closures beyond the fixed arguments, so that further
+   partial applications of an exclusive closure can store their arguments in place. */
+static constexpr unsigned g_closure_reserve = 4;
+
 static obj* fix_args(obj* f, unsigned n, obj*const* as) {
     unsigned arity = lean_closure_arity(f);
     unsigned fixed = lean_closure_num_fixed(f);
     unsigned new_fixed = fixed + n;
     lean_assert(new_fixed < arity);
-    obj * r = lean_alloc_closure(lean_closure_fun(f), arity, new_fixed);
-    obj ** source = lean_closure_arg_cptr(f);
-    obj ** target = lean_closure_arg_cptr(r);
-    if (!lean_is_exclusive(f)) {
-      for (unsigned i = 0; i < fixed; i++, source++, target++) {
-          *target = *source;
-          lean_inc(*target);
-      }
-      lean_dec_ref(f);
+    obj * r;
+    obj ** target;
+    if (lean_is_exclusive(f) && lean_small_object_size(f) >= closure_byte_size(new_fixed)) {
+      r = f;
+      target = lean_closure_arg_cptr(r) + fixed;
     } else {
-      for (unsigned i = 0; i < fixed; i++, source++, target++) {
-          *target = *source;
+      unsigned capacity = arity - 1 < new_fixed + g_closure_reserve ? arity - 1 : new_fixed + g_closure_reserve;
+      r = lean_alloc_small_object(closure_byte_size(capacity));
+      lean_set_st_header(r, LeanClosure, 0);
+      lean_to_closure(r)->m_fun = lean_closure_fun(f);
+      lean_to_closure(r)->m_arity = arity;
+      obj ** source = lean_closure_arg_cptr(f);
+      target = lean_closure_arg_cptr(r);
+      if (!lean_is_exclusive(f)) {
+        for (unsigned i = 0; i < fixed; i++, source++, target++) {
+            *target = *source;
+            lean_inc(*target);
+        }
+        lean_dec_ref(f);
+      } else {
+        for (unsigned i = 0; i < fixed; i++, source++, target++) {
+            *target = *source;
+        }
+        lean_free_small_object(f);
       }
-      lean_free_small_object(f);
     }
+    lean_to_closure(r)->m_num_fixed = new_fixed;
     for (unsigned i = 0; i < n; i++, as++, target++) {
         *target = *as;
     }
@@ -96,7 +116,6 @@ case 16: return reinterpret_cast<fn16>(f)(as[0], as[1], as[2], as[3], as[4], as[
 default: return reinterpret_cast<fnn>(f)(as);
 }
 }
-static obj* curry(obj* f, unsigned n, obj** as) { return curry(lean_closure_fun(f), n, as); }
 extern "C" obj* lean_apply_n(obj*, unsigned, obj**);
 extern "C" LEAN_EXPORT obj* lean_apply_1(obj* f, obj* a1) {
 if (lean_is_scalar(f)) { lean_dec(a1); return f; } // f is an erased proof
@@ -208,13 +227,11 @@ if (arity == fixed + 2) {
     return r;
   }
 } else if (arity < fixed + 2) {
-  obj * as[2] = { a1, a2 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 2+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_1(lean_apply_1(f, a1), a2);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2});
 }
@@ -268,13 +285,12 @@ if (arity == fixed + 3) {
     return r;
   }
 } else if (arity < fixed + 3) {
-  obj * as[3] = { a1, a2, a3 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 3+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_2(lean_apply_1(f, a1), a2, a3);
+  case 2: return lean_apply_1(lean_apply_2(f, a1, a2), a3);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3});
 }
@@ -326,13 +342,13 @@ if (arity == fixed + 4) {
     return r;
   }
 } else if (arity < fixed + 4) {
-  obj * as[4] = { a1, a2, a3, a4 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 4+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_3(lean_apply_1(f, a1), a2, a3, a4);
+  case 2: return lean_apply_2(lean_apply_2(f, a1, a2), a3, a4);
+  case 3: return lean_apply_1(lean_apply_3(f, a1, a2, a3), a4);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4});
 }
@@ -382,13 +398,14 @@ if (arity == fixed + 5) {
     return r;
   }
 } else if (arity < fixed + 5) {
-  obj * as[5] = { a1, a2, a3, a4, a5 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 5+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_4(lean_apply_1(f, a1), a2, a3, a4, a5);
+  case 2: return lean_apply_3(lean_apply_2(f, a1, a2), a3, a4, a5);
+  case 3: return lean_apply_2(lean_apply_3(f, a1, a2, a3), a4, a5);
+  case 4: return lean_apply_1(lean_apply_4(f, a1, a2, a3, a4), a5);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5});
 }
@@ -436,13 +453,15 @@ if (arity == fixed + 6) {
     return r;
   }
 } else if (arity < fixed + 6) {
-  obj * as[6] = { a1, a2, a3, a4, a5, a6 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 6+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_5(lean_apply_1(f, a1), a2, a3, a4, a5, a6);
+  case 2: return lean_apply_4(lean_apply_2(f, a1, a2), a3, a4, a5, a6);
+  case 3: return lean_apply_3(lean_apply_3(f, a1, a2, a3), a4, a5, a6);
+  case 4: return lean_apply_2(lean_apply_4(f, a1, a2, a3, a4), a5, a6);
+  case 5: return lean_apply_1(lean_apply_5(f, a1, a2, a3, a4, a5), a6);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6});
 }
@@ -488,13 +507,16 @@ if (arity == fixed + 7) {
     return r;
   }
 } else if (arity < fixed + 7) {
-  obj * as[7] = { a1, a2, a3, a4, a5, a6, a7 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 7+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_6(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7);
+  case 2: return lean_apply_5(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7);
+  case 3: return lean_apply_4(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7);
+  case 4: return lean_apply_3(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7);
+  case 5: return lean_apply_2(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7);
+  case 6: return lean_apply_1(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7});
 }
@@ -538,13 +560,17 @@ if (arity == fixed + 8) {
     return r;
   }
 } else if (arity < fixed + 8) {
-  obj * as[8] = { a1, a2, a3, a4, a5, a6, a7, a8 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 8+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_7(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7, a8);
+  case 2: return lean_apply_6(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7, a8);
+  case 3: return lean_apply_5(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7, a8);
+  case 4: return lean_apply_4(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7, a8);
+  case 5: return lean_apply_3(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7, a8);
+  case 6: return lean_apply_2(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7, a8);
+  case 7: return lean_apply_1(lean_apply_7(f, a1, a2, a3, a4, a5, a6, a7), a8);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7, a8});
 }
@@ -586,13 +612,18 @@ if (arity == fixed + 9) {
     return r;
   }
 } else if (arity < fixed + 9) {
-  obj * as[9] = { a1, a2, a3, a4, a5, a6, a7, a8, a9 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 9+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_8(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7, a8, a9);
+  case 2: return lean_apply_7(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7, a8, a9);
+  case 3: return lean_apply_6(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7, a8, a9);
+  case 4: return lean_apply_5(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7, a8, a9);
+  case 5: return lean_apply_4(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7, a8, a9);
+  case 6: return lean_apply_3(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7, a8, a9);
+  case 7: return lean_apply_2(lean_apply_7(f, a1, a2, a3, a4, a5, a6, a7), a8, a9);
+  case 8: return lean_apply_1(lean_apply_8(f, a1, a2, a3, a4, a5, a6, a7, a8), a9);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7, a8, a9});
 }
@@ -632,13 +663,19 @@ if (arity == fixed + 10) {
     return r;
   }
 } else if (arity < fixed + 10) {
-  obj * as[10] = { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 10+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_9(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7, a8, a9, a10);
+  case 2: return lean_apply_8(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7, a8, a9, a10);
+  case 3: return lean_apply_7(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7, a8, a9, a10);
+  case 4: return lean_apply_6(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7, a8, a9, a10);
+  case 5: return lean_apply_5(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7, a8, a9, a10);
+  case 6: return lean_apply_4(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7, a8, a9, a10);
+  case 7: return lean_apply_3(lean_apply_7(f, a1, a2, a3, a4, a5, a6, a7), a8, a9, a10);
+  case 8: return lean_apply_2(lean_apply_8(f, a1, a2, a3, a4, a5, a6, a7, a8), a9, a10);
+  case 9: return lean_apply_1(lean_apply_9(f, a1, a2, a3, a4, a5, a6, a7, a8, a9), a10);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7, a8, a9, a10});
 }
@@ -676,13 +713,20 @@ if (arity == fixed + 11) {
     return r;
   }
 } else if (arity < fixed + 11) {
-  obj * as[11] = { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 11+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_10(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7, a8, a9, a10, a11);
+  case 2: return lean_apply_9(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7, a8, a9, a10, a11);
+  case 3: return lean_apply_8(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7, a8, a9, a10, a11);
+  case 4: return lean_apply_7(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7, a8, a9, a10, a11);
+  case 5: return lean_apply_6(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7, a8, a9, a10, a11);
+  case 6: return lean_apply_5(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7, a8, a9, a10, a11);
+  case 7: return lean_apply_4(lean_apply_7(f, a1, a2, a3, a4, a5, a6, a7), a8, a9, a10, a11);
+  case 8: return lean_apply_3(lean_apply_8(f, a1, a2, a3, a4, a5, a6, a7, a8), a9, a10, a11);
+  case 9: return lean_apply_2(lean_apply_9(f, a1, a2, a3, a4, a5, a6, a7, a8, a9), a10, a11);
+  case 10: return lean_apply_1(lean_apply_10(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10), a11);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11});
 }
@@ -718,13 +762,21 @@ if (arity == fixed + 12) {
     return r;
   }
 } else if (arity < fixed + 12) {
-  obj * as[12] = { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 12+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_11(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12);
+  case 2: return lean_apply_10(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7, a8, a9, a10, a11, a12);
+  case 3: return lean_apply_9(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7, a8, a9, a10, a11, a12);
+  case 4: return lean_apply_8(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7, a8, a9, a10, a11, a12);
+  case 5: return lean_apply_7(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7, a8, a9, a10, a11, a12);
+  case 6: return lean_apply_6(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7, a8, a9, a10, a11, a12);
+  case 7: return lean_apply_5(lean_apply_7(f, a1, a2, a3, a4, a5, a6, a7), a8, a9, a10, a11, a12);
+  case 8: return lean_apply_4(lean_apply_8(f, a1, a2, a3, a4, a5, a6, a7, a8), a9, a10, a11, a12);
+  case 9: return lean_apply_3(lean_apply_9(f, a1, a2, a3, a4, a5, a6, a7, a8, a9), a10, a11, a12);
+  case 10: return lean_apply_2(lean_apply_10(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10), a11, a12);
+  case 11: return lean_apply_1(lean_apply_11(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11), a12);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12});
 }
@@ -758,13 +810,22 @@ if (arity == fixed + 13) {
     return r;
   }
 } else if (arity < fixed + 13) {
-  obj * as[13] = { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 13+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_12(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13);
+  case 2: return lean_apply_11(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13);
+  case 3: return lean_apply_10(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7, a8, a9, a10, a11, a12, a13);
+  case 4: return lean_apply_9(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7, a8, a9, a10, a11, a12, a13);
+  case 5: return lean_apply_8(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7, a8, a9, a10, a11, a12, a13);
+  case 6: return lean_apply_7(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7, a8, a9, a10, a11, a12, a13);
+  case 7: return lean_apply_6(lean_apply_7(f, a1, a2, a3, a4, a5, a6, a7), a8, a9, a10, a11, a12, a13);
+  case 8: return lean_apply_5(lean_apply_8(f, a1, a2, a3, a4, a5, a6, a7, a8), a9, a10, a11, a12, a13);
+  case 9: return lean_apply_4(lean_apply_9(f, a1, a2, a3, a4, a5, a6, a7, a8, a9), a10, a11, a12, a13);
+  case 10: return lean_apply_3(lean_apply_10(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10), a11, a12, a13);
+  case 11: return lean_apply_2(lean_apply_11(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11), a12, a13);
+  case 12: return lean_apply_1(lean_apply_12(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12), a13);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13});
 }
@@ -796,13 +857,23 @@ if (arity == fixed + 14) {
     return r;
   }
 } else if (arity < fixed + 14) {
-  obj * as[14] = { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 14+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_13(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
+  case 2: return lean_apply_12(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
+  case 3: return lean_apply_11(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
+  case 4: return lean_apply_10(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
+  case 5: return lean_apply_9(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7, a8, a9, a10, a11, a12, a13, a14);
+  case 6: return lean_apply_8(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7, a8, a9, a10, a11, a12, a13, a14);
+  case 7: return lean_apply_7(lean_apply_7(f, a1, a2, a3, a4, a5, a6, a7), a8, a9, a10, a11, a12, a13, a14);
+  case 8: return lean_apply_6(lean_apply_8(f, a1, a2, a3, a4, a5, a6, a7, a8), a9, a10, a11, a12, a13, a14);
+  case 9: return lean_apply_5(lean_apply_9(f, a1, a2, a3, a4, a5, a6, a7, a8, a9), a10, a11, a12, a13, a14);
+  case 10: return lean_apply_4(lean_apply_10(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10), a11, a12, a13, a14);
+  case 11: return lean_apply_3(lean_apply_11(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11), a12, a13, a14);
+  case 12: return lean_apply_2(lean_apply_12(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12), a13, a14);
+  case 13: return lean_apply_1(lean_apply_13(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13), a14);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14});
 }
@@ -832,13 +903,24 @@ if (arity == fixed + 15) {
     return r;
   }
 } else if (arity < fixed + 15) {
-  obj * as[15] = { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 15+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_14(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
+  case 2: return lean_apply_13(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
+  case 3: return lean_apply_12(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
+  case 4: return lean_apply_11(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
+  case 5: return lean_apply_10(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
+  case 6: return lean_apply_9(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7, a8, a9, a10, a11, a12, a13, a14, a15);
+  case 7: return lean_apply_8(lean_apply_7(f, a1, a2, a3, a4, a5, a6, a7), a8, a9, a10, a11, a12, a13, a14, a15);
+  case 8: return lean_apply_7(lean_apply_8(f, a1, a2, a3, a4, a5, a6, a7, a8), a9, a10, a11, a12, a13, a14, a15);
+  case 9: return lean_apply_6(lean_apply_9(f, a1, a2, a3, a4, a5, a6, a7, a8, a9), a10, a11, a12, a13, a14, a15);
+  case 10: return lean_apply_5(lean_apply_10(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10), a11, a12, a13, a14, a15);
+  case 11: return lean_apply_4(lean_apply_11(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11), a12, a13, a14, a15);
+  case 12: return lean_apply_3(lean_apply_12(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12), a13, a14, a15);
+  case 13: return lean_apply_2(lean_apply_13(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13), a14, a15);
+  case 14: return lean_apply_1(lean_apply_14(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14), a15);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15});
 }
@@ -866,13 +948,25 @@ if (arity == fixed + 16) {
     return r;
   }
 } else if (arity < fixed + 16) {
-  obj * as[16] = { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16 };
-  obj ** args = static_cast<obj**>(LEAN_ALLOCA(arity*sizeof(obj*))); // NOLINT
-  for (unsigned i = 0; i < fixed; i++) { lean_inc(fx(i)); args[i] = fx(i); }
-  for (unsigned i = 0; i < arity-fixed; i++) args[fixed+i] = as[i];
-  obj * new_f = curry(f, arity, args);
-  lean_dec_ref(f);
-  return lean_apply_n(new_f, 16+fixed-arity, &as[arity-fixed]);
+  // saturate `f` and apply the result to the remaining arguments without building an argument array
+  switch (arity - fixed) {
+  case 1: return lean_apply_15(lean_apply_1(f, a1), a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
+  case 2: return lean_apply_14(lean_apply_2(f, a1, a2), a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
+  case 3: return lean_apply_13(lean_apply_3(f, a1, a2, a3), a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
+  case 4: return lean_apply_12(lean_apply_4(f, a1, a2, a3, a4), a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
+  case 5: return lean_apply_11(lean_apply_5(f, a1, a2, a3, a4, a5), a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
+  case 6: return lean_apply_10(lean_apply_6(f, a1, a2, a3, a4, a5, a6), a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
+  case 7: return lean_apply_9(lean_apply_7(f, a1, a2, a3, a4, a5, a6, a7), a8, a9, a10, a11, a12, a13, a14, a15, a16);
+  case 8: return lean_apply_8(lean_apply_8(f, a1, a2, a3, a4, a5, a6, a7, a8), a9, a10, a11, a12, a13, a14, a15, a16);
+  case 9: return lean_apply_7(lean_apply_9(f, a1, a2, a3, a4, a5, a6, a7, a8, a9), a10, a11, a12, a13, a14, a15, a16);
+  case 10: return lean_apply_6(lean_apply_10(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10), a11, a12, a13, a14, a15, a16);
+  case 11: return lean_apply_5(lean_apply_11(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11), a12, a13, a14, a15, a16);
+  case 12: return lean_apply_4(lean_apply_12(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12), a13, a14, a15, a16);
+  case 13: return lean_apply_3(lean_apply_13(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13), a14, a15, a16);
+  case 14: return lean_apply_2(lean_apply_14(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14), a15, a16);
+  case 15: return lean_apply_1(lean_apply_15(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15), a16);
+  default: lean_unreachable();
+  }
 } else {
   return fix_args(f, {a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16});
 }
@@ -14,6 +14,7 @@ Authors: Leonardo de Moura, Sebastian Ullrich
 #elif defined(__APPLE__)
 #include <mach-o/dyld.h>
 #include <unistd.h>
+#include <sys/mman.h>
 #else
 #if defined(LEAN_EMSCRIPTEN)
 #include <emscripten.h>
@@ -584,6 +585,46 @@ extern "C" LEAN_EXPORT obj_res lean_io_prim_handle_read(b_obj_arg h, usize nbyte
     }
 }
 
+/* Handle.readBinToEndInto : (@& Handle) → ByteArray → IO ByteArray */
+extern "C" LEAN_EXPORT obj_res lean_io_prim_handle_read_bin_to_end_into(b_obj_arg h, obj_arg buf, obj_arg /* w */) {
+    // Requests at least as large as the stdio buffer are passed directly to `read(2)` by `fread` instead of
+    // being copied through the buffer.
+    static constexpr usize min_chunk = 64 * 1024;
+    FILE * fp = io_get_handle(h);
+    while (true) {
+        usize sz = lean_sarray_size(buf);
+        usize avail = lean_is_exclusive(buf) ? lean_sarray_capacity(buf) - sz : 0;
+        usize n;
+        if (avail > 0) {
+            n = std::fread(lean_sarray_cptr(buf) + sz, 1, avail, fp);
+            lean_sarray_set_size(buf, sz + n);
+        } else {
+            // The buffer may already fit the whole input, e.g. when it was sized from the file's metadata, so
+            // probe for the end of the input before growing it.
+            uint8 probe[4096];
+            avail = sizeof(probe);
+            n = std::fread(probe, 1, avail, fp);
+            if (n > 0) {
+                // grow geometrically so that the total copying cost is linear
+                obj_res new_buf = lean_alloc_sarray(1, sz + n, std::max(2 * lean_sarray_capacity(buf), sz + n + min_chunk));
+                memcpy(lean_sarray_cptr(new_buf), lean_sarray_cptr(buf), sz);
+                memcpy(lean_sarray_cptr(new_buf) + sz, probe, n);
+                dec_ref(buf);
+                buf = new_buf;
+            }
+        }
+        if (n < avail) {
+            if (feof(fp)) {
+                clearerr(fp);
+                return io_result_mk_ok(buf);
+            } else if (ferror(fp)) {
+                dec_ref(buf);
+                return io_result_mk_error(decode_io_error(errno, nullptr));
+            }
+        }
+    }
+}
+
 /* Handle.write : (@& Handle) → (@& ByteArray) → IO Unit */
 extern "C" LEAN_EXPORT obj_res lean_io_prim_handle_write(b_obj_arg h, b_obj_arg buf, obj_arg /* w */) {
     FILE * fp = io_get_handle(h);
@@ -632,6 +673,174 @@ extern "C" LEAN_EXPORT obj_res lean_io_prim_handle_put_str(b_obj_arg h, b_obj_ar
     }
 }
 
+/* A buffered reader that splits the contents of a handle into lines, see `IO.FS.LineReader`. */
+struct line_reader {
+    object * m_handle;    // The handle the lines are read from.
+    mutex    m_mutex;     // Protects the fields below.
+    char *   m_buffer;
+    size_t   m_capacity;
+    size_t   m_begin;     // Start of the data that has not been returned yet.
+    size_t   m_end;       // End of the data that has been read from the handle.
+    bool     m_eof;       // Whether the last read has reached the end of the file.
+    bool     m_partial;   // Whether to return after partial reads, see `line_reader_fill`.
+};
+
+static lean_external_class * g_io_line_reader_external_class = nullptr;
+
+static void io_line_reader_finalizer(void * p) {
+    line_reader * r = static_cast<line_reader *>(p);
+    dec_ref(r->m_handle);
+    free(r->m_buffer);
+    delete r;
+}
+
+static void io_line_reader_foreach(void * p, b_obj_arg fn) {
+    line_reader * r = static_cast<line_reader *>(p);
+    inc_ref(fn);
+    lean_apply_1(fn, r->m_handle);
+}
+
+static line_reader * io_get_line_reader(b_obj_arg r) {
+    return static_cast<line_reader *>(lean_get_external_data(r));
+}
+
+/* Returns the number of bytes that stdio has read from the file descriptor of `fp` but not returned yet, or -1 if
+   this is not known on this platform. */
+static ptrdiff_t io_buffered_input(FILE * fp) {
+#if defined(__GLIBC__)
+    return fp->_IO_read_end - fp->_IO_read_ptr;
+#elif defined(__APPLE__)
+    return fp->_r;
+#else
+    return -1;
+#endif
+}
+
+/* LineReader.mk (h : Handle) (capacity : USize) : IO LineReader */
+extern "C" LEAN_EXPORT obj_res lean_io_line_reader_mk(obj_arg h, size_t capacity, obj_arg /* w */) {
+    line_reader * r = new line_reader;
+    r->m_handle   = h;
+    r->m_capacity = capacity < 4096 ? 4096 : capacity;
+    r->m_buffer   = static_cast<char *>(malloc(r->m_capacity));
+    r->m_begin    = 0;
+    r->m_end      = 0;
+    r->m_eof      = false;
+    r->m_partial  = false;
+#if !defined(LEAN_WINDOWS)
+    // Reads from regular files do not wait for more data, so they can always fill the whole buffer.
+    FILE * fp = io_get_handle(h);
+    struct stat st;
+    r->m_partial  = io_buffered_input(fp) >= 0 && fstat(fileno(fp), &st) == 0 && !S_ISREG(st.st_mode);
+#endif
+    return io_result_mk_ok(lean_alloc_external(g_io_line_reader_external_class, r));
+}
+
+/* Reads more data from the handle into the free space of the buffer and returns the number of bytes read, or -1 with
+   `errno` set on failure. On pipes, FIFOs, and terminals, `fread` would wait until the whole buffer is filled, which
+   delays lines until that much data has arrived. There, the bytes that stdio has already buffered are returned first,
+   and otherwise the file descriptor is read directly, which returns whatever data is available. */
+static ptrdiff_t line_reader_fill(line_reader & r, FILE * fp) {
+    char * dst = r.m_buffer + r.m_end;
+    size_t space = r.m_capacity - r.m_end;
+#if !defined(LEAN_WINDOWS)
+    if (r.m_partial) {
+        ptrdiff_t buffered = io_buffered_input(fp);
+        if (buffered > 0)
+            return std::fread(dst, 1, std::min(static_cast<size_t>(buffered), space), fp);
+        ssize_t n;
+        do {
+            n = read(fileno(fp), dst, space);
+        } while (n < 0 && errno == EINTR);
+        return n;
+    }
+#endif
+    size_t n = std::fread(dst, 1, space, fp);
+    if (n < space) {
+        if (std::ferror(fp)) {
+            clearerr(fp);
+            return -1;
+        }
+        clearerr(fp);
+    }
+    return n;
+}
+
+/* Stores the next line, without its line terminator, in `line`. Returns `false` at the end of the file, and sets
+   `err` if reading from the handle fails. Lines are found with `memchr` and each line is copied once, directly
+   into its string. */
+static bool line_reader_next(line_reader & r, object * & line, int & err) {
+    size_t scanned = 0;
+    while (true) {
+        char * begin = r.m_buffer + r.m_begin;
+        size_t avail = r.m_end - r.m_begin;
+        if (char * nl = static_cast<char *>(memchr(begin + scanned, '\n', avail - scanned))) {
+            size_t n = nl - begin;
+            r.m_begin += n + 1;
+            if (n > 0 && begin[n - 1] == '\r')
+                n--;
+            line = lean_mk_string_from_bytes(begin, n);
+            return true;
+        }
+        scanned = avail;
+        if (r.m_eof) {
+            // Later calls check for new data again.
+            r.m_eof = false;
+            if (avail == 0)
+                return false;
+            r.m_begin = r.m_end;
+            line = lean_mk_string_from_bytes(begin, avail);
+            return true;
+        }
+        if (r.m_begin > 0) {
+            memmove(r.m_buffer, begin, avail);
+            r.m_begin = 0;
+            r.m_end   = avail;
+        }
+        if (r.m_end == r.m_capacity) {
+            r.m_capacity *= 2;
+            r.m_buffer = static_cast<char *>(realloc(r.m_buffer, r.m_capacity));
+        }
+        size_t space = r.m_capacity - r.m_end;
+        ptrdiff_t n = line_reader_fill(r, io_get_handle(r.m_handle));
+        if (n < 0) {
+            err = errno;
+            return false;
+        }
+        r.m_end += n;
+        if (r.m_partial ? n == 0 : static_cast<size_t>(n) < space)
+            r.m_eof = true;
+    }
+}
+
+/* LineReader.readLine? (r : @& LineReader) : IO (Option String) */
+extern "C" LEAN_EXPORT obj_res lean_io_line_reader_read_line(b_obj_arg r, obj_arg /* w */) {
+    line_reader * lr = io_get_line_reader(r);
+    lock_guard<mutex> lock(lr->m_mutex);
+    object * line;
+    int err = 0;
+    if (line_reader_next(*lr, line, err))
+        return io_result_mk_ok(mk_option_some(line));
+    if (err != 0)
+        return io_result_mk_error(decode_io_error(err, nullptr));
+    return io_result_mk_ok(mk_option_none());
+}
+
+/* LineReader.readLines (r : @& LineReader) (max : USize) : IO (Array String) */
+extern "C" LEAN_EXPORT obj_res lean_io_line_reader_read_lines(b_obj_arg r, size_t max, obj_arg /* w */) {
+    line_reader * lr = io_get_line_reader(r);
+    lock_guard<mutex> lock(lr->m_mutex);
+    object * lines = array_mk_empty();
+    object * line;
+    int err = 0;
+    while (lean_array_size(lines) < max && line_reader_next(*lr, line, err))
+        lines = lean_array_push(lines, line);
+    if (err != 0) {
+        dec_ref(lines);
+        return io_result_mk_error(decode_io_error(err, nullptr));
+    }
+    return io_result_mk_ok(lines);
+}
+
 /* Std.Time.Timestamp.now : IO Timestamp */
 extern "C" LEAN_EXPORT obj_res lean_get_current_time(obj_arg /* w */) {
     using namespace std::chrono;
@@ -1101,6 +1310,148 @@ extern "C" LEAN_EXPORT obj_res lean_io_symlink_metadata(b_obj_arg fname, obj_arg
 #endif
 }
 
+/* A read-only memory mapping of a file, see `IO.FS.mmapFile`. Empty files are not mapped. */
+struct mapped_file {
+    uint8 * m_data;
+    size_t  m_size;
+};
+
+static lean_external_class * g_io_mapped_file_external_class = nullptr;
+
+static void io_mapped_file_finalizer(void * p) {
+    mapped_file * m = static_cast<mapped_file *>(p);
+    if (m->m_size > 0) {
+#if defined(LEAN_WINDOWS)
+        UnmapViewOfFile(m->m_data);
+#else
+        munmap(m->m_data, m->m_size);
+#endif
+    }
+    delete m;
+}
+
+static void io_mapped_file_foreach(void * /* mod */, b_obj_arg /* fn */) {
+}
+
+static mapped_file * io_get_mapped_file(b_obj_arg m) {
+    return static_cast<mapped_file *>(lean_get_external_data(m));
+}
+
+/* mmapFile (fn : @& FilePath) : IO MappedFile */
+extern "C" LEAN_EXPORT obj_res lean_io_mmap_file(b_obj_arg fname, obj_arg) {
+#ifdef LEAN_WINDOWS
+    int fd = open(string_cstr(fname), O_RDONLY | O_BINARY | O_NOINHERIT);
+#else
+    int fd = open(string_cstr(fname), O_RDONLY | O_CLOEXEC);
+#endif
+    if (fd == -1) {
+        return io_result_mk_error(decode_io_error(errno, fname));
+    }
+    size_t size = 0;
+    void * data = nullptr;
+#if defined(LEAN_WINDOWS)
+    HANDLE h = (HANDLE)_get_osfhandle(fd);
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(h, &file_size)) {
+        close(fd);
+        return io_result_mk_error((sstream() << "failed to get the size of '" << string_cstr(fname) << "': " << GetLastError()).str());
+    }
+    size = file_size.QuadPart;
+    if (size > 0) {
+        HANDLE h_map = CreateFileMapping(h, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (h_map != NULL) {
+            data = MapViewOfFile(h_map, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(h_map);
+        }
+        if (data == nullptr) {
+            close(fd);
+            return io_result_mk_error((sstream() << "failed to map '" << string_cstr(fname) << "': " << GetLastError()).str());
+        }
+    }
+#else
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int err = errno;
+        close(fd);
+        return io_result_mk_error(decode_io_error(err, fname));
+    }
+    size = st.st_size;
+    if (size > 0) {
+        data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            int err = errno;
+            close(fd);
+            return io_result_mk_error(decode_io_error(err, fname));
+        }
+    }
+#endif
+    // The mapping stays valid after the file is closed.
+    close(fd);
+    mapped_file * m = new mapped_file;
+    m->m_data = static_cast<uint8 *>(data);
+    m->m_size = size;
+    return io_result_mk_ok(lean_alloc_external(g_io_mapped_file_external_class, m));
+}
+
+/* MappedFile.size (m : @& MappedFile) : Nat */
+extern "C" LEAN_EXPORT obj_res lean_io_mapped_file_size(b_obj_arg m) {
+    return lean_usize_to_nat(io_get_mapped_file(m)->m_size);
+}
+
+/* MappedFile.uget (m : @& MappedFile) (i : USize) : UInt8 */
+extern "C" LEAN_EXPORT uint8 lean_io_mapped_file_uget(b_obj_arg m, size_t i) {
+    mapped_file * f = io_get_mapped_file(m);
+    return i < f->m_size ? f->m_data[i] : 0;
+}
+
+/* MappedFile.extract (m : @& MappedFile) (start stop : @& Nat) : ByteArray */
+extern "C" LEAN_EXPORT obj_res lean_io_mapped_file_extract(b_obj_arg m, b_obj_arg start, b_obj_arg stop) {
+    mapped_file * f = io_get_mapped_file(m);
+    size_t b = lean_is_scalar(start) && lean_unbox(start) < f->m_size ? lean_unbox(start) : f->m_size;
+    size_t e = lean_is_scalar(stop) && lean_unbox(stop) < f->m_size ? lean_unbox(stop) : f->m_size;
+    size_t sz = b < e ? e - b : 0;
+    obj_res r = lean_alloc_sarray(1, sz, sz);
+    if (sz > 0)
+        memcpy(lean_sarray_cptr(r), f->m_data + b, sz);
+    return r;
+}
+
+/* MappedFile.validateUTF8 (m : @& MappedFile) : Bool */
+extern "C" LEAN_EXPORT uint8 lean_io_mapped_file_validate_utf8(b_obj_arg m) {
+    mapped_file * f = io_get_mapped_file(m);
+    size_t pos = 0, i = 0;
+    return validate_utf8(f->m_data, f->m_size, pos, i);
+}
+
+/* MappedFile.toString? (m : @& MappedFile) : Option String */
+extern "C" LEAN_EXPORT obj_res lean_io_mapped_file_to_string(b_obj_arg m) {
+    mapped_file * f = io_get_mapped_file(m);
+    size_t pos = 0, i = 0;
+    if (!validate_utf8(f->m_data, f->m_size, pos, i))
+        return mk_option_none();
+    return mk_option_some(lean_mk_string_unchecked(reinterpret_cast<char const *>(f->m_data), f->m_size, i));
+}
+
+/* MappedFile.advise (m : @& MappedFile) (advice : Advice) : IO Unit */
+extern "C" LEAN_EXPORT obj_res lean_io_mapped_file_advise(b_obj_arg m, uint8 advice, obj_arg) {
+#ifndef LEAN_WINDOWS
+    mapped_file * f = io_get_mapped_file(m);
+    if (f->m_size == 0)
+        return io_result_mk_ok(box(0));
+    int a;
+    switch (advice) {
+    case 1: a = POSIX_MADV_SEQUENTIAL; break;  // sequential
+    case 2: a = POSIX_MADV_RANDOM; break;  // random
+    case 3: a = POSIX_MADV_WILLNEED; break;  // willNeed
+    default: a = POSIX_MADV_NORMAL; break;  // normal
+    }
+    if (int err = posix_madvise(f->m_data, f->m_size, a)) {
+        return io_result_mk_error(decode_io_error(err, nullptr));
+    }
+#endif
+    return io_result_mk_ok(box(0));
+}
+
 extern "C" LEAN_EXPORT obj_res lean_io_create_dir(b_obj_arg p, obj_arg) {
 #ifdef LEAN_WINDOWS
     if (mkdir(string_cstr(p)) == 0) {
@@ -1532,6 +1883,8 @@ void initialize_io() {
     g_io_error_nullptr_read = lean_mk_io_user_error(mk_ascii_string_unchecked("null reference read"));
     mark_persistent(g_io_error_nullptr_read);
     g_io_handle_external_class = lean_register_external_class(io_handle_finalizer, io_handle_foreach);
+    g_io_mapped_file_external_class = lean_register_external_class(io_mapped_file_finalizer, io_mapped_file_foreach);
+    g_io_line_reader_external_class = lean_register_external_class(io_line_reader_finalizer, io_line_reader_foreach);
 #if defined(LEAN_WINDOWS)
     _setmode(_fileno(stdout), _O_BINARY);
     _setmode(_fileno(stderr), _O_BINARY);
@@ -20,9 +20,13 @@ extern "C" void initialize_libuv() {
     initialize_libuv_timer();
     initialize_libuv_tcp_socket();
     initialize_libuv_udp_socket();
+    initialize_libuv_fs();
     initialize_libuv_loop();
 
-    lthread([]() { event_loop_run_loop(&global_ev); });
+    for (unsigned i = 0; i < event_loop_count(); i++) {
+        event_loop_t * ev = event_loop_get(i);
+        lthread([=]() { event_loop_run_loop(ev); });
+    }
 }
 
 extern "C" LEAN_EXPORT char ** lean_setup_args(int argc, char ** argv) {
@@ -0,0 +1,42 @@
+/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include "runtime/object.h"
+
+namespace lean {
+/* Registry of the execution counters of modules compiled with `compiler.pgo.generate`.
+   Modules register their counters from their initializers, and the counters are dumped once at process exit as lines
+   `<counter name> <count>`. Repeated runs append to the same file, `Lean.IR.PGOProfile.load` adds up their counts. */
+static std::mutex g_pgo_mutex;
+static lean_pgo_counters * g_pgo_modules = nullptr;
+
+static void dump_pgo_counters() {
+    std::lock_guard<std::mutex> lock(g_pgo_mutex);
+    char const * fname = std::getenv("LEAN_PGO_FILE");
+    if (!fname || !*fname)
+        fname = "default.leanprof";
+    FILE * out = std::fopen(fname, "a");
+    if (!out) {
+        std::fprintf(stderr, "failed to write profile-guided optimization counters to '%s'\n", fname);
+        return;
+    }
+    for (lean_pgo_counters * m = g_pgo_modules; m; m = m->m_next) {
+        for (size_t i = 0; i < m->m_size; i++) {
+            std::fprintf(out, "%s %llu\n", m->m_names[i], static_cast<unsigned long long>(m->m_counts[i]));
+        }
+    }
+    std::fclose(out);
+}
+
+extern "C" LEAN_EXPORT void lean_pgo_register(lean_pgo_counters * c) {
+    std::lock_guard<std::mutex> lock(g_pgo_mutex);
+    if (!g_pgo_modules)
+        std::atexit(dump_pgo_counters);
+    c->m_next     = g_pgo_modules;
+    g_pgo_modules = c;
+}
+}
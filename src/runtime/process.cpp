@@ -5,6 +5,9 @@ Released under Apache 2.0 license as described in the file LICENSE.
 Author: Jared Roesch
 */
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -25,6 +28,11 @@ Author: Jared Roesch
 #include <sys/wait.h>
 #include <signal.h>
 #include <limits.h> // NOLINT
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+// `posix_spawn_file_actions_addchdir_np` is available since glibc 2.29
+#include <spawn.h>
+#define LEAN_POSIX_SPAWN
+#endif
 #endif
 
 #ifdef __linux
@@ -434,6 +442,79 @@ static optional<pipe> setup_stdio(stdio cfg) {
 extern "C" char **environ;
 #endif
 
+#ifdef LEAN_POSIX_SPAWN
+/* Spawns the process with `posix_spawnp`, which does not copy the page tables of the parent process like `fork` does.
+   This matters for large, multithreaded processes such as `lake`. Returns `-1` if the process cannot be spawned this
+   way; the caller then falls back to `fork`, which also reports errors the way it always has. */
+static pid_t spawn_posix(string_ref const & proc_name, array_ref<string_ref> const & args, stdio stdin_mode, stdio stdout_mode,
+  stdio stderr_mode, optional<pipe> const & stdin_pipe, optional<pipe> const & stdout_pipe, optional<pipe> const & stderr_pipe,
+  option_ref<string_ref> const & cwd, array_ref<pair_ref<string_ref, option_ref<string_ref>>> const & env,
+  bool inherit_env, bool do_setsid) {
+    // `posix_spawnp` searches the `PATH` of the parent, while `execvp` in the child searches the modified environment.
+    if (!inherit_env)
+        return -1;
+    for (auto & entry : env) {
+        if (strcmp(entry.fst().data(), "PATH") == 0)
+            return -1;
+    }
+
+    std::vector<std::string> env_entries;
+    for (char ** e = environ; *e != nullptr; e++)
+        env_entries.push_back(*e);
+    for (auto & entry : env) {
+        std::string prefix = std::string(entry.fst().data()) + "=";
+        env_entries.erase(std::remove_if(env_entries.begin(), env_entries.end(), [&](std::string const & e) {
+            return e.compare(0, prefix.size(), prefix) == 0;
+        }), env_entries.end());
+        if (entry.snd())
+            env_entries.push_back(prefix + entry.snd().get()->data());
+    }
+    buffer<char *> envp;
+    for (auto & e : env_entries)
+        envp.push_back(const_cast<char *>(e.c_str()));
+    envp.push_back(nullptr);
+
+    buffer<char *> pargs;
+    pargs.push_back(const_cast<char *>(proc_name.data()));
+    for (auto & arg : args)
+        pargs.push_back(const_cast<char *>(arg.data()));
+    pargs.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawnattr_init(&attr);
+    // The other ends of the pipes are closed on `exec` since they were created with `O_CLOEXEC`.
+    if (stdin_pipe) {
+        posix_spawn_file_actions_adddup2(&actions, stdin_pipe->m_read_fd, STDIN_FILENO);
+    } else if (stdin_mode == stdio::NUL) {
+        posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    }
+    if (stdout_pipe) {
+        posix_spawn_file_actions_adddup2(&actions, stdout_pipe->m_write_fd, STDOUT_FILENO);
+    } else if (stdout_mode == stdio::NUL) {
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    }
+    if (stderr_pipe) {
+        posix_spawn_file_actions_adddup2(&actions, stderr_pipe->m_write_fd, STDERR_FILENO);
+    } else if (stderr_mode == stdio::NUL) {
+        posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    }
+    if (cwd) {
+        posix_spawn_file_actions_addchdir_np(&actions, cwd.get()->data());
+    }
+    if (do_setsid) {
+        posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID);
+    }
+
+    pid_t pid;
+    int err = posix_spawnp(&pid, pargs[0], &actions, &attr, pargs.data(), envp.data());
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    return err == 0 ? pid : -1;
+}
+#endif
+
 static obj_res spawn(string_ref const & proc_name, array_ref<string_ref> const & args, stdio stdin_mode, stdio stdout_mode,
   stdio stderr_mode, option_ref<string_ref> const & cwd, array_ref<pair_ref<string_ref, option_ref<string_ref>>> const & env,
   bool inherit_env, bool do_setsid) {
@@ -442,7 +523,14 @@ static obj_res spawn(string_ref const & proc_name, array_ref<string_ref> const &
     auto stdout_pipe = setup_stdio(stdout_mode);
     auto stderr_pipe = setup_stdio(stderr_mode);
 
+#ifdef LEAN_POSIX_SPAWN
+    int pid = spawn_posix(proc_name, args, stdin_mode, stdout_mode, stderr_mode, stdin_pipe, stdout_pipe, stderr_pipe,
+                          cwd, env, inherit_env, do_setsid);
+    if (pid == -1)
+        pid = fork();
+#else
     int pid = fork();
+#endif
 
     if (pid == 0) {
         if (!inherit_env) {
@@ -4,6 +4,9 @@ Released under Apache 2.0 license as described in the file LICENSE.
 
 Author: Sofia Rodrigues, Henrik Böving
 */
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
 #include "runtime/uv/event_loop.h"
 
 
@@ -15,6 +18,15 @@ thread. Once this notification arrives the event loop suspends its own execution
 that protects it. This mutex can then be taken by another thread that wants to work with the event
 loop. After that work is done it signals a condition variable that the event loop is waiting on
 to continue its execution.
+
+Handing the mutex back and forth is comparatively expensive, so operations that do not need to wait
+for the loop (e.g., sending and receiving on a TCP socket) are instead pushed onto a lock-free stack
+of jobs with `event_loop_submit`. The jobs are run by the loop thread in the `uv_async_t` callback,
+or by the next thread that locks the loop, in submission order.
+
+There may be several event loops, each run by its own thread, so that I/O is not limited to a single
+core. Every handle stays on the loop it was created on; `event_loop_next` distributes new handles
+round-robin over the loops.
 */
 
 namespace lean {
@@ -22,6 +34,8 @@ namespace lean {
 using namespace std;
 
 event_loop_t global_ev;
+static std::vector<event_loop_t *> * g_event_loops = nullptr;
+static std::atomic<unsigned> g_next_event_loop(0);
 
 // Helpers
 
@@ -42,9 +56,45 @@ static void check_uv(int result, const char * msg) {
     }
 }
 
-// The callback that stops the loop when it's called.
+// Counts `time_ns` in the bucket of `histogram` it falls into.
+static void event_loop_record(std::atomic<uint64_t> * histogram, uint64_t time_ns) {
+    unsigned bucket = 0;
+    for (uint64_t us = time_ns / 1000; us != 0 && bucket < EVENT_LOOP_HISTOGRAM_BUCKETS - 1; us >>= 1) {
+        bucket++;
+    }
+    histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+// Runs the jobs submitted to the event loop so far. The event loop must be locked.
+static void event_loop_drain(event_loop_t * event_loop) {
+    event_loop_job * jobs = event_loop->submissions.exchange(nullptr, std::memory_order_acquire);
+    if (jobs == nullptr) return;
+    uint64_t now = uv_hrtime();
+    // The stack contains the jobs in reverse submission order.
+    event_loop_job * fifo = nullptr;
+    while (jobs != nullptr) {
+        event_loop_job * next = jobs->next;
+        jobs->next = fifo;
+        fifo = jobs;
+        jobs = next;
+    }
+    while (fifo != nullptr) {
+        // `run` may free the job.
+        event_loop_job * next = fifo->next;
+        event_loop_record(event_loop->metrics.job_delays, now - std::min(now, fifo->queued_at));
+        event_loop->metrics.jobs.fetch_add(1, std::memory_order_relaxed);
+        fifo->run(fifo);
+        fifo = next;
+    }
+}
+
+// The callback that runs the submitted jobs and stops the loop if another thread is waiting for it.
 void async_callback(uv_async_t * handle) {
-    uv_stop(handle->loop);
+    event_loop_t * event_loop = (event_loop_t*)handle->loop->data;
+    event_loop_drain(event_loop);
+    if (event_loop->n_waiters != 0) {
+        uv_stop(handle->loop);
+    }
 }
 
 // Interrupts the event loop and stops it so it can receive future requests.
@@ -55,22 +105,34 @@ void event_loop_interrupt(event_loop_t * event_loop) {
 }
 
 // Initializes the event loop
-void event_loop_init(event_loop_t * event_loop) {
-    event_loop->loop = uv_default_loop();
+void event_loop_init(event_loop_t * event_loop, uv_loop_t * loop) {
+    event_loop->loop = loop;
+    event_loop->loop->data = event_loop;
     check_uv(uv_mutex_init_recursive(&event_loop->mutex), "Failed to initialize mutex");
     check_uv(uv_cond_init(&event_loop->cond_var), "Failed to initialize condition variable");
-    check_uv(uv_async_init(event_loop->loop, &event_loop->async, NULL), "Failed to initialize async");
+    check_uv(uv_async_init(event_loop->loop, &event_loop->async, async_callback), "Failed to initialize async");
     event_loop->n_waiters = 0;
+    event_loop->submissions = nullptr;
+    event_loop->metrics.iterations = 0;
+    event_loop->metrics.jobs = 0;
+    for (unsigned i = 0; i < EVENT_LOOP_HISTOGRAM_BUCKETS; i++) {
+        event_loop->metrics.lock_waits[i] = 0;
+        event_loop->metrics.job_delays[i] = 0;
+    }
 }
 
 // Locks the event loop for the side of the requesters.
 void event_loop_lock(event_loop_t * event_loop) {
     if (uv_mutex_trylock(&event_loop->mutex) != 0) {
+        uint64_t start = uv_hrtime();
         event_loop->n_waiters++;
         event_loop_interrupt(event_loop);
         uv_mutex_lock(&event_loop->mutex);
         event_loop->n_waiters--;
+        event_loop_record(event_loop->metrics.lock_waits, uv_hrtime() - start);
     }
+    // Jobs submitted before by this thread must run before whatever it is going to do with the loop.
+    event_loop_drain(event_loop);
 }
 
 // Unlock event loop
@@ -81,6 +143,38 @@ void event_loop_unlock(event_loop_t * event_loop) {
     uv_mutex_unlock(&event_loop->mutex);
 }
 
+// Runs `job` on the event loop, see the comment at the beginning of the file.
+void event_loop_submit(event_loop_t * event_loop, event_loop_job * job) {
+    if (uv_mutex_trylock(&event_loop->mutex) == 0) {
+        // The loop is not running (or we are on the loop thread): run the job right away.
+        event_loop_drain(event_loop);
+        event_loop->metrics.jobs.fetch_add(1, std::memory_order_relaxed);
+        job->run(job);
+        event_loop_unlock(event_loop);
+        return;
+    }
+    job->queued_at = uv_hrtime();
+    event_loop_job * head = event_loop->submissions.load(std::memory_order_relaxed);
+    do {
+        job->next = head;
+    } while (!event_loop->submissions.compare_exchange_weak(head, job, std::memory_order_release, std::memory_order_relaxed));
+    event_loop_interrupt(event_loop);
+}
+
+unsigned event_loop_count() {
+    return g_event_loops->size();
+}
+
+event_loop_t * event_loop_get(unsigned i) {
+    return (*g_event_loops)[i];
+}
+
+event_loop_t * event_loop_next() {
+    unsigned n = g_event_loops->size();
+    if (n == 1) return &global_ev;
+    return (*g_event_loops)[g_next_event_loop.fetch_add(1, std::memory_order_relaxed) % n];
+}
+
 // Runs the loop and stops when it needs to register new requests.
 void event_loop_run_loop(event_loop_t * event_loop) {
     while (uv_loop_alive(event_loop->loop)) {
@@ -90,6 +184,7 @@ void event_loop_run_loop(event_loop_t * event_loop) {
             uv_cond_wait(&event_loop->cond_var, &event_loop->mutex);
         }
 
+        event_loop->metrics.iterations.fetch_add(1, std::memory_order_relaxed);
         uv_run(event_loop->loop, UV_RUN_ONCE);
         /*
          * We leave `uv_run` only when `uv_stop` is called as there is always the `uv_async_t` so
@@ -106,36 +201,130 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_configure(b_obj_arg optio
     bool accum = lean_ctor_get_uint8(options, 0);
     bool block = lean_ctor_get_uint8(options, 1);
 
-    event_loop_lock(&global_ev);
+    for (event_loop_t * ev : *g_event_loops) {
+        event_loop_lock(ev);
 
-    if (accum) {
-        int result = uv_loop_configure(global_ev.loop, UV_METRICS_IDLE_TIME);
-        if (result != 0) return lean_io_result_mk_error(lean_decode_uv_error(result, NULL));
-    }
+        int result = 0;
+        if (accum) {
+            result = uv_loop_configure(ev->loop, UV_METRICS_IDLE_TIME);
+        }
+
+        #if!defined(WIN32) && !defined(_WIN32)
+        if (result == 0 && block) {
+            result = uv_loop_configure(ev->loop, UV_LOOP_BLOCK_SIGNAL, SIGPROF);
+        }
+        #endif
+
+        event_loop_unlock(ev);
 
-    #if!defined(WIN32) && !defined(_WIN32)
-    if (block) {
-        int result = uv_loop_configure(global_ev.loop, UV_LOOP_BLOCK_SIGNAL, SIGPROF);
         if (result != 0) return lean_io_result_mk_error(lean_decode_uv_error(result, NULL));
     }
-    #endif
-
-    event_loop_unlock(&global_ev);
 
     return lean_io_result_mk_ok(lean_box(0));
 }
 
 /* Std.Internal.UV.Loop.alive : BaseIO UInt64 */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_alive(obj_arg /* w */ ) {
-    event_loop_lock(&global_ev);
-    int is_alive = uv_loop_alive(global_ev.loop);
-    event_loop_unlock(&global_ev);
+    int is_alive = 0;
+    for (event_loop_t * ev : *g_event_loops) {
+        event_loop_lock(ev);
+        is_alive = is_alive || uv_loop_alive(ev->loop);
+        event_loop_unlock(ev);
+    }
 
     return lean_io_result_mk_ok(lean_box(is_alive));
 }
 
+/* Std.Internal.UV.Loop.count : BaseIO Nat */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_count(obj_arg /* w */ ) {
+    return lean_io_result_mk_ok(lean_usize_to_nat(g_event_loops->size()));
+}
+
+static lean_obj_res event_loop_histogram_to_array(std::atomic<uint64_t> const * histogram) {
+    lean_object * arr = lean_alloc_array(0, EVENT_LOOP_HISTOGRAM_BUCKETS);
+    for (unsigned i = 0; i < EVENT_LOOP_HISTOGRAM_BUCKETS; i++) {
+        arr = lean_array_push(arr, lean_box_uint64(histogram[i].load(std::memory_order_relaxed)));
+    }
+    return arr;
+}
+
+static lean_obj_res event_loop_metrics_of(event_loop_t * ev) {
+    uint64_t idle_time = 0;
+    uint64_t events = 0;
+    uint64_t active_requests;
+    // Number of active handles for each handle type, not counting the `uv_async_t` of the loop itself.
+    struct handle_counts {
+        uv_handle_t * async;
+        uint64_t      counts[UV_HANDLE_TYPE_MAX];
+    } handles = {};
+    handles.async = (uv_handle_t*)&ev->async;
+
+    event_loop_lock(ev);
+#if UV_VERSION_HEX >= ((1 << 16) | (39 << 8))
+    // Zero unless the loop was configured with `accumulateIdleTime`.
+    idle_time = uv_metrics_idle_time(ev->loop);
+#endif
+#if UV_VERSION_HEX >= ((1 << 16) | (45 << 8))
+    uv_metrics_t info;
+    if (uv_metrics_info(ev->loop, &info) == 0) {
+        events = info.events;
+    }
+#endif
+    active_requests = ev->loop->active_reqs.count;
+    uv_walk(ev->loop, [](uv_handle_t * handle, void * arg) {
+        handle_counts * handles = (handle_counts*)arg;
+        if (handle != handles->async && uv_is_active(handle)) {
+            handles->counts[uv_handle_get_type(handle)]++;
+        }
+    }, &handles);
+    event_loop_unlock(ev);
+
+    lean_object * active_handles = lean_alloc_array(0, 0);
+    for (int type = 0; type < UV_HANDLE_TYPE_MAX; type++) {
+        if (handles.counts[type] == 0) continue;
+        lean_object * pair = lean_alloc_ctor(0, 2, 0);
+        lean_ctor_set(pair, 0, lean_mk_string(uv_handle_type_name((uv_handle_type)type)));
+        lean_ctor_set(pair, 1, lean_uint64_to_nat(handles.counts[type]));
+        active_handles = lean_array_push(active_handles, pair);
+    }
+
+    lean_object * metrics = lean_alloc_ctor(0, 3, 5 * sizeof(uint64_t));
+    lean_ctor_set(metrics, 0, event_loop_histogram_to_array(ev->metrics.lock_waits));
+    lean_ctor_set(metrics, 1, event_loop_histogram_to_array(ev->metrics.job_delays));
+    lean_ctor_set(metrics, 2, active_handles);
+    size_t off = 3 * sizeof(void*);
+    lean_ctor_set_uint64(metrics, off + 0 * sizeof(uint64_t), ev->metrics.iterations.load(std::memory_order_relaxed));
+    lean_ctor_set_uint64(metrics, off + 1 * sizeof(uint64_t), events);
+    lean_ctor_set_uint64(metrics, off + 2 * sizeof(uint64_t), idle_time);
+    lean_ctor_set_uint64(metrics, off + 3 * sizeof(uint64_t), ev->metrics.jobs.load(std::memory_order_relaxed));
+    lean_ctor_set_uint64(metrics, off + 4 * sizeof(uint64_t), active_requests);
+    return metrics;
+}
+
+/* Std.Internal.UV.Loop.metrics : BaseIO (Array Loop.Metrics) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_metrics(obj_arg /* w */ ) {
+    lean_object * arr = lean_alloc_array(0, g_event_loops->size());
+    for (event_loop_t * ev : *g_event_loops) {
+        arr = lean_array_push(arr, event_loop_metrics_of(ev));
+    }
+    return lean_io_result_mk_ok(arr);
+}
+
 void initialize_libuv_loop() {
-    event_loop_init(&global_ev);
+    unsigned num_loops = 1;
+    if (char const * num = std::getenv("LEAN_NUM_UV_LOOPS")) {
+        num_loops = std::max(1, atoi(num));
+    }
+    g_event_loops = new std::vector<event_loop_t *>();
+    event_loop_init(&global_ev, uv_default_loop());
+    g_event_loops->push_back(&global_ev);
+    for (unsigned i = 1; i < num_loops; i++) {
+        uv_loop_t * loop = (uv_loop_t*)malloc(sizeof(uv_loop_t));
+        check_uv(uv_loop_init(loop), "Failed to initialize event loop");
+        event_loop_t * ev = new event_loop_t();
+        event_loop_init(ev, loop);
+        g_event_loops->push_back(ev);
+    }
 }
 
 #else
@@ -150,6 +339,16 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_alive(obj_arg /* w */ ) {
     return io_result_mk_error("lean_uv_event_loop_alive is not supported");
 }
 
+/* Std.Internal.UV.Loop.count : BaseIO Nat */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_count(obj_arg /* w */ ) {
+    return io_result_mk_error("lean_uv_event_loop_count is not supported");
+}
+
+/* Std.Internal.UV.Loop.metrics : BaseIO (Array Loop.Metrics) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_metrics(obj_arg /* w */ ) {
+    return io_result_mk_error("lean_uv_event_loop_metrics is not supported");
+}
+
 #endif
 
 }
\ No newline at end of file
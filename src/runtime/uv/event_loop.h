@@ -11,6 +11,7 @@ Author: Sofia Rodrigues
 
 #ifndef LEAN_EMSCRIPTEN
 #include <uv.h>
+#include <atomic>
 #endif
 
 namespace lean {
@@ -20,6 +21,26 @@ void initialize_libuv_loop();
 #ifndef LEAN_EMSCRIPTEN
 using namespace std;
 
+// Work submitted to an event loop from another thread, see `event_loop_submit`.
+typedef struct event_loop_job {
+    struct event_loop_job * next;                   // Next job in the submission queue.
+    void (*run)(struct event_loop_job * job);       // Runs the job; called with exclusive access to the loop.
+    uint64_t queued_at;                             // Time (`uv_hrtime`) at which the job was queued.
+} event_loop_job;
+
+// Number of buckets of the latency histograms in `event_loop_metrics`. Bucket 0 counts latencies below
+// 1µs, bucket `i` latencies in `[2^(i-1), 2^i)` µs, and the last bucket all longer latencies.
+#define EVENT_LOOP_HISTOGRAM_BUCKETS 24
+
+// Counters of an event loop, see `Std.Internal.UV.Loop.metrics`. They are updated with relaxed atomic
+// increments, so they can be read without locking the loop.
+typedef struct {
+    std::atomic<uint64_t> iterations;                               // Number of `uv_run` calls by the loop thread.
+    std::atomic<uint64_t> jobs;                                     // Number of jobs run, see `event_loop_submit`.
+    std::atomic<uint64_t> lock_waits[EVENT_LOOP_HISTOGRAM_BUCKETS]; // Waits of contended `event_loop_lock` calls.
+    std::atomic<uint64_t> job_delays[EVENT_LOOP_HISTOGRAM_BUCKETS]; // Delays between queueing and running jobs.
+} event_loop_metrics;
+
 // Event loop structure for managing asynchronous events and synchronization across multiple threads.
 typedef struct {
     uv_loop_t  * loop;      // The libuv event loop.
@@ -27,18 +48,37 @@ typedef struct {
     uv_cond_t    cond_var;  // Condition variable for signaling that `loop` is free.
     uv_async_t   async;     // Async handle to interrupt `loop`.
     _Atomic(int) n_waiters; // Atomic counter for managing waiters for `loop`.
+    std::atomic<event_loop_job *> submissions; // Lock-free stack of jobs that have not been run yet.
+    event_loop_metrics metrics; // Counters for diagnosing the event loop.
 } event_loop_t;
 
-// The multithreaded event loop object for all tasks in the task manager.
+// The multithreaded event loop object for all tasks in the task manager. It is the first of the event loops
+// below and the one used for requests that are not associated with a handle (e.g., DNS).
 extern event_loop_t global_ev;
 
 // =======================================
 // Event loop manipulation functions.
-void event_loop_init(event_loop_t *event_loop);
+void event_loop_init(event_loop_t *event_loop, uv_loop_t *loop);
 void event_loop_cleanup(event_loop_t *event_loop);
 void event_loop_lock(event_loop_t *event_loop);
 void event_loop_unlock(event_loop_t *event_loop);
 void event_loop_run_loop(event_loop_t *event_loop);
+// Runs `job` on `event_loop` without waiting for it: if the loop is busy, the job is queued and run by the loop
+// thread, or by the next thread that locks the loop, in submission order.
+void event_loop_submit(event_loop_t *event_loop, event_loop_job *job);
+
+// The event loops, each run by its own thread. Their number is taken from `LEAN_NUM_UV_LOOPS` (default: 1).
+unsigned event_loop_count();
+event_loop_t * event_loop_get(unsigned i);
+
+// Returns the event loop for a new handle. Handles are distributed round-robin over the event loops and stay on
+// their loop for their whole life.
+event_loop_t * event_loop_next();
+
+// Returns the event loop that `handle` belongs to.
+static inline event_loop_t * event_loop_of(void * handle) {
+    return (event_loop_t*)((uv_handle_t*)handle)->loop->data;
+}
 
 #endif
 
@@ -46,6 +86,8 @@ void event_loop_run_loop(event_loop_t *event_loop);
 // Global event loop manipulation functions
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_configure(b_obj_arg options, obj_arg /* w */ );
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_alive(obj_arg /* w */ );
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_count(obj_arg /* w */ );
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_event_loop_metrics(obj_arg /* w */ );
 
 // Helpers
 
@@ -0,0 +1,597 @@
+/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+#include "runtime/uv/fs.h"
+#include <cstring>
+
+namespace lean {
+
+#ifndef LEAN_EMSCRIPTEN
+
+// Stores all the things needed for a file system request. The request is started by the global event loop,
+// runs on the libuv thread pool, and its callback runs on the event loop thread again.
+typedef struct fs_request {
+    event_loop_job job;     // Must be the first field, the request is submitted to the global event loop.
+    uv_fs_t        req;
+    lean_object *  promise;
+    lean_object *  arg;     // The path or the file the request refers to.
+    lean_object *  data;    // The bytes that are read or written.
+    lean_uv_fs_file_object * file;  // The file whose requests in flight include this one, or nullptr.
+    uv_file        fd;
+    int            flags;   // Flags for opening the file.
+    int            status;  // The first error that occurred, or 0.
+    int64_t        offset;  // Offset in the file, or -1 for the current position.
+    size_t         done;    // Number of bytes read or written so far.
+} fs_request;
+
+void lean_uv_fs_file_finalizer(void* ptr) {
+    lean_uv_fs_file_object* file = (lean_uv_fs_file_object*)ptr;
+    uv_file fd = file->m_fd.load();
+
+    if (fd >= 0) {
+        // Without a callback, the request is performed synchronously and does not touch the loop.
+        uv_fs_t req;
+        uv_fs_close(global_ev.loop, &req, fd, nullptr);
+        uv_fs_req_cleanup(&req);
+    }
+
+    delete file;
+}
+
+void initialize_libuv_fs() {
+    g_uv_fs_file_external_class = lean_register_external_class(lean_uv_fs_file_finalizer, [](void* obj, lean_object* f) {});
+}
+
+static int fs_open_flags(uint8_t mode) {
+    // Keep in sync with `lean_io_prim_handle_mk`.
+    switch (mode) {
+    case 0: return UV_FS_O_RDONLY;  // read
+    case 1: return UV_FS_O_WRONLY | UV_FS_O_CREAT | UV_FS_O_TRUNC;  // write
+    case 2: return UV_FS_O_WRONLY | UV_FS_O_CREAT | UV_FS_O_TRUNC | UV_FS_O_EXCL;  // writeNew
+    case 3: return UV_FS_O_RDWR;  // readWrite
+    case 4: return UV_FS_O_WRONLY | UV_FS_O_CREAT | UV_FS_O_APPEND;  // append
+    default: return UV_FS_O_RDONLY;
+    }
+}
+
+// Creates a request for `arg` and returns it with the promise that is going to be returned to the caller.
+static fs_request * fs_request_new(b_obj_arg arg, void (*run)(event_loop_job *)) {
+    fs_request * r = (fs_request*)malloc(sizeof(fs_request));
+    r->job.run = run;
+    r->promise = lean_promise_new();
+    mark_mt(r->promise);
+    // The argument is released by the event loop thread.
+    mark_mt(arg);
+    lean_inc(arg);
+    r->arg = arg;
+    r->data = nullptr;
+    r->file = nullptr;
+    r->fd = -1;
+    r->flags = 0;
+    r->status = 0;
+    r->offset = -1;
+    r->done = 0;
+    r->req.data = r;
+    return r;
+}
+
+// Submits the request to the global event loop. Errors are reported through the promise, so we do not need to
+// wait for the event loop.
+static lean_obj_res fs_request_submit(fs_request * r) {
+    lean_object * promise = r->promise;
+    // One reference for the request, one for the caller.
+    lean_inc(promise);
+    event_loop_submit(&global_ev, &r->job);
+    return lean_io_result_mk_ok(promise);
+}
+
+static void fs_close_run(fs_request * r);
+
+// Resolves the promise of the request with `result` and frees the request.
+static void fs_request_finish(fs_request * r, lean_object * result) {
+    lean_promise_resolve(result, r->promise);
+    lean_dec(r->promise);
+    if (r->file != nullptr) {
+        // The last request in flight starts the close that was waiting for it.
+        lean_uv_fs_file_object * file = r->file;
+        if (--file->m_inflight == 0 && file->m_close != nullptr) {
+            fs_request * close = file->m_close;
+            file->m_close = nullptr;
+            fs_close_run(close);
+        }
+    }
+    lean_dec(r->arg);
+    if (r->data != nullptr) {
+        lean_dec(r->data);
+    }
+    free(r);
+}
+
+// Resolves the promise of the request with the error `status`, naming the path of the request if it has one.
+static void fs_request_fail(fs_request * r, int status) {
+    lean_object * fname = lean_is_string(r->arg) ? r->arg : nullptr;
+    fs_request_finish(r, mk_except_err(lean_decode_uv_error(status, fname)));
+}
+
+static uv_file fs_file_fd(b_obj_arg file) {
+    return lean_to_uv_fs_file(file)->m_fd.load();
+}
+
+// Called by the event loop thread before a request uses the file descriptor of its file. A request that
+// was submitted before the file was closed may still start after the close, in which case it fails instead of
+// using a file descriptor that may have been reused. Otherwise, the close waits for the request to finish.
+static bool fs_request_start(fs_request * r) {
+    lean_uv_fs_file_object * file = lean_to_uv_fs_file(r->arg);
+
+    if (file->m_closing) {
+        fs_request_fail(r, UV_EBADF);
+        return false;
+    }
+
+    file->m_inflight++;
+    r->file = file;
+    return true;
+}
+
+// =======================================
+// Metadata
+
+static obj_res fs_timespec_to_obj(uv_timespec_t const & ts) {
+    object * o = alloc_cnstr(0, 1, sizeof(uint32));
+    cnstr_set(o, 0, lean_int64_to_int(ts.tv_sec));
+    cnstr_set_uint32(o, sizeof(object *), ts.tv_nsec);
+    return o;
+}
+
+// Keep in sync with `metadata_core` in `io.cpp`.
+static obj_res fs_stat_to_metadata(uv_stat_t const & st) {
+    object * mdata = alloc_cnstr(0, 2, sizeof(uint64) + sizeof(uint8));
+    cnstr_set(mdata, 0, fs_timespec_to_obj(st.st_atim));
+    cnstr_set(mdata, 1, fs_timespec_to_obj(st.st_mtim));
+    cnstr_set_uint64(mdata, 2 * sizeof(object *), st.st_size);
+    uint64_t type = st.st_mode & S_IFMT;
+    cnstr_set_uint8(mdata, 2 * sizeof(object *) + sizeof(uint64),
+                    type == S_IFDIR ? 0 :
+                    type == S_IFREG ? 1 :
+                    type == S_IFLNK ? 2 :
+                    3);
+    return mdata;
+}
+
+// =======================================
+// File operations
+
+/* Std.Internal.UV.File.open (path : @& String) (mode : IO.FS.Mode) : IO (IO.Promise (Except IO.Error File)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_open(b_obj_arg path, uint8_t mode, obj_arg /* w */) {
+    fs_request * r = fs_request_new(path, [](event_loop_job * job) {
+        fs_request * r = (fs_request*)job;
+        int result = uv_fs_open(global_ev.loop, &r->req, lean_string_cstr(r->arg), r->flags, 0666, [](uv_fs_t * req) {
+            fs_request * r = (fs_request*)req->data;
+            ssize_t fd = req->result;
+            uv_fs_req_cleanup(req);
+
+            if (fd < 0) {
+                fs_request_fail(r, fd);
+                return;
+            }
+
+            lean_uv_fs_file_object * file = new lean_uv_fs_file_object;
+            file->m_fd = (uv_file)fd;
+            file->m_inflight = 0;
+            file->m_closing = false;
+            file->m_close = nullptr;
+            lean_object * obj = lean_uv_fs_file_new(file);
+            lean_mark_mt(obj);
+            fs_request_finish(r, mk_except_ok(obj));
+        });
+
+        if (result < 0) {
+            fs_request_fail(r, result);
+        }
+    });
+    r->flags = fs_open_flags(mode);
+    return fs_request_submit(r);
+}
+
+/* Std.Internal.UV.File.read (file : @& File) (size : UInt64) (offset : Int64) : IO (IO.Promise (Except IO.Error ByteArray)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_read(b_obj_arg file, uint64_t size, uint64_t offset, obj_arg /* w */) {
+    uv_file fd = fs_file_fd(file);
+
+    if (fd < 0) {
+        return lean_io_result_mk_error(lean_decode_uv_error(UV_EBADF, nullptr));
+    }
+
+    fs_request * r = fs_request_new(file, [](event_loop_job * job) {
+        fs_request * r = (fs_request*)job;
+        if (!fs_request_start(r)) return;
+        uv_buf_t buf = uv_buf_init((char*)lean_sarray_cptr(r->data), lean_sarray_capacity(r->data));
+        int result = uv_fs_read(global_ev.loop, &r->req, r->fd, &buf, 1, r->offset, [](uv_fs_t * req) {
+            fs_request * r = (fs_request*)req->data;
+            ssize_t nread = req->result;
+            uv_fs_req_cleanup(req);
+
+            if (nread < 0) {
+                fs_request_fail(r, nread);
+                return;
+            }
+
+            lean_object * data = r->data;
+            r->data = nullptr;
+            lean_sarray_set_size(data, nread);
+            fs_request_finish(r, mk_except_ok(data));
+        });
+
+        if (result < 0) {
+            fs_request_fail(r, result);
+        }
+    });
+    r->fd = fd;
+    r->offset = (int64_t)offset;
+    r->data = lean_alloc_sarray(1, 0, size);
+    return fs_request_submit(r);
+}
+
+static void fs_write_run(event_loop_job * job);
+
+static void fs_write_callback(uv_fs_t * req) {
+    fs_request * r = (fs_request*)req->data;
+    ssize_t nwritten = req->result;
+    uv_fs_req_cleanup(req);
+
+    if (nwritten < 0) {
+        fs_request_fail(r, nwritten);
+        return;
+    }
+
+    // Short writes are continued until all the data is written.
+    r->done += nwritten;
+    if (r->done < lean_sarray_size(r->data)) {
+        fs_write_run(&r->job);
+        return;
+    }
+
+    fs_request_finish(r, mk_except_ok(lean_box(0)));
+}
+
+static void fs_write_run(event_loop_job * job) {
+    fs_request * r = (fs_request*)job;
+    uv_buf_t buf = uv_buf_init((char*)lean_sarray_cptr(r->data) + r->done, lean_sarray_size(r->data) - r->done);
+    int64_t offset = r->offset < 0 ? -1 : r->offset + (int64_t)r->done;
+    int result = uv_fs_write(global_ev.loop, &r->req, r->fd, &buf, 1, offset, fs_write_callback);
+
+    if (result < 0) {
+        fs_request_fail(r, result);
+    }
+}
+
+static void fs_write_start(event_loop_job * job) {
+    fs_request * r = (fs_request*)job;
+    if (!fs_request_start(r)) return;
+    fs_write_run(job);
+}
+
+/* Std.Internal.UV.File.write (file : @& File) (data : ByteArray) (offset : Int64) : IO (IO.Promise (Except IO.Error Unit)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_write(b_obj_arg file, obj_arg data, uint64_t offset, obj_arg /* w */) {
+    uv_file fd = fs_file_fd(file);
+
+    if (fd < 0) {
+        lean_dec(data);
+        return lean_io_result_mk_error(lean_decode_uv_error(UV_EBADF, nullptr));
+    }
+
+    fs_request * r = fs_request_new(file, fs_write_start);
+    r->fd = fd;
+    r->offset = (int64_t)offset;
+    mark_mt(data);
+    r->data = data;
+    return fs_request_submit(r);
+}
+
+/* Std.Internal.UV.File.fsync (file : @& File) : IO (IO.Promise (Except IO.Error Unit)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_fsync(b_obj_arg file, obj_arg /* w */) {
+    uv_file fd = fs_file_fd(file);
+
+    if (fd < 0) {
+        return lean_io_result_mk_error(lean_decode_uv_error(UV_EBADF, nullptr));
+    }
+
+    fs_request * r = fs_request_new(file, [](event_loop_job * job) {
+        fs_request * r = (fs_request*)job;
+        if (!fs_request_start(r)) return;
+        int result = uv_fs_fsync(global_ev.loop, &r->req, r->fd, [](uv_fs_t * req) {
+            fs_request * r = (fs_request*)req->data;
+            ssize_t result = req->result;
+            uv_fs_req_cleanup(req);
+
+            if (result < 0) {
+                fs_request_fail(r, result);
+            } else {
+                fs_request_finish(r, mk_except_ok(lean_box(0)));
+            }
+        });
+
+        if (result < 0) {
+            fs_request_fail(r, result);
+        }
+    });
+    r->fd = fd;
+    return fs_request_submit(r);
+}
+
+static void fs_close_run(fs_request * r) {
+    int result = uv_fs_close(global_ev.loop, &r->req, r->fd, [](uv_fs_t * req) {
+        fs_request * r = (fs_request*)req->data;
+        ssize_t result = req->result;
+        uv_fs_req_cleanup(req);
+
+        if (result < 0) {
+            fs_request_fail(r, result);
+        } else {
+            fs_request_finish(r, mk_except_ok(lean_box(0)));
+        }
+    });
+
+    if (result < 0) {
+        fs_request_fail(r, result);
+    }
+}
+
+/* Std.Internal.UV.File.close (file : @& File) : IO (IO.Promise (Except IO.Error Unit)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_close(b_obj_arg file, obj_arg /* w */) {
+    // The file descriptor is taken right away, so that the file cannot be closed twice.
+    uv_file fd = lean_to_uv_fs_file(file)->m_fd.exchange(-1);
+
+    if (fd < 0) {
+        return lean_io_result_mk_error(lean_decode_uv_error(UV_EBADF, nullptr));
+    }
+
+    fs_request * r = fs_request_new(file, [](event_loop_job * job) {
+        fs_request * r = (fs_request*)job;
+        lean_uv_fs_file_object * file = lean_to_uv_fs_file(r->arg);
+        file->m_closing = true;
+
+        if (file->m_inflight > 0) {
+            // The last request in flight closes the file descriptor.
+            file->m_close = r;
+            return;
+        }
+
+        fs_close_run(r);
+    });
+    r->fd = fd;
+    return fs_request_submit(r);
+}
+
+// =======================================
+// Path operations
+
+/* Std.Internal.UV.File.metadata (path : @& String) : IO (IO.Promise (Except IO.Error IO.FS.Metadata)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_stat(b_obj_arg path, obj_arg /* w */) {
+    fs_request * r = fs_request_new(path, [](event_loop_job * job) {
+        fs_request * r = (fs_request*)job;
+        int result = uv_fs_stat(global_ev.loop, &r->req, lean_string_cstr(r->arg), [](uv_fs_t * req) {
+            fs_request * r = (fs_request*)req->data;
+
+            if (req->result < 0) {
+                ssize_t result = req->result;
+                uv_fs_req_cleanup(req);
+                fs_request_fail(r, result);
+                return;
+            }
+
+            lean_object * mdata = fs_stat_to_metadata(req->statbuf);
+            uv_fs_req_cleanup(req);
+            fs_request_finish(r, mk_except_ok(mdata));
+        });
+
+        if (result < 0) {
+            fs_request_fail(r, result);
+        }
+    });
+    return fs_request_submit(r);
+}
+
+/* Std.Internal.UV.File.readDir (path : @& String) : IO (IO.Promise (Except IO.Error (Array IO.FS.DirEntry))) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_read_dir(b_obj_arg path, obj_arg /* w */) {
+    fs_request * r = fs_request_new(path, [](event_loop_job * job) {
+        fs_request * r = (fs_request*)job;
+        int result = uv_fs_scandir(global_ev.loop, &r->req, lean_string_cstr(r->arg), 0, [](uv_fs_t * req) {
+            fs_request * r = (fs_request*)req->data;
+
+            if (req->result < 0) {
+                ssize_t result = req->result;
+                uv_fs_req_cleanup(req);
+                fs_request_fail(r, result);
+                return;
+            }
+
+            // `uv_fs_scandir` already omits `.` and `..`.
+            lean_object * arr = lean_alloc_array(0, req->result);
+            uv_dirent_t entry;
+            while (uv_fs_scandir_next(req, &entry) != UV_EOF) {
+                lean_object * lentry = lean_alloc_ctor(0, 2, 0);
+                lean_inc(r->arg);
+                lean_ctor_set(lentry, 0, r->arg);
+                lean_ctor_set(lentry, 1, lean_mk_string(entry.name));
+                arr = lean_array_push(arr, lentry);
+            }
+
+            uv_fs_req_cleanup(req);
+            fs_request_finish(r, mk_except_ok(arr));
+        });
+
+        if (result < 0) {
+            fs_request_fail(r, result);
+        }
+    });
+    return fs_request_submit(r);
+}
+
+// `lean_uv_fs_read_file` chains the requests below, each one is started by the callback of the previous one.
+static void fs_read_file_open(event_loop_job * job);
+static void fs_read_file_stat(uv_fs_t * req);
+static void fs_read_file_read(uv_fs_t * req);
+static void fs_read_file_close(uv_fs_t * req);
+
+// Closes the file after reading it or after an error, `r->status` is reported once the file is closed.
+static void fs_read_file_finish(fs_request * r) {
+    int result = uv_fs_close(global_ev.loop, &r->req, r->fd, fs_read_file_close);
+
+    if (result < 0) {
+        fs_read_file_close(&r->req);
+    }
+}
+
+static void fs_read_file_close(uv_fs_t * req) {
+    fs_request * r = (fs_request*)req->data;
+    uv_fs_req_cleanup(req);
+
+    if (r->status < 0) {
+        fs_request_fail(r, r->status);
+        return;
+    }
+
+    lean_object * data = r->data;
+    r->data = nullptr;
+    lean_sarray_set_size(data, r->done);
+    fs_request_finish(r, mk_except_ok(data));
+}
+
+// Reads into the remaining capacity of `r->data`, growing it if it is full, since the file may have grown since
+// we have looked at its size.
+static void fs_read_file_next(fs_request * r) {
+    size_t capacity = lean_sarray_capacity(r->data);
+
+    if (r->done == capacity) {
+        capacity = capacity < 4096 ? 4096 : 2 * capacity;
+        lean_object * data = lean_alloc_sarray(1, 0, capacity);
+        memcpy(lean_sarray_cptr(data), lean_sarray_cptr(r->data), r->done);
+        lean_dec(r->data);
+        r->data = data;
+    }
+
+    uv_buf_t buf = uv_buf_init((char*)lean_sarray_cptr(r->data) + r->done, capacity - r->done);
+    int result = uv_fs_read(global_ev.loop, &r->req, r->fd, &buf, 1, r->done, fs_read_file_read);
+
+    if (result < 0) {
+        r->status = result;
+        fs_read_file_finish(r);
+    }
+}
+
+static void fs_read_file_read(uv_fs_t * req) {
+    fs_request * r = (fs_request*)req->data;
+    ssize_t nread = req->result;
+    uv_fs_req_cleanup(req);
+
+    if (nread <= 0) {
+        r->status = nread < 0 ? nread : 0;
+        fs_read_file_finish(r);
+        return;
+    }
+
+    r->done += nread;
+    fs_read_file_next(r);
+}
+
+static void fs_read_file_stat(uv_fs_t * req) {
+    fs_request * r = (fs_request*)req->data;
+    ssize_t result = req->result;
+    // One more byte than the size of the file lets us observe the end of the file with the first read.
+    size_t size = result < 0 ? 0 : req->statbuf.st_size + 1;
+    uv_fs_req_cleanup(req);
+
+    if (result < 0) {
+        r->status = result;
+        fs_read_file_finish(r);
+        return;
+    }
+
+    r->data = lean_alloc_sarray(1, 0, size);
+    fs_read_file_next(r);
+}
+
+static void fs_read_file_open(event_loop_job * job) {
+    fs_request * r = (fs_request*)job;
+    int result = uv_fs_open(global_ev.loop, &r->req, lean_string_cstr(r->arg), UV_FS_O_RDONLY, 0, [](uv_fs_t * req) {
+        fs_request * r = (fs_request*)req->data;
+        ssize_t fd = req->result;
+        uv_fs_req_cleanup(req);
+
+        if (fd < 0) {
+            fs_request_fail(r, fd);
+            return;
+        }
+
+        r->fd = (uv_file)fd;
+        int result = uv_fs_fstat(global_ev.loop, &r->req, r->fd, fs_read_file_stat);
+
+        if (result < 0) {
+            r->status = result;
+            fs_read_file_finish(r);
+        }
+    });
+
+    if (result < 0) {
+        fs_request_fail(r, result);
+    }
+}
+
+/* Std.Internal.UV.File.readFile (path : @& String) : IO (IO.Promise (Except IO.Error ByteArray)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_read_file(b_obj_arg path, obj_arg /* w */) {
+    return fs_request_submit(fs_request_new(path, fs_read_file_open));
+}
+
+#else
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_open(b_obj_arg path, uint8_t mode, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_read(b_obj_arg file, uint64_t size, uint64_t offset, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_write(b_obj_arg file, obj_arg data, uint64_t offset, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_fsync(b_obj_arg file, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_close(b_obj_arg file, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_stat(b_obj_arg path, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_read_dir(b_obj_arg path, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_read_file(b_obj_arg path, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+#endif
+}
@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+#pragma once
+#include <lean/lean.h>
+#include "runtime/uv/event_loop.h"
+
+#ifndef LEAN_EMSCRIPTEN
+#include <uv.h>
+#include <atomic>
+#endif
+
+namespace lean {
+
+static lean_external_class * g_uv_fs_file_external_class = NULL;
+void initialize_libuv_fs();
+
+#ifndef LEAN_EMSCRIPTEN
+using namespace std;
+
+struct fs_request;
+
+// Structure for managing a file opened by `lean_uv_fs_open`. The file system requests themselves run on the
+// libuv thread pool, so that they do not block the threads of the task manager.
+typedef struct {
+    std::atomic<uv_file> m_fd;  // The file descriptor, or -1 once the file has been closed.
+    // The following fields are only accessed by the event loop thread.
+    unsigned     m_inflight;    // Number of requests using the file descriptor that have not finished yet.
+    bool         m_closing;     // Whether the close request has started, later requests fail with `EBADF`.
+    fs_request * m_close;       // The close request waiting for the requests in flight, or nullptr.
+} lean_uv_fs_file_object;
+
+// =======================================
+// File object manipulation functions.
+static inline lean_object* lean_uv_fs_file_new(lean_uv_fs_file_object * s) { return lean_alloc_external(g_uv_fs_file_external_class, s); }
+static inline lean_uv_fs_file_object* lean_to_uv_fs_file(lean_object * o) { return (lean_uv_fs_file_object*)(lean_get_external_data(o)); }
+
+#endif
+
+// =======================================
+// File system operations
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_open(b_obj_arg path, uint8_t mode, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_read(b_obj_arg file, uint64_t size, uint64_t offset, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_write(b_obj_arg file, obj_arg data, uint64_t offset, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_fsync(b_obj_arg file, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_close(b_obj_arg file, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_stat(b_obj_arg path, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_read_dir(b_obj_arg path, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_fs_read_file(b_obj_arg path, obj_arg /* w */);
+
+}
@@ -0,0 +1,229 @@
+/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+#include "runtime/uv/process.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace lean {
+
+#ifndef LEAN_EMSCRIPTEN
+
+using namespace std;
+
+// Stores all the things needed to run a process to completion and capture its output. All handles live on the
+// same event loop, so a single loop thread can supervise many processes.
+typedef struct process_output_data {
+    event_loop_job job;          // Must be the first field, the process is spawned by its event loop.
+    event_loop_t * ev;
+    uv_process_t   process;
+    uv_pipe_t      pipes[2];     // The standard output and error of the process.
+    lean_object *  promise;
+    lean_object *  args;         // The `IO.Process.SpawnArgs`.
+    std::string    output[2];    // What has been read from `pipes`.
+    char           buffer[64 * 1024];
+    uint32_t       exit_code;
+    int            status;       // The first error that occurred, or 0.
+    int            open_handles; // Number of handles that have not been closed yet.
+} process_output_data;
+
+static void process_output_finish(process_output_data * d) {
+    lean_object * result;
+    if (d->status < 0) {
+        // Errors such as a missing executable are reported for the command.
+        lean_object * cmd = lean_ctor_get(d->args, 1);
+        result = mk_except_err(lean_decode_uv_error(d->status, cmd));
+    } else {
+        lean_object * outputs = lean_alloc_ctor(0, 2, 0);
+        for (unsigned i = 0; i < 2; i++) {
+            size_t size = d->output[i].size();
+            lean_object * bytes = lean_alloc_sarray(1, size, size);
+            memcpy(lean_sarray_cptr(bytes), d->output[i].data(), size);
+            lean_ctor_set(outputs, i, bytes);
+        }
+        lean_object * r = lean_alloc_ctor(0, 2, 0);
+        lean_ctor_set(r, 0, lean_box_uint32(d->exit_code));
+        lean_ctor_set(r, 1, outputs);
+        result = mk_except_ok(r);
+    }
+
+    lean_promise_resolve(result, d->promise);
+    lean_dec(d->promise);
+    lean_dec(d->args);
+    delete d;
+}
+
+static void process_output_close(uv_handle_t * handle) {
+    process_output_data * d = (process_output_data*)handle->data;
+    if (--d->open_handles == 0) {
+        process_output_finish(d);
+    }
+}
+
+static void process_output_exit(uv_process_t * process, int64_t exit_status, int term_signal) {
+    process_output_data * d = (process_output_data*)process->data;
+    // Keep in sync with `lean_io_process_child_wait`.
+    d->exit_code = term_signal != 0 ? 128 + term_signal : (uint32_t)exit_status;
+    uv_close((uv_handle_t*)process, process_output_close);
+}
+
+static void process_output_alloc(uv_handle_t * handle, size_t suggested_size, uv_buf_t * buf) {
+    // The buffer can be shared by both pipes since every read is consumed right away.
+    process_output_data * d = (process_output_data*)handle->data;
+    *buf = uv_buf_init(d->buffer, sizeof(d->buffer));
+}
+
+static void process_output_read(uv_stream_t * stream, ssize_t nread, const uv_buf_t * buf) {
+    process_output_data * d = (process_output_data*)stream->data;
+    unsigned i = stream == (uv_stream_t*)&d->pipes[0] ? 0 : 1;
+
+    if (nread > 0) {
+        d->output[i].append(buf->base, nread);
+    } else if (nread < 0) {
+        if (nread != UV_EOF && d->status == 0) {
+            d->status = nread;
+        }
+        uv_close((uv_handle_t*)stream, process_output_close);
+    }
+}
+
+static void process_output_run(event_loop_job * job) {
+    process_output_data * d = (process_output_data*)job;
+    lean_object * args = d->args;
+    lean_object * stdio_cfg = lean_ctor_get(args, 0);
+    lean_object * cmd = lean_ctor_get(args, 1);
+    lean_object * cmd_args = lean_ctor_get(args, 2);
+    lean_object * cwd = lean_ctor_get(args, 3);
+    lean_object * env = lean_ctor_get(args, 4);
+    bool inherit_env = lean_ctor_get_uint8(args, 5 * sizeof(lean_object*));
+    bool do_setsid = lean_ctor_get_uint8(args, 5 * sizeof(lean_object*) + 1);
+    (void)stdio_cfg; // The standard input is null and the outputs are piped, like `IO.Process.output` does.
+
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(lean_string_cstr(cmd)));
+    for (size_t i = 0; i < lean_array_size(cmd_args); i++) {
+        argv.push_back(const_cast<char *>(lean_string_cstr(lean_array_get_core(cmd_args, i))));
+    }
+    argv.push_back(nullptr);
+
+    // The environment is only computed if it differs from the one of the current process.
+    std::vector<std::string> env_entries;
+    std::vector<char *> envp;
+    bool custom_env = !inherit_env || lean_array_size(env) > 0;
+    if (custom_env) {
+        if (inherit_env) {
+            uv_env_item_t * items;
+            int count;
+            if (uv_os_environ(&items, &count) == 0) {
+                for (int i = 0; i < count; i++) {
+                    env_entries.push_back(std::string(items[i].name) + "=" + items[i].value);
+                }
+                uv_os_free_environ(items, count);
+            }
+        }
+        for (size_t i = 0; i < lean_array_size(env); i++) {
+            lean_object * entry = lean_array_get_core(env, i);
+            std::string prefix = std::string(lean_string_cstr(lean_ctor_get(entry, 0))) + "=";
+            for (size_t j = 0; j < env_entries.size();) {
+                if (env_entries[j].compare(0, prefix.size(), prefix) == 0) {
+                    env_entries.erase(env_entries.begin() + j);
+                } else {
+                    j++;
+                }
+            }
+            lean_object * value = lean_ctor_get(entry, 1);
+            if (!lean_is_scalar(value)) {
+                env_entries.push_back(prefix + lean_string_cstr(lean_ctor_get(value, 0)));
+            }
+        }
+        for (auto & e : env_entries) {
+            envp.push_back(const_cast<char *>(e.c_str()));
+        }
+        envp.push_back(nullptr);
+    }
+
+    uv_loop_t * loop = d->ev->loop;
+    uv_stdio_container_t stdio[3];
+    stdio[0].flags = UV_IGNORE;
+    for (unsigned i = 0; i < 2; i++) {
+        uv_pipe_init(loop, &d->pipes[i], 0);
+        d->pipes[i].data = d;
+        d->open_handles++;
+        stdio[i + 1].flags = (uv_stdio_flags)(UV_CREATE_PIPE | UV_WRITABLE_PIPE);
+        stdio[i + 1].data.stream = (uv_stream_t*)&d->pipes[i];
+    }
+
+    uv_process_options_t options;
+    memset(&options, 0, sizeof(options));
+    options.exit_cb = process_output_exit;
+    options.file = argv[0];
+    options.args = argv.data();
+    options.env = custom_env ? envp.data() : nullptr;
+    options.cwd = lean_is_scalar(cwd) ? nullptr : lean_string_cstr(lean_ctor_get(cwd, 0));
+    // A detached process is the leader of a new session.
+    options.flags = do_setsid ? UV_PROCESS_DETACHED : 0;
+    options.stdio_count = 3;
+    options.stdio = stdio;
+
+    d->process.data = d;
+    d->open_handles++;
+    int result = uv_spawn(loop, &d->process, &options);
+
+    if (result < 0) {
+        // The handles have to be closed even if the process could not be spawned.
+        d->status = result;
+        uv_close((uv_handle_t*)&d->process, process_output_close);
+        for (unsigned i = 0; i < 2; i++) {
+            uv_close((uv_handle_t*)&d->pipes[i], process_output_close);
+        }
+        return;
+    }
+
+    for (unsigned i = 0; i < 2; i++) {
+        result = uv_read_start((uv_stream_t*)&d->pipes[i], process_output_alloc, process_output_read);
+        if (result < 0) {
+            if (d->status == 0) {
+                d->status = result;
+            }
+            uv_close((uv_handle_t*)&d->pipes[i], process_output_close);
+        }
+    }
+}
+
+/* Std.Internal.UV.Process.output (args : @& IO.Process.SpawnArgs) : IO (IO.Promise (Except IO.Error (UInt32 × ByteArray × ByteArray))) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_process_output(b_obj_arg args, obj_arg /* w */) {
+    lean_object * promise = lean_promise_new();
+    mark_mt(promise);
+
+    process_output_data * d = new process_output_data;
+    d->job.run = process_output_run;
+    d->ev = event_loop_next();
+    d->promise = promise;
+    // The arguments are released by the event loop thread.
+    mark_mt(args);
+    lean_inc(args);
+    d->args = args;
+    d->exit_code = 0;
+    d->status = 0;
+    d->open_handles = 0;
+
+    // One reference for the event loop, one for the caller.
+    lean_inc(promise);
+    event_loop_submit(d->ev, &d->job);
+
+    return lean_io_result_mk_ok(promise);
+}
+
+#else
+
+/* Std.Internal.UV.Process.output (args : @& IO.Process.SpawnArgs) : IO (IO.Promise (Except IO.Error (UInt32 × ByteArray × ByteArray))) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_process_output(b_obj_arg args, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+#endif
+}
@@ -0,0 +1,20 @@
+/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+#pragma once
+#include <lean/lean.h>
+#include "runtime/uv/event_loop.h"
+
+#ifndef LEAN_EMSCRIPTEN
+#include <uv.h>
+#endif
+
+namespace lean {
+
+// =======================================
+// Process functions
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_process_output(b_obj_arg args, obj_arg /* w */);
+
+}
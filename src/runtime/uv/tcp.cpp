@@ -5,7 +5,10 @@ Author: Sofia Rodrigues
 */
 
 #include "runtime/uv/tcp.h"
+#include <algorithm>
 #include <cstring>
+#include "runtime/buffer.h"
+#include "runtime/thread.h"
 
 namespace lean {
 
@@ -17,16 +20,49 @@ typedef struct {
     lean_object* socket;
 } tcp_connect_data;
 
-// Stores all the things needed to send data to a TCP socket.
+// Stores all the things needed to send data to a TCP socket. These structures are reused, see
+// `tcp_send_data_alloc`.
+struct tcp_send_data {
+    event_loop_job job;     // Must be the first field, the job is submitted to the socket's event loop.
+    uv_write_t     req;
+    lean_object*   promise;
+    lean_object*   data;    // A `ByteArray`, or an `Array ByteArray` if `is_array` is set.
+    lean_object*   socket;
+    bool           is_array;
+    tcp_send_data* next;    // Next send written by the same request, held back by `cork`, or in a free list.
+};
+
+// Stores all the things needed to start receiving data from a TCP socket.
 typedef struct {
+    event_loop_job job;  // Must be the first field, the job is submitted to the socket's event loop.
     lean_object* promise;
-    lean_object* data;
     lean_object* socket;
-} tcp_send_data;
+    uint64_t     buffer_size;
+} tcp_recv_data;
+
+// Stores all the things needed to request the next chunk of a continuously receiving TCP socket, or to
+// give a buffer back to it.
+typedef struct {
+    event_loop_job job;  // Must be the first field, the job is submitted to the socket's event loop.
+    lean_object* promise_or_buffer;
+    lean_object* socket;
+} tcp_stream_data;
 
 // =======================================
 // TCP socket object manipulation functions.
 
+static void tcp_stream_free(lean_uv_tcp_stream* stream) {
+    for (unsigned i = 0; i < stream->m_chunks_size; i++) {
+        lean_dec(stream->m_chunks[(stream->m_chunks_head + i) % stream->m_capacity]);
+    }
+    for (unsigned i = 0; i < stream->m_pool_size; i++) {
+        lean_dec(stream->m_pool[i]);
+    }
+    free(stream->m_chunks);
+    free(stream->m_pool);
+    free(stream);
+}
+
 void lean_uv_tcp_socket_finalizer(void* ptr) {
     lean_uv_tcp_socket_object* tcp_socket = (lean_uv_tcp_socket_object*)ptr;
 
@@ -34,12 +70,19 @@ void lean_uv_tcp_socket_finalizer(void* ptr) {
     lean_always_assert(tcp_socket->m_promise_accept == nullptr);
     lean_always_assert(tcp_socket->m_promise_read == nullptr);
     lean_always_assert(tcp_socket->m_byte_array == nullptr);
+    lean_always_assert(tcp_socket->m_stream == nullptr || tcp_socket->m_stream->m_finished);
+    lean_always_assert(tcp_socket->m_corked_sends == nullptr);
 
     /// It's changing here because the object is being freed in the finalizer, and we need the data
     /// inside of it.
     tcp_socket->m_uv_tcp->data = ptr;
 
-    event_loop_lock(&global_ev);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
+    event_loop_lock(ev);
+
+    if (tcp_socket->m_stream != nullptr) {
+        tcp_stream_free(tcp_socket->m_stream);
+    }
 
     uv_close((uv_handle_t*)tcp_socket->m_uv_tcp, [](uv_handle_t* handle) {
         lean_uv_tcp_socket_object* tcp_socket = (lean_uv_tcp_socket_object*)handle->data;
@@ -47,7 +90,7 @@ void lean_uv_tcp_socket_finalizer(void* ptr) {
         free(tcp_socket);
     });
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 }
 
 void initialize_libuv_tcp_socket() {
@@ -73,14 +116,25 @@ void initialize_libuv_tcp_socket() {
             lean_inc(f);
             lean_apply_1(f, tcp_socket->m_byte_array);
         }
+
+        if (lean_uv_tcp_stream* stream = tcp_socket->m_stream) {
+            for (unsigned i = 0; i < stream->m_chunks_size; i++) {
+                lean_inc(f);
+                lean_apply_1(f, stream->m_chunks[(stream->m_chunks_head + i) % stream->m_capacity]);
+            }
+            for (unsigned i = 0; i < stream->m_pool_size; i++) {
+                lean_inc(f);
+                lean_apply_1(f, stream->m_pool[i]);
+            }
+        }
     });
 }
 
 // =======================================
 // TCP Socket Operations
 
-/* Std.Internal.UV.TCP.Socket.new : IO Socket */
-extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_new(obj_arg /* w */) {
+// Creates a new TCP socket on the event loop `ev`.
+static lean_obj_res tcp_new_on_loop(event_loop_t* ev) {
     lean_uv_tcp_socket_object* tcp_socket = (lean_uv_tcp_socket_object*)malloc(sizeof(lean_uv_tcp_socket_object));
 
     tcp_socket->m_promise_accept = nullptr;
@@ -88,12 +142,18 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_new(obj_arg /* w */) {
     tcp_socket->m_promise_read = nullptr;
     tcp_socket->m_byte_array = nullptr;
     tcp_socket->m_client = nullptr;
+    tcp_socket->m_stream = nullptr;
+    tcp_socket->m_corked = false;
+    tcp_socket->m_corked_sends = nullptr;
+    tcp_socket->m_corked_last = nullptr;
+    tcp_socket->m_bytes_received = 0;
+    tcp_socket->m_bytes_sent = 0;
 
     uv_tcp_t* uv_tcp = (uv_tcp_t*)malloc(sizeof(uv_tcp_t));
 
-    event_loop_lock(&global_ev);
-    int result = uv_tcp_init(global_ev.loop, uv_tcp);
-    event_loop_unlock(&global_ev);
+    event_loop_lock(ev);
+    int result = uv_tcp_init(ev->loop, uv_tcp);
+    event_loop_unlock(ev);
 
     if (result != 0) {
         free(uv_tcp);
@@ -112,9 +172,15 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_new(obj_arg /* w */) {
     return lean_io_result_mk_ok(obj);
 }
 
+/* Std.Internal.UV.TCP.Socket.new : IO Socket */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_new(obj_arg /* w */) {
+    return tcp_new_on_loop(event_loop_next());
+}
+
 /* Std.Internal.UV.TCP.Socket.connect (socket : @& Socket) (addr : @& SocketAddress) : IO (IO.Promise (Except IO.Error Unit)) */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_connect(b_obj_arg socket, b_obj_arg addr, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
     lean_object* promise = lean_promise_new();
     mark_mt(promise);
@@ -134,7 +200,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_connect(b_obj_arg socket, b_obj_
     lean_inc(socket);
     lean_inc(promise);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
 
     int result = uv_tcp_connect(uv_connect, tcp_socket->m_uv_tcp, (sockaddr*)&addr_struct, [](uv_connect_t* req, int status) {
         tcp_connect_data* tup = (tcp_connect_data*) req->data;
@@ -148,7 +214,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_connect(b_obj_arg socket, b_obj_
         free(req);
     });
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         lean_dec(promise); // The structure does not own it.
@@ -164,86 +230,251 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_connect(b_obj_arg socket, b_obj_
     return lean_io_result_mk_ok(promise);
 }
 
-/* Std.Internal.UV.TCP.Socket.send (socket : @& Socket) (data : ByteArray) : IO (IO.Promise (Except IO.Error Unit)) */
-extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_send(b_obj_arg socket, obj_arg data, obj_arg /* w */) {
-    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+// =======================================
+// Sending data
+
+/*
+Sends are frequent, so their structures are not freed but put on a free list. They are released on
+the event loop threads and allocated on the threads calling `send`: released structures are pushed
+onto `g_free_sends`, and a thread that runs out of structures takes the whole list at once, which
+avoids the ABA problem of popping single elements from a lock-free stack. At most about
+`TCP_MAX_FREE_SENDS` structures are kept in all lists together, and the list taken by a thread is
+freed when the thread exits.
+*/
+static constexpr size_t TCP_MAX_FREE_SENDS = 256;
+static std::atomic<tcp_send_data*> g_free_sends(nullptr);
+// Number of structures in `g_free_sends` and in the lists of all threads.
+static std::atomic<size_t> g_free_sends_size(0);
+LEAN_THREAD_PTR(tcp_send_data, g_thread_free_sends);
+LEAN_THREAD_VALUE(bool, g_thread_free_sends_registered, false);
+
+static void tcp_send_data_thread_finalizer(void*) {
+    while (g_thread_free_sends != nullptr) {
+        tcp_send_data* next = g_thread_free_sends->next;
+        free(g_thread_free_sends);
+        g_thread_free_sends = next;
+        g_free_sends_size.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+static tcp_send_data* tcp_send_data_alloc() {
+    tcp_send_data* send_data = g_thread_free_sends;
+    if (send_data == nullptr) {
+        send_data = g_free_sends.exchange(nullptr, std::memory_order_acquire);
+        if (send_data == nullptr) {
+            return (tcp_send_data*)malloc(sizeof(tcp_send_data));
+        }
+        if (!g_thread_free_sends_registered) {
+            register_thread_finalizer(tcp_send_data_thread_finalizer, nullptr);
+            g_thread_free_sends_registered = true;
+        }
+    }
+    g_thread_free_sends = send_data->next;
+    g_free_sends_size.fetch_sub(1, std::memory_order_relaxed);
+    return send_data;
+}
+
+static void tcp_send_data_free(tcp_send_data* send_data) {
+    if (g_free_sends_size.fetch_add(1, std::memory_order_relaxed) >= TCP_MAX_FREE_SENDS) {
+        g_free_sends_size.fetch_sub(1, std::memory_order_relaxed);
+        free(send_data);
+        return;
+    }
+    tcp_send_data* head = g_free_sends.load(std::memory_order_relaxed);
+    do {
+        send_data->next = head;
+    } while (!g_free_sends.compare_exchange_weak(head, send_data, std::memory_order_release, std::memory_order_relaxed));
+}
+
+static uint64_t tcp_send_size(tcp_send_data* send_data) {
+    if (!send_data->is_array) {
+        return lean_sarray_size(send_data->data);
+    }
+    uint64_t size = 0;
+    size_t n = lean_array_size(send_data->data);
+    for (size_t i = 0; i < n; i++) {
+        size += lean_sarray_size(lean_array_get_core(send_data->data, i));
+    }
+    return size;
+}
 
-    size_t data_len = lean_sarray_size(data);
-    char* data_str = (char*)lean_sarray_cptr(data);
+// Resolves the promises of all sends written by `req`.
+static void tcp_send_callback(uv_write_t* req, int status) {
+    tcp_send_data* send_data = (tcp_send_data*) req->data;
 
-    uv_buf_t buf = uv_buf_init(data_str, data_len);
+    while (send_data != nullptr) {
+        tcp_send_data* next = send_data->next;
+
+        if (status == 0) {
+            lean_to_uv_tcp_socket(send_data->socket)->m_bytes_sent += tcp_send_size(send_data);
+        }
+
+        lean_promise_resolve_with_code(status, send_data->promise);
+
+        lean_dec(send_data->promise);
+        lean_dec(send_data->data);
+        lean_dec(send_data->socket);
+
+        tcp_send_data_free(send_data);
+        send_data = next;
+    }
+}
+
+static void tcp_send_push_bufs(tcp_send_data* send_data, buffer<uv_buf_t> & bufs) {
+    auto push = [&](lean_object* data) {
+        bufs.push_back(uv_buf_init((char*)lean_sarray_cptr(data), lean_sarray_size(data)));
+    };
+    if (send_data->is_array) {
+        size_t n = lean_array_size(send_data->data);
+        for (size_t i = 0; i < n; i++) {
+            push(lean_array_get_core(send_data->data, i));
+        }
+    } else {
+        push(send_data->data);
+    }
+}
+
+// Writes the sends starting at `send_data` and linked by `next` with a single request. The event loop
+// must be locked.
+static void tcp_send_write(lean_uv_tcp_socket_object* tcp_socket, tcp_send_data* send_data) {
+    // `uv_write` copies the buffer descriptors, the buffers themselves are kept alive by `send_data`. A
+    // few descriptors fit on the stack.
+    buffer<uv_buf_t> bufs;
+    for (tcp_send_data* it = send_data; it != nullptr; it = it->next) {
+        tcp_send_push_bufs(it, bufs);
+    }
+
+    if (bufs.empty()) {
+        // Nothing to write, `uv_write` expects at least one buffer.
+        send_data->req.data = send_data;
+        tcp_send_callback(&send_data->req, 0);
+        return;
+    }
+
+    send_data->req.data = send_data;
+    int result = uv_write(&send_data->req, (uv_stream_t*)tcp_socket->m_uv_tcp, bufs.data(), bufs.size(), tcp_send_callback);
+
+    if (result < 0) {
+        // The write callback is not going to be called, so we resolve the promises here.
+        tcp_send_callback(&send_data->req, result);
+    }
+}
+
+// Starts the write of a `tcp_send_data` job, or holds it back if the socket is corked. It runs with
+// exclusive access to the socket's event loop.
+static void tcp_send_run(event_loop_job* job) {
+    tcp_send_data* send_data = (tcp_send_data*)job;
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(send_data->socket);
+    send_data->next = nullptr;
+
+    if (tcp_socket->m_corked) {
+        if (tcp_socket->m_corked_last != nullptr) {
+            tcp_socket->m_corked_last->next = send_data;
+        } else {
+            tcp_socket->m_corked_sends = send_data;
+        }
+        tcp_socket->m_corked_last = send_data;
+        return;
+    }
+
+    tcp_send_write(tcp_socket, send_data);
+}
+
+static lean_obj_res tcp_send_core(b_obj_arg socket, obj_arg data, bool is_array) {
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
     lean_object* promise = lean_promise_new();
     mark_mt(promise);
 
-    uv_write_t* write_uv = (uv_write_t*)malloc(sizeof(uv_write_t));
-    write_uv->data = (tcp_send_data*)malloc(sizeof(tcp_send_data));
-
-    tcp_send_data* send_data = (tcp_send_data*)write_uv->data;
+    tcp_send_data* send_data = tcp_send_data_alloc();
+    send_data->job.run = tcp_send_run;
     send_data->promise = promise;
     send_data->data = data;
     send_data->socket = socket;
+    send_data->is_array = is_array;
 
     // These objects are going to enter the loop and be owned by it
     lean_inc(promise);
     lean_inc(socket);
 
-    event_loop_lock(&global_ev);
+    // Errors are reported through the promise, so we do not need to wait for the event loop.
+    event_loop_submit(ev, &send_data->job);
 
-    int result = uv_write(write_uv, (uv_stream_t*)tcp_socket->m_uv_tcp, &buf, 1, [](uv_write_t* req, int status) {
-        tcp_send_data* tup = (tcp_send_data*) req->data;
+    return lean_io_result_mk_ok(promise);
+}
 
-        lean_promise_resolve_with_code(status, tup->promise);
+/* Std.Internal.UV.TCP.Socket.send (socket : @& Socket) (data : ByteArray) : IO (IO.Promise (Except IO.Error Unit)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_send(b_obj_arg socket, obj_arg data, obj_arg /* w */) {
+    return tcp_send_core(socket, data, false);
+}
 
-        lean_dec(tup->promise);
-        lean_dec(tup->data);
-        lean_dec(tup->socket);
+/* Std.Internal.UV.TCP.Socket.sendAll (socket : @& Socket) (data : Array ByteArray) : IO (IO.Promise (Except IO.Error Unit)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_send_all(b_obj_arg socket, obj_arg data, obj_arg /* w */) {
+    return tcp_send_core(socket, data, true);
+}
 
-        free(req->data);
-        free(req);
-    });
+// Writes the sends held back by `cork` with a single request. The event loop must be locked.
+static void tcp_flush(lean_uv_tcp_socket_object* tcp_socket) {
+    tcp_send_data* send_data = tcp_socket->m_corked_sends;
+    tcp_socket->m_corked_sends = nullptr;
+    tcp_socket->m_corked_last = nullptr;
+    if (send_data != nullptr) {
+        tcp_send_write(tcp_socket, send_data);
+    }
+}
 
-    event_loop_unlock(&global_ev);
+/* Std.Internal.UV.TCP.Socket.cork (socket : @& Socket) : IO Unit */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_cork(b_obj_arg socket, obj_arg /* w */) {
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
-    if (result < 0) {
-        lean_dec(promise); // The structure does not own it.
-        lean_dec(promise); // We are not going to return it.
-        lean_dec(socket);
-        lean_dec(data);
+    event_loop_lock(ev);
+    tcp_socket->m_corked = true;
+    event_loop_unlock(ev);
 
-        free(write_uv->data);
-        free(write_uv);
+    return lean_io_result_mk_ok(lean_box(0));
+}
 
-        return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
+/* Std.Internal.UV.TCP.Socket.flush (socket : @& Socket) (uncork : Bool) : IO Unit */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_flush(b_obj_arg socket, uint8_t uncork, obj_arg /* w */) {
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
+
+    // Locking the loop runs the sends submitted before by this thread first.
+    event_loop_lock(ev);
+    tcp_flush(tcp_socket);
+    if (uncork) {
+        tcp_socket->m_corked = false;
     }
+    event_loop_unlock(ev);
 
-    return lean_io_result_mk_ok(promise);
+    return lean_io_result_mk_ok(lean_box(0));
 }
 
-/* Std.Internal.UV.TCP.Socket.recv? (socket : @& Socket) (size : UInt64) : IO (IO.Promise (Except IO.Error (Option ByteArray))) */
-extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv(b_obj_arg socket, uint64_t buffer_size, obj_arg /* w */) {
-    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+// Starts reading for a `tcp_recv_data` job. It runs with exclusive access to the socket's event loop.
+static void tcp_recv_run(event_loop_job* job) {
+    tcp_recv_data* recv_data = (tcp_recv_data*)job;
+    lean_object* socket = recv_data->socket;
+    lean_object* promise = recv_data->promise;
+    uint64_t buffer_size = recv_data->buffer_size;
+    free(recv_data);
 
-    // Locking early prevents potential parallelism issues setting the byte_array.
-    event_loop_lock(&global_ev);
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
 
-    if (tcp_socket->m_promise_read != nullptr) {
-        event_loop_unlock(&global_ev);
-        return lean_io_result_mk_error(lean_decode_uv_error(UV_EALREADY, nullptr));
+    if (tcp_socket->m_promise_read != nullptr || tcp_socket->m_stream != nullptr) {
+        // The continuous receive mode does not support single receives.
+        int code = tcp_socket->m_stream != nullptr ? UV_EINVAL : UV_EALREADY;
+        lean_promise_resolve(mk_except_err(lean_decode_uv_error(code, nullptr)), promise);
+        lean_dec(promise);
+        lean_dec(socket);
+        return;
     }
 
     lean_object* byte_array = lean_alloc_sarray(1, 0, buffer_size);
     tcp_socket->m_byte_array = byte_array;
-
-    lean_object* promise = lean_promise_new();
-    mark_mt(promise);
-
     tcp_socket->m_promise_read = promise;
 
-    // The event loop owns the socket.
-    lean_inc(socket);
-    lean_inc(promise);
-
     int result = uv_read_start((uv_stream_t*)tcp_socket->m_uv_tcp, [](uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
         lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket((lean_object*)handle->data);
 
@@ -260,6 +491,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv(b_obj_arg socket, uint64_t
         tcp_socket->m_byte_array = nullptr;
 
         if (nread >= 0) {
+            tcp_socket->m_bytes_received += nread;
             lean_sarray_set_size(byte_array, nread);
             lean_promise_resolve(mk_except_ok(lean::mk_option_some(byte_array)), promise);
         } else if (nread == UV_EOF) {
@@ -280,17 +512,34 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv(b_obj_arg socket, uint64_t
         tcp_socket->m_byte_array = nullptr;
         tcp_socket->m_promise_read = nullptr;
 
-        event_loop_unlock(&global_ev);
-
         lean_dec(byte_array);
-        lean_dec(promise); // The structure does not own it.
-        lean_dec(promise); // We are not going to return it.
+        lean_promise_resolve(mk_except_err(lean_decode_uv_error(result, nullptr)), promise);
+        lean_dec(promise);
         lean_dec(socket);
-
-        return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
     }
+}
 
-    event_loop_unlock(&global_ev);
+/* Std.Internal.UV.TCP.Socket.recv? (socket : @& Socket) (size : UInt64) : IO (IO.Promise (Except IO.Error (Option ByteArray))) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv(b_obj_arg socket, uint64_t buffer_size, obj_arg /* w */) {
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
+
+    lean_object* promise = lean_promise_new();
+    mark_mt(promise);
+
+    tcp_recv_data* recv_data = (tcp_recv_data*)malloc(sizeof(tcp_recv_data));
+    recv_data->job.run = tcp_recv_run;
+    recv_data->promise = promise;
+    recv_data->socket = socket;
+    recv_data->buffer_size = buffer_size;
+
+    // The event loop owns the socket.
+    lean_inc(socket);
+    lean_inc(promise);
+
+    // Checking for a pending receive on the event loop prevents potential parallelism issues setting the
+    // byte_array, errors are reported through the promise.
+    event_loop_submit(ev, &recv_data->job);
 
     return lean_io_result_mk_ok(promise);
 }
@@ -298,12 +547,15 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv(b_obj_arg socket, uint64_t
 /* Std.Internal.UV.TCP.Socket.waitReadable (socket : @& Socket) : IO (IO.Promise (Except IO.Error Bool)) */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_wait_readable(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
 
-    if (tcp_socket->m_promise_read != nullptr) {
-        event_loop_unlock(&global_ev);
-        return lean_io_result_mk_error(lean_decode_uv_error(UV_EALREADY, nullptr));
+    if (tcp_socket->m_promise_read != nullptr || tcp_socket->m_stream != nullptr) {
+        // The continuous receive mode does not support waiting for readability.
+        int code = tcp_socket->m_stream != nullptr ? UV_EINVAL : UV_EALREADY;
+        event_loop_unlock(ev);
+        return lean_io_result_mk_error(lean_decode_uv_error(code, nullptr));
     }
 
     lean_object* promise = lean_promise_new();
@@ -348,7 +600,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_wait_readable(b_obj_arg socket,
     if (result < 0) {
         tcp_socket->m_promise_read = nullptr;
 
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
 
         lean_dec(promise); // The structure does not own it.
         lean_dec(promise); // We are not going to return it.
@@ -357,19 +609,292 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_wait_readable(b_obj_arg socket,
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
     }
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
+
+    return lean_io_result_mk_ok(promise);
+}
+
+// =======================================
+// Continuous receive mode
+
+// Returns whether we own the only reference to `o`, it may have been marked as multi-threaded by a promise.
+static bool tcp_is_exclusive(lean_object* o) {
+    if (lean_is_st(o)) return o->m_rc == 1;
+#if defined(LEAN_MULTI_THREAD)
+    return lean_is_mt(o) && std::atomic_load_explicit(lean_get_rc_mt_addr(o), std::memory_order_acquire) == -1;
+#else
+    return false;
+#endif
+}
+
+// Puts `buffer` into the pool of the stream if it can be reused for receiving data, and frees it otherwise.
+static void tcp_stream_recycle(lean_uv_tcp_stream* stream, lean_object* buffer) {
+    if (stream->m_pool_size < stream->m_capacity && lean_sarray_capacity(buffer) >= stream->m_buffer_size && tcp_is_exclusive(buffer)) {
+        stream->m_pool[stream->m_pool_size++] = buffer;
+    } else {
+        lean_dec(buffer);
+    }
+}
+
+// Resolves the pending `recvNext?` with `result`, or queues it. Reading is paused once the queue is full.
+static void tcp_stream_push(lean_uv_tcp_socket_object* tcp_socket, lean_object* result) {
+    lean_uv_tcp_stream* stream = tcp_socket->m_stream;
+
+    if (tcp_socket->m_promise_read != nullptr) {
+        lean_object* promise = tcp_socket->m_promise_read;
+        tcp_socket->m_promise_read = nullptr;
+        lean_promise_resolve(result, promise);
+        lean_dec(promise);
+        return;
+    }
+
+    stream->m_chunks[(stream->m_chunks_head + stream->m_chunks_size) % stream->m_capacity] = result;
+    stream->m_chunks_size++;
+
+    if (stream->m_chunks_size == stream->m_capacity && stream->m_reading) {
+        uv_read_stop((uv_stream_t*)tcp_socket->m_uv_tcp);
+        stream->m_reading = false;
+    }
+}
+
+static void tcp_stream_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket((lean_object*)handle->data);
+    lean_uv_tcp_stream* stream = tcp_socket->m_stream;
+
+    lean_object* byte_array = stream->m_pool_size > 0
+        ? stream->m_pool[--stream->m_pool_size]
+        : lean_alloc_sarray(1, 0, stream->m_buffer_size);
+    tcp_socket->m_byte_array = byte_array;
+
+    // Recycled buffers may be larger, but chunks are at most `m_buffer_size` bytes.
+    buf->base = (char*)lean_sarray_cptr(byte_array);
+    buf->len = std::min<size_t>(lean_sarray_capacity(byte_array), stream->m_buffer_size);
+}
+
+static void tcp_stream_read(uv_stream_t* uv_stream, ssize_t nread, const uv_buf_t* buf) {
+    lean_object* socket = (lean_object*)uv_stream->data;
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    lean_uv_tcp_stream* stream = tcp_socket->m_stream;
+
+    lean_object* byte_array = tcp_socket->m_byte_array;
+    tcp_socket->m_byte_array = nullptr;
+
+    if (nread > 0) {
+        tcp_socket->m_bytes_received += nread;
+        lean_sarray_set_size(byte_array, nread);
+        tcp_stream_push(tcp_socket, mk_except_ok(lean::mk_option_some(byte_array)));
+        return;
+    }
+
+    if (byte_array != nullptr) {
+        tcp_stream_recycle(stream, byte_array);
+    }
+
+    if (nread == 0) {
+        // Equivalent to `EAGAIN`, there is nothing to deliver.
+        return;
+    }
+
+    uv_read_stop(uv_stream);
+    stream->m_reading = false;
+    stream->m_finished = true;
+
+    if (nread == UV_EOF) {
+        tcp_stream_push(tcp_socket, mk_except_ok(lean::mk_option_none()));
+    } else {
+        tcp_stream_push(tcp_socket, mk_except_err(lean_decode_uv_error(nread, nullptr)));
+    }
+
+    // The event loop does not own the object anymore.
+    lean_dec(socket);
+}
+
+// Leaves the continuous receive mode, resolving a pending `recvNext?` to `none`. The event loop must be locked.
+static void tcp_stream_stop(b_obj_arg socket) {
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    lean_uv_tcp_stream* stream = tcp_socket->m_stream;
+    bool finished = stream->m_finished;
+
+    if (stream->m_reading) {
+        uv_read_stop((uv_stream_t*)tcp_socket->m_uv_tcp);
+    }
+
+    if (tcp_socket->m_promise_read != nullptr) {
+        lean_promise_resolve(mk_except_ok(lean::mk_option_none()), tcp_socket->m_promise_read);
+        lean_dec(tcp_socket->m_promise_read);
+        tcp_socket->m_promise_read = nullptr;
+    }
+
+    tcp_socket->m_stream = nullptr;
+    tcp_stream_free(stream);
+
+    if (!finished) {
+        // The event loop does not own the object anymore.
+        lean_dec(socket);
+    }
+}
+
+/* Std.Internal.UV.TCP.Socket.recvStart (socket : @& Socket) (size : UInt64) (capacity : UInt32) : IO Unit */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv_start(b_obj_arg socket, uint64_t buffer_size, uint32_t capacity, obj_arg /* w */) {
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
+
+    if (capacity == 0) capacity = 1;
+
+    event_loop_lock(ev);
+
+    if (tcp_socket->m_promise_read != nullptr || tcp_socket->m_stream != nullptr) {
+        event_loop_unlock(ev);
+        return lean_io_result_mk_error(lean_decode_uv_error(UV_EALREADY, nullptr));
+    }
+
+    lean_uv_tcp_stream* stream = (lean_uv_tcp_stream*)malloc(sizeof(lean_uv_tcp_stream));
+    stream->m_buffer_size = buffer_size;
+    stream->m_capacity = capacity;
+    stream->m_chunks = (lean_object**)malloc(sizeof(lean_object*) * capacity);
+    stream->m_chunks_head = 0;
+    stream->m_chunks_size = 0;
+    stream->m_pool = (lean_object**)malloc(sizeof(lean_object*) * capacity);
+    stream->m_pool_size = 0;
+    stream->m_reading = true;
+    stream->m_finished = false;
+
+    tcp_socket->m_stream = stream;
+
+    int result = uv_read_start((uv_stream_t*)tcp_socket->m_uv_tcp, tcp_stream_alloc, tcp_stream_read);
+
+    if (result < 0) {
+        tcp_socket->m_stream = nullptr;
+        tcp_stream_free(stream);
+        event_loop_unlock(ev);
+        return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
+    }
+
+    // The event loop owns the socket until the end of the stream.
+    lean_inc(socket);
+
+    event_loop_unlock(ev);
+
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+static void tcp_stream_next_run(event_loop_job* job) {
+    tcp_stream_data* next_data = (tcp_stream_data*)job;
+    lean_object* socket = next_data->socket;
+    lean_object* promise = next_data->promise_or_buffer;
+    free(next_data);
+
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    lean_uv_tcp_stream* stream = tcp_socket->m_stream;
+
+    if (stream == nullptr || tcp_socket->m_promise_read != nullptr) {
+        int code = stream == nullptr ? UV_EINVAL : UV_EALREADY;
+        lean_promise_resolve(mk_except_err(lean_decode_uv_error(code, nullptr)), promise);
+        lean_dec(promise);
+    } else if (stream->m_chunks_size > 0) {
+        lean_object* result = stream->m_chunks[stream->m_chunks_head];
+        stream->m_chunks_head = (stream->m_chunks_head + 1) % stream->m_capacity;
+        stream->m_chunks_size--;
+        lean_promise_resolve(result, promise);
+        lean_dec(promise);
+
+        if (!stream->m_reading && !stream->m_finished) {
+            // There is room in the queue again.
+            int result = uv_read_start((uv_stream_t*)tcp_socket->m_uv_tcp, tcp_stream_alloc, tcp_stream_read);
+            if (result < 0) {
+                stream->m_finished = true;
+                tcp_stream_push(tcp_socket, mk_except_err(lean_decode_uv_error(result, nullptr)));
+                // The event loop does not own the object anymore.
+                lean_dec(socket);
+            } else {
+                stream->m_reading = true;
+            }
+        }
+    } else if (stream->m_finished) {
+        lean_promise_resolve(mk_except_ok(lean::mk_option_none()), promise);
+        lean_dec(promise);
+    } else {
+        // Resolved by `tcp_stream_push`.
+        tcp_socket->m_promise_read = promise;
+    }
+
+    lean_dec(socket);
+}
+
+/* Std.Internal.UV.TCP.Socket.recvNext? (socket : @& Socket) : IO (IO.Promise (Except IO.Error (Option ByteArray))) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv_next(b_obj_arg socket, obj_arg /* w */) {
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
+
+    lean_object* promise = lean_promise_new();
+    mark_mt(promise);
+
+    tcp_stream_data* next_data = (tcp_stream_data*)malloc(sizeof(tcp_stream_data));
+    next_data->job.run = tcp_stream_next_run;
+    next_data->promise_or_buffer = promise;
+    next_data->socket = socket;
+
+    lean_inc(socket);
+    lean_inc(promise);
+
+    event_loop_submit(ev, &next_data->job);
 
     return lean_io_result_mk_ok(promise);
 }
 
+static void tcp_stream_recycle_run(event_loop_job* job) {
+    tcp_stream_data* recycle_data = (tcp_stream_data*)job;
+    lean_object* socket = recycle_data->socket;
+    lean_object* buffer = recycle_data->promise_or_buffer;
+    free(recycle_data);
+
+    lean_uv_tcp_stream* stream = lean_to_uv_tcp_socket(socket)->m_stream;
+    if (stream != nullptr) {
+        tcp_stream_recycle(stream, buffer);
+    } else {
+        lean_dec(buffer);
+    }
+
+    lean_dec(socket);
+}
+
+/* Std.Internal.UV.TCP.Socket.recycle (socket : @& Socket) (buffer : ByteArray) : IO Unit */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recycle(b_obj_arg socket, obj_arg buffer, obj_arg /* w */) {
+    if (!tcp_is_exclusive(buffer)) {
+        lean_dec(buffer);
+        return lean_io_result_mk_ok(lean_box(0));
+    }
+
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
+
+    tcp_stream_data* recycle_data = (tcp_stream_data*)malloc(sizeof(tcp_stream_data));
+    recycle_data->job.run = tcp_stream_recycle_run;
+    recycle_data->promise_or_buffer = buffer;
+    recycle_data->socket = socket;
+
+    lean_inc(socket);
+
+    event_loop_submit(ev, &recycle_data->job);
+
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
 /* Std.Internal.UV.TCP.Socket.cancelRecv (socket : @& Socket) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_cancel_recv(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
+
+    if (tcp_socket->m_stream != nullptr) {
+        tcp_stream_stop(socket);
+        event_loop_unlock(ev);
+        return lean_io_result_mk_ok(lean_box(0));
+    }
 
     if (tcp_socket->m_promise_read == nullptr) {
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
         return lean_io_result_mk_ok(lean_box(0));
     }
 
@@ -387,20 +912,32 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_cancel_recv(b_obj_arg socket, ob
 
     lean_dec((lean_object*)tcp_socket);
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
-/* Std.Internal.UV.TCP.Socket.bind (socket : @& Socket) (addr : @& SocketAddress) : IO Unit */
-extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_bind(b_obj_arg socket, b_obj_arg addr, obj_arg /* w */) {
+/* Std.Internal.UV.TCP.Socket.bind (socket : @& Socket) (addr : @& SocketAddress) (reusePort : UInt8) : IO Unit */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_bind(b_obj_arg socket, b_obj_arg addr, uint8_t reuse_port, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
     sockaddr_storage addr_ptr;
     lean_socket_address_to_sockaddr_storage(addr, &addr_ptr);
 
-    event_loop_lock(&global_ev);
-    int result = uv_tcp_bind(tcp_socket->m_uv_tcp, (sockaddr*)&addr_ptr, 0);
-    event_loop_unlock(&global_ev);
+    unsigned int flags = 0;
+    if (reuse_port) {
+#if UV_VERSION_HEX >= ((1 << 16) | (49 << 8))
+        // Lets the kernel distribute incoming connections over all sockets bound to the address, e.g.,
+        // listeners on different event loops.
+        flags |= UV_TCP_REUSEPORT;
+#else
+        return lean_io_result_mk_error(lean_decode_uv_error(UV_ENOTSUP, nullptr));
+#endif
+    }
+
+    event_loop_lock(ev);
+    int result = uv_tcp_bind(tcp_socket->m_uv_tcp, (sockaddr*)&addr_ptr, flags);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -412,8 +949,9 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_bind(b_obj_arg socket, b_obj_arg
 /* Std.Internal.UV.TCP.Socket.listen (socket : @& Socket) (backlog : Int32) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_listen(b_obj_arg socket, int32_t backlog, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
 
     int result = uv_listen((uv_stream_t*)tcp_socket->m_uv_tcp, backlog, [](uv_stream_t* stream, int status) {
         lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket((lean_object*)stream->data);
@@ -453,7 +991,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_listen(b_obj_arg socket, int32_t
         lean_dec((lean_object*)stream->data);
     });
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -465,29 +1003,32 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_listen(b_obj_arg socket, int32_t
 /* Std.Internal.UV.TCP.Socket.accept (socket : @& Socket) : IO (IO.Promise (Except IO.Error Socket)) */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_accept(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
     // Locking early prevents potential parallelism issues setting m_promise_accept.
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
 
     if (tcp_socket->m_promise_accept != nullptr) {
+        event_loop_unlock(ev);
         return lean_io_result_mk_error(lean_decode_uv_error(UV_EALREADY, mk_string("parallel accept is not allowed! consider binding multiple sockets to the same address and accepting on them instead")));
     }
 
     lean_object* promise = lean_promise_new();
     mark_mt(promise);
 
-    lean_object* client = lean_io_result_take_value(lean_uv_tcp_new(lean_box(0)));
+    // The accepted socket must live on the same event loop as the server socket.
+    lean_object* client = lean_io_result_take_value(tcp_new_on_loop(ev));
 
     lean_uv_tcp_socket_object* client_socket = lean_to_uv_tcp_socket(client);
 
     int result = uv_accept((uv_stream_t*)tcp_socket->m_uv_tcp, (uv_stream_t*)client_socket->m_uv_tcp);
 
     if (result < 0 && result != UV_EAGAIN) {
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
         lean_dec(client);
         lean_promise_resolve_with_code(result, promise);
     } else if (result >= 0) {
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
         lean_promise_resolve(mk_except_ok(client), promise);
     } else {
         // The event loop owns the object. It will be released in the listen
@@ -497,7 +1038,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_accept(b_obj_arg socket, obj_arg
         tcp_socket->m_promise_accept = promise;
         tcp_socket->m_client = client;
 
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
     }
 
     return lean_io_result_mk_ok(promise);
@@ -506,12 +1047,13 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_accept(b_obj_arg socket, obj_arg
 /* Std.Internal.UV.TCP.Socket.shutdown (socket : @& Socket) : IO (IO.Promise (Except IO.Error Unit)) */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_shutdown(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
     // Locking early prevents potential parallelism issues setting the m_promise_shutdown.
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
 
     if (tcp_socket->m_promise_shutdown != nullptr) {
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
         return lean_io_result_mk_error(lean_decode_uv_error(UV_EALREADY, mk_string("shutdown already in progress")));
     }
 
@@ -549,12 +1091,12 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_shutdown(b_obj_arg socket, obj_a
         free(shutdown_req);
         lean_dec(tcp_socket->m_promise_shutdown);
         tcp_socket->m_promise_shutdown = nullptr;
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
 
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
     }
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     return lean_io_result_mk_ok(promise);
 }
@@ -562,13 +1104,14 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_shutdown(b_obj_arg socket, obj_a
 /* Std.Internal.UV.TCP.Socket.getPeerName (socket : @& Socket) : IO SocketAddress */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_getpeername(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
     sockaddr_storage addr_storage;
     int addr_len = sizeof(addr_storage);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_tcp_getpeername(tcp_socket->m_uv_tcp, (struct sockaddr*)&addr_storage, &addr_len);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -582,13 +1125,14 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_getpeername(b_obj_arg socket, ob
 /* Std.Internal.UV.TCP.Socket.getSockName (socket : @& Socket) : IO SocketAddress */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_getsockname(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
     struct sockaddr_storage addr_storage;
     int addr_len = sizeof(addr_storage);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_tcp_getsockname(tcp_socket->m_uv_tcp, (struct sockaddr*)&addr_storage, &addr_len);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -601,10 +1145,11 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_getsockname(b_obj_arg socket, ob
 /* Std.Internal.UV.TCP.Socket.noDelay (socket : @& Socket) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_nodelay(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_tcp_nodelay(tcp_socket->m_uv_tcp, 1);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -616,10 +1161,11 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_nodelay(b_obj_arg socket, obj_ar
 /* Std.Internal.UV.TCP.Socket.keepAlive (socket : @& Socket) (enable : Int8) (delay : UInt32) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_keepalive(b_obj_arg socket, int32_t enable, uint32_t delay, obj_arg /* w */) {
     lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_tcp_keepalive(tcp_socket->m_uv_tcp, enable, delay);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -627,6 +1173,22 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_keepalive(b_obj_arg socket, int3
 
     return lean_io_result_mk_ok(lean_box(0));
 }
+
+/* Std.Internal.UV.TCP.Socket.byteCounts (socket : @& Socket) : IO (UInt64 × UInt64) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_byte_counts(b_obj_arg socket, obj_arg /* w */) {
+    lean_uv_tcp_socket_object* tcp_socket = lean_to_uv_tcp_socket(socket);
+    event_loop_t* ev = event_loop_of(tcp_socket->m_uv_tcp);
+
+    event_loop_lock(ev);
+    uint64_t received = tcp_socket->m_bytes_received;
+    uint64_t sent = tcp_socket->m_bytes_sent;
+    event_loop_unlock(ev);
+
+    lean_object* pair = lean_alloc_ctor(0, 2, 0);
+    lean_ctor_set(pair, 0, lean_box_uint64(received));
+    lean_ctor_set(pair, 1, lean_box_uint64(sent));
+    return lean_io_result_mk_ok(pair);
+}
 #else
 
 // =======================================
@@ -650,13 +1212,49 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_send(b_obj_arg socket, obj_arg d
     );
 }
 
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_send_all(b_obj_arg socket, obj_arg data, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_cork(b_obj_arg socket, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_flush(b_obj_arg socket, uint8_t uncork, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv(b_obj_arg socket, uint64_t buffer_size, obj_arg /* w */) {
     lean_always_assert(
         false && ("Please build a version of Lean4 with libuv to invoke this.")
     );
 }
 
-extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_bind(b_obj_arg socket, b_obj_arg addr, obj_arg /* w */) {
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv_start(b_obj_arg socket, uint64_t buffer_size, uint32_t capacity, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv_next(b_obj_arg socket, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recycle(b_obj_arg socket, obj_arg buffer, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_bind(b_obj_arg socket, b_obj_arg addr, uint8_t reuse_port, obj_arg /* w */) {
     lean_always_assert(
         false && ("Please build a version of Lean4 with libuv to invoke this.")
     );
@@ -707,6 +1305,11 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_keepalive(b_obj_arg socket, int3
         false && ("Please build a version of Lean4 with libuv to invoke this.")
     );
 }
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_byte_counts(b_obj_arg socket, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
 
 #endif
 }
@@ -20,6 +20,22 @@ void initialize_libuv_tcp_socket();
 
 #ifndef LEAN_EMSCRIPTEN
 
+// State of the continuous receive mode of a TCP socket, see `lean_uv_tcp_recv_start`.
+typedef struct {
+    uint64_t       m_buffer_size;  // Size of the buffers that received data is written to.
+    unsigned       m_capacity;     // Number of chunks that are queued before reading is paused.
+    lean_object**  m_chunks;       // Ring buffer of received results that have not been requested yet.
+    unsigned       m_chunks_head;  // Index of the oldest result in `m_chunks`.
+    unsigned       m_chunks_size;  // Number of results in `m_chunks`.
+    lean_object**  m_pool;         // Exclusive buffers that are reused for receiving data.
+    unsigned       m_pool_size;    // Number of buffers in `m_pool`, at most `m_capacity`.
+    bool           m_reading;      // Whether the socket is reading, i.e., it is neither paused nor finished.
+    bool           m_finished;     // Whether EOF or an error has been received.
+} lean_uv_tcp_stream;
+
+// A pending send, see `tcp.cpp`.
+struct tcp_send_data;
+
 // Structure for managing a single TCP socket object, including promise handling,
 // connection state, and read/write buffers.
 typedef struct {
@@ -29,6 +45,12 @@ typedef struct {
     lean_object*   m_promise_shutdown; // The associated promise for asynchronous results to shutdown the socket.
     lean_object*   m_client;           // Cached client that is going to be used in the next accept.
     lean_object*   m_byte_array;       //  Buffer for storing data received via `recv_start`.
+    lean_uv_tcp_stream* m_stream;      // State of the continuous receive mode, if it was started.
+    bool           m_corked;           // Whether sends are held back until the next `flush`.
+    tcp_send_data* m_corked_sends;     // Sends held back by `cork`, in submission order.
+    tcp_send_data* m_corked_last;      // Last element of `m_corked_sends`.
+    uint64_t       m_bytes_received;   // Number of bytes received so far.
+    uint64_t       m_bytes_sent;       // Number of bytes whose send has completed successfully so far.
 } lean_uv_tcp_socket_object;
 
 // =======================================
@@ -44,13 +66,20 @@ static inline lean_uv_tcp_socket_object* lean_to_uv_tcp_socket(lean_object* o) {
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_new(obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_connect(b_obj_arg socket, b_obj_arg addr, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_send(b_obj_arg socket, obj_arg data, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_send_all(b_obj_arg socket, obj_arg data, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_cork(b_obj_arg socket, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_flush(b_obj_arg socket, uint8_t uncork, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv(b_obj_arg socket, uint64_t buffer_size, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_wait_readable(b_obj_arg socket, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_cancel_recv(b_obj_arg socket, obj_arg /* w */);
-extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_bind(b_obj_arg socket, b_obj_arg addr, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv_start(b_obj_arg socket, uint64_t buffer_size, uint32_t capacity, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recv_next(b_obj_arg socket, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_recycle(b_obj_arg socket, obj_arg buffer, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_bind(b_obj_arg socket, b_obj_arg addr, uint8_t reuse_port, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_listen(b_obj_arg socket, int32_t backlog, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_accept(b_obj_arg socket, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_shutdown(b_obj_arg socket, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_tcp_byte_counts(b_obj_arg socket, obj_arg /* w */);
 
 // =======================================
 // TCP Socket Utility Functions
@@ -19,13 +19,14 @@ void lean_uv_timer_finalizer(void* ptr) {
         lean_dec(timer->m_promise);
     }
 
-    event_loop_lock(&global_ev);
+    event_loop_t* ev = event_loop_of(timer->m_uv_timer);
+    event_loop_lock(ev);
 
     uv_close((uv_handle_t*)timer->m_uv_timer, [](uv_handle_t* handle) {
         free(handle);
     });
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     free(timer);
 }
@@ -79,9 +80,10 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_mk(uint64_t timeout, uint8_t r
 
     uv_timer_t * uv_timer = (uv_timer_t*)malloc(sizeof(uv_timer_t));
 
-    event_loop_lock(&global_ev);
-    int result = uv_timer_init(global_ev.loop, uv_timer);
-    event_loop_unlock(&global_ev);
+    event_loop_t* ev = event_loop_next();
+    event_loop_lock(ev);
+    int result = uv_timer_init(ev->loop, uv_timer);
+    event_loop_unlock(ev);
 
     if (result != 0) {
         free(uv_timer);
@@ -101,6 +103,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_mk(uint64_t timeout, uint8_t r
 /* Std.Internal.UV.Timer.next (timer : @& Timer) : IO (IO.Promise Unit) */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_next(b_obj_arg obj, obj_arg /* w */ ) {
     lean_uv_timer_object * timer = lean_to_uv_timer(obj);
+    event_loop_t* ev = event_loop_of(timer->m_uv_timer);
 
     auto create_promise = []() {
         lean_object * prom_res = lean_io_promise_new(lean_io_mk_world());
@@ -111,7 +114,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_next(b_obj_arg obj, obj_arg /*
         return promise;
     };
 
-    auto setup_timer = [create_promise, obj, timer]() {
+    auto setup_timer = [create_promise, obj, timer, ev]() {
         lean_assert(timer->m_promise == NULL);
         timer->m_promise = create_promise();
         timer->m_state = TIMER_STATE_RUNNING;
@@ -119,7 +122,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_next(b_obj_arg obj, obj_arg /*
         // The event loop must keep the timer alive for the duration of the run time.
         lean_inc(obj);
 
-        event_loop_lock(&global_ev);
+        event_loop_lock(ev);
 
         int result = uv_timer_start(
             timer->m_uv_timer,
@@ -128,7 +131,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_next(b_obj_arg obj, obj_arg /*
             timer->m_repeating ? timer->m_timeout : 0
         );
 
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
 
         if (result != 0) {
             lean_dec(obj);
@@ -181,11 +184,12 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_next(b_obj_arg obj, obj_arg /*
 /* Std.Internal.UV.Timer.reset (timer : @& Timer) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_reset(b_obj_arg obj, obj_arg /* w */ ) {
     lean_uv_timer_object * timer = lean_to_uv_timer(obj);
+    event_loop_t* ev = event_loop_of(timer->m_uv_timer);
 
     if (timer->m_state == TIMER_STATE_RUNNING) {
         lean_assert(timer->m_promise != NULL);
 
-        event_loop_lock(&global_ev);
+        event_loop_lock(ev);
 
         uv_timer_stop(timer->m_uv_timer);
 
@@ -196,7 +200,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_reset(b_obj_arg obj, obj_arg /
             timer->m_repeating ? timer->m_timeout : 0
         );
 
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
 
         if (result != 0) {
             return lean_io_result_mk_error(lean_decode_uv_error(result, NULL));
@@ -211,15 +215,16 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_reset(b_obj_arg obj, obj_arg /
 /* Std.Internal.UV.Timer.stop (timer : @& Timer) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_timer_stop(b_obj_arg obj, obj_arg /* w */) {
     lean_uv_timer_object * timer = lean_to_uv_timer(obj);
+    event_loop_t* ev = event_loop_of(timer->m_uv_timer);
 
     if (timer->m_state == TIMER_STATE_RUNNING) {
         lean_assert(timer->m_promise != NULL);
 
-        event_loop_lock(&global_ev);
+        event_loop_lock(ev);
 
         uv_timer_stop(timer->m_uv_timer);
 
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
 
         timer->m_state = TIMER_STATE_FINISHED;
 
@@ -5,7 +5,9 @@ Author: Sofia Rodrigues
 */
 
 #include "runtime/uv/udp.h"
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 namespace lean {
 
@@ -18,6 +20,32 @@ typedef struct {
     lean_object *socket;
 } udp_send_data;
 
+// Stores all the things needed to send multiple datagrams to a UDP socket.
+typedef struct {
+    event_loop_job   job;      // Must be the first field, the job is submitted to the socket's event loop.
+    lean_object *    promise;
+    lean_object *    data;     // The datagrams, an `Array ByteArray`.
+    lean_object *    socket;
+    sockaddr_storage addr;
+    bool             has_addr;
+    size_t           pending;  // Number of datagrams that are still queued by libuv.
+    int              status;   // The first error that occurred, or 0.
+    uv_udp_send_t *  reqs;     // Requests of the queued datagrams.
+} udp_send_many_data;
+
+// The maximal size of a datagram, `recvmmsg` splits the buffer into chunks of this size.
+static const size_t UDP_DGRAM_MAX_SIZE = 64 * 1024;
+// The maximal number of datagrams libuv receives with a single `recvmmsg` call.
+static const size_t UDP_MMSG_MAX_WIDTH = 20;
+
+static bool udp_using_recvmmsg(uv_udp_t * handle) {
+#if UV_VERSION_HEX >= ((1 << 16) | (39 << 8))
+    return uv_udp_using_recvmmsg(handle);
+#else
+    return false;
+#endif
+}
+
 void lean_uv_udp_socket_finalizer(void* ptr) {
     lean_uv_udp_socket_object* udp_socket = (lean_uv_udp_socket_object*)ptr;
 
@@ -28,15 +56,17 @@ void lean_uv_udp_socket_finalizer(void* ptr) {
     /// inside of it.
     udp_socket->m_uv_udp->data = ptr;
 
-    event_loop_lock(&global_ev);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
+    event_loop_lock(ev);
 
     uv_close((uv_handle_t*)udp_socket->m_uv_udp, [](uv_handle_t* handle) {
         lean_uv_udp_socket_object* udp_socket = (lean_uv_udp_socket_object*)handle->data;
+        free(udp_socket->m_recv_buffer);
         free(udp_socket->m_uv_udp);
         free(udp_socket);
     });
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 }
 
 void initialize_libuv_udp_socket() {
@@ -58,18 +88,28 @@ void initialize_libuv_udp_socket() {
 // =======================================
 // UDP Socket Operations
 
-/* Std.Internal.UV.UDP.Socket.new : IO Socket */
-extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_new(obj_arg /* w */) {
+/* Std.Internal.UV.UDP.Socket.new (batched : Bool) : IO Socket */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_new(uint8_t batched, obj_arg /* w */) {
     lean_uv_udp_socket_object* udp_socket = (lean_uv_udp_socket_object*)malloc(sizeof(lean_uv_udp_socket_object));
 
     udp_socket->m_promise_read = nullptr;
     udp_socket->m_byte_array = nullptr;
+    udp_socket->m_recv_buffer = nullptr;
+    udp_socket->m_recv_buffer_size = 0;
+    udp_socket->m_recv_many_count = 0;
 
     uv_udp_t* uv_udp = (uv_udp_t*)malloc(sizeof(uv_udp_t));
 
-    event_loop_lock(&global_ev);
-    int result = uv_udp_init(global_ev.loop, uv_udp);
-    event_loop_unlock(&global_ev);
+    event_loop_t* ev = event_loop_next();
+    event_loop_lock(ev);
+#if UV_VERSION_HEX >= ((1 << 16) | (39 << 8))
+    // Lets `recvMany` receive multiple datagrams with a single system call where it is supported. Only
+    // batched sockets use it, since `recv` then needs a scratch buffer of the maximal datagram size.
+    int result = uv_udp_init_ex(ev->loop, uv_udp, AF_UNSPEC | (batched ? UV_UDP_RECVMMSG : 0));
+#else
+    int result = uv_udp_init(ev->loop, uv_udp);
+#endif
+    event_loop_unlock(ev);
 
     if (result != 0) {
         free(uv_udp);
@@ -90,13 +130,14 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_new(obj_arg /* w */) {
 /* Std.Internal.UV.UDP.Socket.bind (socket : @& Socket) (addr : @& SocketAddress) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_bind(b_obj_arg socket, b_obj_arg addr, obj_arg /* w */) {
     lean_uv_udp_socket_object* udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
     sockaddr_storage addr_ptr;
     lean_socket_address_to_sockaddr_storage(addr, &addr_ptr);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_bind(udp_socket->m_uv_udp, (sockaddr*)&addr_ptr, UV_UDP_REUSEADDR);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -108,13 +149,14 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_bind(b_obj_arg socket, b_obj_arg
 /* Std.Internal.UV.UDP.Socket.connect (socket : @& Socket) (addr : @& SocketAddress) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_connect(b_obj_arg socket, b_obj_arg addr, obj_arg /* w */) {
     lean_uv_udp_socket_object* udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
     sockaddr_storage addr_ptr;
     lean_socket_address_to_sockaddr_storage(addr, &addr_ptr);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_connect(udp_socket->m_uv_udp, (sockaddr*)&addr_ptr);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -126,6 +168,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_connect(b_obj_arg socket, b_obj_
 /* Std.Internal.UV.UDP.Socket.send (socket : @& Socket) (data : ByteArray) (addr : @& Option SocketAddress) : IO (IO.Promise (Except IO.Error Unit)) */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_send(b_obj_arg socket, obj_arg data, b_obj_arg opt_addr, obj_arg /* w */) {
     lean_uv_udp_socket_object* udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
     size_t data_len = lean_sarray_size(data);
     char* data_str = (char*)lean_sarray_cptr(data);
@@ -155,7 +198,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_send(b_obj_arg socket, obj_arg d
         lean_socket_address_to_sockaddr_storage(addr, addr_ptr);
     }
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
 
     int result = uv_udp_send(send_uv, udp_socket->m_uv_udp, &buf, 1, (sockaddr*)addr_ptr, [](uv_udp_send_t* req, int status) {
         udp_send_data* tup = (udp_send_data*) req->data;
@@ -169,7 +212,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_send(b_obj_arg socket, obj_arg d
         free(req);
     });
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (addr_ptr != nullptr) {
         free(addr_ptr);
@@ -193,15 +236,24 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_send(b_obj_arg socket, obj_arg d
 /* Std.Internal.UV.UDP.Socket.recv (socket : @& Socket) (size : UInt64) : IO (IO.Promise (Except IO.Error (ByteArray × SocketAddress))) */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv(b_obj_arg socket, uint64_t buffer_size, obj_arg /* w */) {
     lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
     // Locking earlier to avoid parallelism issues with m_promise_read.
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
 
     if (udp_socket->m_promise_read != nullptr) {
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
         return lean_io_result_mk_error(lean_decode_uv_error(UV_EALREADY, nullptr));
     }
 
+    if (udp_using_recvmmsg(udp_socket->m_uv_udp) && udp_socket->m_recv_buffer_size < UDP_DGRAM_MAX_SIZE) {
+        // `recvmmsg` receives datagrams into chunks of the maximal datagram size, so the datagram is
+        // received into a scratch buffer of exactly one chunk and copied into the byte array.
+        free(udp_socket->m_recv_buffer);
+        udp_socket->m_recv_buffer = (char*)malloc(UDP_DGRAM_MAX_SIZE);
+        udp_socket->m_recv_buffer_size = UDP_DGRAM_MAX_SIZE;
+    }
+
     lean_object* byte_array = lean_alloc_sarray(1, 0, buffer_size);
     lean_object* promise = lean_promise_new();
     mark_mt(promise);
@@ -216,9 +268,20 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv(b_obj_arg socket, uint64_t
     int result = uv_udp_recv_start(udp_socket->m_uv_udp, [](uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
         lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket((lean_object*)handle->data);
 
-        buf->base = (char*)lean_sarray_cptr(udp_socket->m_byte_array);
-        buf->len = lean_sarray_capacity(udp_socket->m_byte_array);
+        if (udp_using_recvmmsg(udp_socket->m_uv_udp)) {
+            // A single chunk, so that a single datagram is received.
+            buf->base = udp_socket->m_recv_buffer;
+            buf->len = UDP_DGRAM_MAX_SIZE;
+        } else {
+            buf->base = (char*)lean_sarray_cptr(udp_socket->m_byte_array);
+            buf->len = lean_sarray_capacity(udp_socket->m_byte_array);
+        }
     }, [](uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const struct sockaddr *addr, unsigned flags) {
+        if (flags & UV_UDP_MMSG_FREE) {
+            // The scratch buffer is owned by the socket.
+            return;
+        }
+
         uv_udp_recv_stop(handle);
 
         lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket((lean_object*)handle->data);
@@ -229,6 +292,13 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv(b_obj_arg socket, uint64_t
         udp_socket->m_byte_array = nullptr;
 
         if (nread >= 0) {
+            if (buf->base != (char*)lean_sarray_cptr(byte_array)) {
+                // Received into the scratch buffer; the datagram is truncated to the requested size
+                // like `recvmsg` would do.
+                nread = std::min<size_t>(nread, lean_sarray_capacity(byte_array));
+                memcpy(lean_sarray_cptr(byte_array), buf->base, nread);
+            }
+
             lean_sarray_set_size(byte_array, nread);
 
             lean_object* addr_obj;
@@ -259,7 +329,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv(b_obj_arg socket, uint64_t
         udp_socket->m_byte_array = nullptr;
         udp_socket->m_promise_read = nullptr;
 
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
 
         lean_dec(byte_array);
         lean_dec(promise); // The structure does not own it.
@@ -269,7 +339,244 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv(b_obj_arg socket, uint64_t
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
     }
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
+
+    return lean_io_result_mk_ok(promise);
+}
+
+// =======================================
+// Batched UDP Socket Operations
+
+static void udp_send_many_done(udp_send_many_data * send_data) {
+    lean_promise_resolve_with_code(send_data->status, send_data->promise);
+
+    lean_dec(send_data->promise);
+    lean_dec(send_data->socket);
+    lean_dec(send_data->data);
+
+    free(send_data->reqs);
+    free(send_data);
+}
+
+// Sends the datagrams of a `udp_send_many_data` job. It runs with exclusive access to the socket's event loop.
+static void udp_send_many_run(event_loop_job * job) {
+    udp_send_many_data * send_data = (udp_send_many_data*)job;
+    lean_uv_udp_socket_object * udp_socket = lean_to_uv_udp_socket(send_data->socket);
+    sockaddr * addr = send_data->has_addr ? (sockaddr*)&send_data->addr : nullptr;
+
+    size_t count = lean_array_size(send_data->data);
+    std::vector<uv_buf_t> bufs(count);
+    for (size_t i = 0; i < count; i++) {
+        lean_object * datagram = lean_array_get_core(send_data->data, i);
+        bufs[i] = uv_buf_init((char*)lean_sarray_cptr(datagram), lean_sarray_size(datagram));
+    }
+
+    size_t sent = 0;
+#if UV_VERSION_HEX >= ((1 << 16) | (50 << 8))
+    if (count > 0) {
+        // Sends as many datagrams as possible without blocking, with `sendmmsg` where it is supported.
+        std::vector<uv_buf_t*> buf_ptrs(count);
+        std::vector<unsigned int> nbufs(count, 1);
+        std::vector<sockaddr*> addrs(count, addr);
+        for (size_t i = 0; i < count; i++) {
+            buf_ptrs[i] = &bufs[i];
+        }
+        int result = uv_udp_try_send2(udp_socket->m_uv_udp, count, buf_ptrs.data(), nbufs.data(), addrs.data(), 0);
+        // On errors nothing was sent and all the datagrams are queued instead. In particular, a socket that
+        // is not bound yet has no file descriptor, and `uv_udp_send` binds it like `send` does.
+        if (result >= 0) {
+            sent = result;
+        }
+    }
+#endif
+
+    if (sent == count) {
+        udp_send_many_done(send_data);
+        return;
+    }
+
+    // libuv sends the remaining datagrams once the socket is writable again.
+    send_data->pending = count - sent;
+    send_data->reqs = (uv_udp_send_t*)malloc(sizeof(uv_udp_send_t) * (count - sent));
+
+    for (size_t i = sent; i < count; i++) {
+        uv_udp_send_t * req = &send_data->reqs[i - sent];
+        req->data = send_data;
+        int result = uv_udp_send(req, udp_socket->m_uv_udp, &bufs[i], 1, addr, [](uv_udp_send_t * req, int status) {
+            udp_send_many_data * send_data = (udp_send_many_data*)req->data;
+            if (send_data->status == 0) {
+                send_data->status = status;
+            }
+            if (--send_data->pending == 0) {
+                udp_send_many_done(send_data);
+            }
+        });
+        if (result < 0) {
+            // The datagrams from `i` on are not queued.
+            if (send_data->status == 0) {
+                send_data->status = result;
+            }
+            send_data->pending -= count - i;
+            if (send_data->pending == 0) {
+                udp_send_many_done(send_data);
+            }
+            return;
+        }
+    }
+}
+
+/* Std.Internal.UV.UDP.Socket.sendMany (socket : @& Socket) (data : Array ByteArray) (addr : @& Option SocketAddress) : IO (IO.Promise (Except IO.Error Unit)) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_send_many(b_obj_arg socket, obj_arg data, b_obj_arg opt_addr, obj_arg /* w */) {
+    lean_uv_udp_socket_object * udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
+
+    lean_object* promise = lean_promise_new();
+    mark_mt(promise);
+
+    udp_send_many_data * send_data = (udp_send_many_data*)malloc(sizeof(udp_send_many_data));
+    send_data->job.run = udp_send_many_run;
+    send_data->promise = promise;
+    send_data->data = data;
+    send_data->socket = socket;
+    send_data->has_addr = lean_obj_tag(opt_addr) == 1;
+    send_data->pending = 0;
+    send_data->status = 0;
+    send_data->reqs = nullptr;
+
+    if (send_data->has_addr) {
+        lean_socket_address_to_sockaddr_storage(lean_ctor_get(opt_addr, 0), &send_data->addr);
+    }
+
+    // These objects are going to enter the loop and be owned by it
+    lean_inc(promise);
+    lean_inc(socket);
+
+    // Errors are reported through the promise, so we do not need to wait for the event loop.
+    event_loop_submit(ev, &send_data->job);
+
+    return lean_io_result_mk_ok(promise);
+}
+
+// Resolves the pending `recvMany` with `result` and stops receiving.
+static void udp_recv_many_finish(uv_udp_t * handle, lean_object * result) {
+    uv_udp_recv_stop(handle);
+
+    lean_uv_udp_socket_object * udp_socket = lean_to_uv_udp_socket((lean_object*)handle->data);
+    lean_object* promise = udp_socket->m_promise_read;
+
+    udp_socket->m_promise_read = nullptr;
+    udp_socket->m_byte_array = nullptr;
+
+    lean_promise_resolve(result, promise);
+    lean_dec(promise);
+
+    // The event loop does not own the object anymore.
+    lean_dec((lean_object*)handle->data);
+}
+
+static void udp_recv_many_callback(uv_udp_t * handle, ssize_t nread, const uv_buf_t * buf, const struct sockaddr * addr, unsigned flags) {
+    lean_uv_udp_socket_object * udp_socket = lean_to_uv_udp_socket((lean_object*)handle->data);
+    lean_object * datagrams = udp_socket->m_byte_array;
+    bool chunk = (flags & UV_UDP_MMSG_CHUNK) != 0;
+
+    if (flags & UV_UDP_MMSG_FREE) {
+        // The end of the datagrams received by a `recvmmsg` call. The buffer is reused.
+        if (lean_array_size(datagrams) > 0) {
+            udp_recv_many_finish(handle, mk_except_ok(datagrams));
+        }
+        return;
+    }
+
+    if (nread < 0) {
+        if (lean_array_size(datagrams) > 0) {
+            udp_recv_many_finish(handle, mk_except_ok(datagrams));
+        } else {
+            lean_dec(datagrams);
+            udp_recv_many_finish(handle, mk_except_err(lean_decode_uv_error(nread, nullptr)));
+        }
+        return;
+    }
+
+    if (addr == nullptr) {
+        // There is nothing left to read for now.
+        if (!chunk && lean_array_size(datagrams) > 0) {
+            udp_recv_many_finish(handle, mk_except_ok(datagrams));
+        }
+        return;
+    }
+
+    lean_object * byte_array = lean_alloc_sarray(1, nread, nread);
+    memcpy(lean_sarray_cptr(byte_array), buf->base, nread);
+
+    lean_object * prod = lean_alloc_ctor(0, 2, 0);
+    lean_ctor_set(prod, 0, byte_array);
+    lean_ctor_set(prod, 1, lean::mk_option_some(lean_sockaddr_to_socketaddress(addr)));
+
+    datagrams = lean_array_push(datagrams, prod);
+    udp_socket->m_byte_array = datagrams;
+
+    if (!chunk && lean_array_size(datagrams) >= udp_socket->m_recv_many_count) {
+        udp_recv_many_finish(handle, mk_except_ok(datagrams));
+    }
+}
+
+/* Std.Internal.UV.UDP.Socket.recvMany (socket : @& Socket) (count : UInt32) : IO (IO.Promise (Except IO.Error (Array (ByteArray × Option SocketAddress)))) */
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv_many(b_obj_arg socket, uint32_t count, obj_arg /* w */) {
+    lean_uv_udp_socket_object * udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
+
+    if (count == 0) count = 1;
+
+    // Locking earlier to avoid parallelism issues with m_promise_read.
+    event_loop_lock(ev);
+
+    if (udp_socket->m_promise_read != nullptr) {
+        event_loop_unlock(ev);
+        return lean_io_result_mk_error(lean_decode_uv_error(UV_EALREADY, nullptr));
+    }
+
+    // With `recvmmsg`, the number of datagrams received by a single call is given by the size of the buffer.
+    size_t width = udp_using_recvmmsg(udp_socket->m_uv_udp) ? std::min<size_t>(count, UDP_MMSG_MAX_WIDTH) : 1;
+    size_t buffer_size = width * UDP_DGRAM_MAX_SIZE;
+    if (udp_socket->m_recv_buffer_size != buffer_size) {
+        free(udp_socket->m_recv_buffer);
+        udp_socket->m_recv_buffer = (char*)malloc(buffer_size);
+        udp_socket->m_recv_buffer_size = buffer_size;
+    }
+
+    lean_object* promise = lean_promise_new();
+    mark_mt(promise);
+
+    udp_socket->m_byte_array = lean_alloc_array(0, count);
+    udp_socket->m_promise_read = promise;
+    udp_socket->m_recv_many_count = count;
+
+    // The event loop owns the socket.
+    lean_inc(promise);
+    lean_inc(socket);
+
+    int result = uv_udp_recv_start(udp_socket->m_uv_udp, [](uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
+        lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket((lean_object*)handle->data);
+
+        buf->base = udp_socket->m_recv_buffer;
+        buf->len = udp_socket->m_recv_buffer_size;
+    }, udp_recv_many_callback);
+
+    if (result < 0) {
+        lean_dec(udp_socket->m_byte_array);
+        udp_socket->m_byte_array = nullptr;
+        udp_socket->m_promise_read = nullptr;
+
+        event_loop_unlock(ev);
+
+        lean_dec(promise); // The structure does not own it.
+        lean_dec(promise); // We are not going to return it.
+        lean_dec(socket);
+
+        return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
+    }
+
+    event_loop_unlock(ev);
 
     return lean_io_result_mk_ok(promise);
 }
@@ -277,12 +584,13 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv(b_obj_arg socket, uint64_t
 /* Std.Internal.UV.UDP.Socket.waitReadable (socket : @& Socket) : IO (IO.Promise (Except IO.Error Unit)) */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_wait_readable(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_udp_socket_object* udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
     // Locking earlier to avoid parallelism issues with m_promise_read.
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
 
     if (udp_socket->m_promise_read != nullptr) {
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
         return lean_io_result_mk_error(lean_decode_uv_error(UV_EALREADY, nullptr));
     }
 
@@ -326,7 +634,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_wait_readable(b_obj_arg socket,
     if (result < 0) {
         udp_socket->m_promise_read = nullptr;
 
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
 
         lean_dec(promise); // The structure does not own it.
         lean_dec(promise); // We are not going to return it.
@@ -335,7 +643,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_wait_readable(b_obj_arg socket,
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
     }
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     return lean_io_result_mk_ok(promise);
 }
@@ -343,11 +651,12 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_wait_readable(b_obj_arg socket,
 /* Std.Internal.UV.UDP.Socket.cancelRecv (socket : @& Socket) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_cancel_recv(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_udp_socket_object* udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
 
     if (udp_socket->m_promise_read == nullptr) {
-        event_loop_unlock(&global_ev);
+        event_loop_unlock(ev);
         return lean_io_result_mk_ok(lean_box(0));
     }
 
@@ -365,7 +674,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_cancel_recv(b_obj_arg socket, ob
 
     lean_dec((lean_object*)udp_socket);
 
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     return lean_io_result_mk_ok(lean_box(0));
 }
@@ -377,13 +686,14 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_cancel_recv(b_obj_arg socket, ob
 /* Std.Internal.UV.UDP.Socket.getPeerName (socket : @& Socket) : IO SocketAddress */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_getpeername(b_obj_arg socket, obj_arg /* w */) {
     lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
     struct sockaddr_storage addr_storage;
     int addr_len = sizeof(addr_storage);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_getpeername(udp_socket->m_uv_udp, (struct sockaddr*)&addr_storage, &addr_len);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -397,13 +707,14 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_getpeername(b_obj_arg socket, ob
 /* Std.Internal.UV.UDP.Socket.getSockName (socket : @& Socket) : IO SocketAddress */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_getsockname(b_obj_arg socket) {
     lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
     struct sockaddr_storage addr_storage;
     int addr_len = sizeof(addr_storage);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_getsockname(udp_socket->m_uv_udp, (struct sockaddr*)&addr_storage, &addr_len);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -416,10 +727,11 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_getsockname(b_obj_arg socket) {
 /* Std.Internal.UV.UDP.Socket.setBroadcast (socket : @& Socket) (on : Bool) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_broadcast(b_obj_arg socket, uint8_t enable, obj_arg /* w */) {
     lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_set_broadcast(udp_socket->m_uv_udp, enable);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -431,10 +743,11 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_broadcast(b_obj_arg socket,
 /* Std.Internal.UV.UDP.Socket.setMulticastLoop (socket : @& Socket) (on : Bool) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_multicast_loop(b_obj_arg socket, uint8_t enable, obj_arg /* w */) {
     lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_set_multicast_loop(udp_socket->m_uv_udp, enable);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -446,10 +759,11 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_multicast_loop(b_obj_arg soc
 /* Std.Internal.UV.UDP.Socket.setMulticastTTL (socket : @& Socket) (ttl : UInt32) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_multicast_ttl(b_obj_arg socket, uint32_t ttl, obj_arg /* w */) {
     lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_set_multicast_ttl(udp_socket->m_uv_udp, ttl);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -461,6 +775,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_multicast_ttl(b_obj_arg sock
 /* Std.Internal.UV.UDP.Socket.setMembership (socket : @& Socket) (multicastAddr : @& IpAddr) (interfaceAddr : @& Option IpAddr) (membership : UInt8) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_membership(b_obj_arg socket, b_obj_arg multicast_addr, b_obj_arg interface_addr, uint8_t membership, obj_arg /* w */) {
     lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
     char multicast_addr_str[INET_ADDRSTRLEN];
     lean_ip_addr_ntop(multicast_addr, multicast_addr_str, sizeof(multicast_addr_str));
@@ -473,9 +788,9 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_membership(b_obj_arg socket,
         lean_ip_addr_ntop(interface_addr_obj, interface_addr_str, sizeof(interface_addr_str));
     }
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_set_membership(udp_socket->m_uv_udp, multicast_addr_str, is_interface_null ? nullptr : interface_addr_str, (uv_membership)membership);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -487,13 +802,14 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_membership(b_obj_arg socket,
 /* Std.Internal.UV.UDP.Socket.setMulticastInterface (socket : @& Socket) (interfaceAddr : @& IPAddr) : IO Unit */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_multicast_interface(b_obj_arg socket, b_obj_arg interface_addr, obj_arg /* w */) {
     lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
     char interface_addr_str[INET_ADDRSTRLEN];
     lean_ip_addr_ntop(interface_addr, interface_addr_str, sizeof(interface_addr_str));
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_set_multicast_interface(udp_socket->m_uv_udp, interface_addr_str);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -505,10 +821,11 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_multicast_interface(b_obj_ar
 /* Std.Internal.UV.UDP.Socket.setTTL (socket : @& Socket) (ttl : UInt32) : IO Unit  */
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_ttl(b_obj_arg socket, uint32_t ttl, obj_arg /* w */) {
     lean_uv_udp_socket_object *udp_socket = lean_to_uv_udp_socket(socket);
+    event_loop_t* ev = event_loop_of(udp_socket->m_uv_udp);
 
-    event_loop_lock(&global_ev);
+    event_loop_lock(ev);
     int result = uv_udp_set_ttl(udp_socket->m_uv_udp, ttl);
-    event_loop_unlock(&global_ev);
+    event_loop_unlock(ev);
 
     if (result < 0) {
         return lean_io_result_mk_error(lean_decode_uv_error(result, nullptr));
@@ -519,7 +836,7 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_set_ttl(b_obj_arg socket, uint32
 
 #else
 
-extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_new(obj_arg /* w */) {
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_new(uint8_t batched, obj_arg /* w */) {
     lean_always_assert(
         false && ("Please build a version of Lean4 with libuv to invoke this.")
     );
@@ -549,6 +866,18 @@ extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv(b_obj_arg socket, uint64_t
     );
 }
 
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_send_many(b_obj_arg socket, obj_arg data, b_obj_arg opt_addr, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv_many(b_obj_arg socket, uint32_t count, obj_arg /* w */) {
+    lean_always_assert(
+        false && ("Please build a version of Lean4 with libuv to invoke this.")
+    );
+}
+
 // =======================================
 // UDP Socket Utility Functions
 
@@ -25,7 +25,10 @@ void initialize_libuv_udp_socket();
 typedef struct {
     uv_udp_t *      m_uv_udp;           // LibUV UDP handle.
     lean_object *   m_promise_read;     // The associated promise for asynchronous results for reading from the socket.
-    lean_object *   m_byte_array;       // The received data stored.
+    lean_object *   m_byte_array;       // The received data stored, or the datagrams received so far by `recv_many`.
+    char *          m_recv_buffer;      // Buffer that `recv_many` receives datagrams into before copying them.
+    size_t          m_recv_buffer_size; // Size of `m_recv_buffer`.
+    unsigned        m_recv_many_count;  // Maximal number of datagrams returned by the pending `recv_many`.
 } lean_uv_udp_socket_object;
 
 // =======================================
@@ -38,11 +41,13 @@ static inline lean_uv_udp_socket_object* lean_to_uv_udp_socket(lean_object * o)
 // =======================================
 // UDP Socket Operations
 
-extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_new(obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_new(uint8_t batched, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_bind(b_obj_arg socket, b_obj_arg addr, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_connect(b_obj_arg socket, b_obj_arg addr, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_send(b_obj_arg socket, obj_arg data, b_obj_arg opt_addr, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv(b_obj_arg socket, uint64_t buffer_size, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_send_many(b_obj_arg socket, obj_arg data, b_obj_arg opt_addr, obj_arg /* w */);
+extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_recv_many(b_obj_arg socket, uint32_t count, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_wait_readable(b_obj_arg socket, obj_arg /* w */);
 extern "C" LEAN_EXPORT lean_obj_res lean_uv_udp_cancel_recv(b_obj_arg socket, obj_arg /* w */);
 
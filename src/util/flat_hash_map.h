@@ -0,0 +1,351 @@
+/*
+Copyright (c) 2026 Lean FRO. All rights reserved.
+Released under Apache 2.0 license as described in the file LICENSE.
+*/
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <utility>
+
+namespace lean {
+namespace flat_hash_detail {
+/* Control bytes in the style of SwissTable: a full slot stores the 7 low bits of the
+   (mixed) hash code of its key, so that most probes are rejected without touching the
+   slot array at all. */
+typedef signed char ctrl_t;
+constexpr ctrl_t ctrl_empty    = -128;
+constexpr ctrl_t ctrl_deleted  = -2;
+constexpr ctrl_t ctrl_sentinel = -1;
+
+inline bool is_full(ctrl_t c) { return c >= 0; }
+
+inline ctrl_t * empty_group() {
+    static ctrl_t g_sentinel = ctrl_sentinel;
+    return &g_sentinel;
+}
+
+/* Most of our hash functions (pointer addresses, `expr_hash`) have weak low bits,
+   but the table uses the low bits to select the initial probe position. */
+inline uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+template<typename Key> struct identity_key {
+    Key const & operator()(Key const & k) const { return k; }
+};
+
+template<typename Pair> struct first_key {
+    typename Pair::first_type const & operator()(Pair const & p) const { return p.first; }
+};
+}
+
+/**
+   \brief Open-addressing hash table with linear probing over a flat slot array.
+
+   In contrast to `std::unordered_map`, inserting does not allocate a node per element, and
+   a lookup inspects one byte of metadata per probed slot before comparing keys. The price
+   is that iterators and references are invalidated by any insertion that triggers a rehash,
+   so users must not keep them across calls that may insert into the same table.
+
+   We use it for the caches in the kernel and in `library/`, where elements are inserted
+   frequently, rarely erased, and the whole table is thrown away at the end. */
+template<typename Slot, typename Key, typename KeyOf, typename Hash, typename KeyEqual>
+class flat_hash_table {
+    typedef flat_hash_detail::ctrl_t ctrl_t;
+    ctrl_t * m_ctrl;
+    Slot *   m_slots;
+    size_t   m_capacity;    // zero or a power of two
+    size_t   m_size;
+    size_t   m_growth_left; // number of empty (not deleted) slots we may still fill
+    Hash     m_hash;
+    KeyEqual m_eq;
+
+    static size_t max_load(size_t capacity) { return capacity - capacity / 8; }
+
+    static size_t h1(uint64_t h) { return static_cast<size_t>(h >> 7); }
+    static ctrl_t h2(uint64_t h) { return static_cast<ctrl_t>(h & 0x7f); }
+
+    uint64_t hash_of(Key const & k) const { return flat_hash_detail::mix(static_cast<uint64_t>(m_hash(k))); }
+
+    void init(size_t capacity) {
+        m_capacity    = capacity;
+        m_size        = 0;
+        m_growth_left = max_load(capacity);
+        m_ctrl        = new ctrl_t[capacity + 1];
+        std::fill(m_ctrl, m_ctrl + capacity, flat_hash_detail::ctrl_empty);
+        m_ctrl[capacity] = flat_hash_detail::ctrl_sentinel;
+        m_slots       = static_cast<Slot *>(::operator new(sizeof(Slot) * capacity));
+    }
+
+    void init_empty() {
+        m_ctrl = flat_hash_detail::empty_group();
+        m_slots = nullptr;
+        m_capacity = m_size = m_growth_left = 0;
+    }
+
+    void destroy() {
+        if (m_capacity == 0) return;
+        for (size_t i = 0; i < m_capacity; i++) {
+            if (flat_hash_detail::is_full(m_ctrl[i]))
+                m_slots[i].~Slot();
+        }
+        delete[] m_ctrl;
+        ::operator delete(m_slots);
+    }
+
+    /* Return the index of the first empty or deleted slot in the probe sequence of `h`. */
+    size_t find_free(uint64_t h) const {
+        size_t mask = m_capacity - 1;
+        size_t i    = h1(h) & mask;
+        while (flat_hash_detail::is_full(m_ctrl[i]))
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    size_t find_index(Key const & k, uint64_t h) const {
+        if (m_capacity == 0) return m_capacity;
+        size_t mask = m_capacity - 1;
+        size_t i    = h1(h) & mask;
+        ctrl_t c2   = h2(h);
+        while (true) {
+            ctrl_t c = m_ctrl[i];
+            if (c == c2 && m_eq(KeyOf()(m_slots[i]), k))
+                return i;
+            if (c == flat_hash_detail::ctrl_empty)
+                return m_capacity;
+            i = (i + 1) & mask;
+        }
+    }
+
+    void resize(size_t new_capacity) {
+        ctrl_t * old_ctrl  = m_ctrl;
+        Slot *   old_slots = m_slots;
+        size_t   old_cap   = m_capacity;
+        init(new_capacity);
+        for (size_t i = 0; i < old_cap; i++) {
+            if (flat_hash_detail::is_full(old_ctrl[i])) {
+                uint64_t h = hash_of(KeyOf()(old_slots[i]));
+                size_t j   = find_free(h);
+                m_ctrl[j]  = h2(h);
+                new (m_slots + j) Slot(std::move(old_slots[i]));
+                old_slots[i].~Slot();
+                m_size++;
+            }
+        }
+        m_growth_left -= m_size;
+        if (old_cap != 0) {
+            delete[] old_ctrl;
+            ::operator delete(old_slots);
+        }
+    }
+
+    void rehash_for_insert() {
+        if (m_capacity == 0) {
+            resize(16);
+        } else if (m_size * 2 <= max_load(m_capacity)) {
+            // mostly tombstones: clean up without growing
+            resize(m_capacity);
+        } else {
+            resize(m_capacity * 2);
+        }
+    }
+
+    /* Return the slot index for key `k`, and whether the slot still needs to be constructed. */
+    std::pair<size_t, bool> find_or_prepare_insert(Key const & k) {
+        uint64_t h = hash_of(k);
+        size_t i   = find_index(k, h);
+        if (i != m_capacity)
+            return std::make_pair(i, false);
+        if (m_growth_left == 0)
+            rehash_for_insert();
+        i = find_free(h);
+        if (m_ctrl[i] == flat_hash_detail::ctrl_empty)
+            m_growth_left--;
+        m_ctrl[i] = h2(h);
+        m_size++;
+        return std::make_pair(i, true);
+    }
+
+    template<typename S> class iterator_core {
+        friend class flat_hash_table;
+        ctrl_t const * m_it_ctrl;
+        S *            m_it_slot;
+        void skip() {
+            while (!flat_hash_detail::is_full(*m_it_ctrl) && *m_it_ctrl != flat_hash_detail::ctrl_sentinel) {
+                ++m_it_ctrl;
+                ++m_it_slot;
+            }
+        }
+        iterator_core(ctrl_t const * c, S * s):m_it_ctrl(c), m_it_slot(s) {}
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef S                         value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef S *                       pointer;
+        typedef S &                       reference;
+        iterator_core():m_it_ctrl(nullptr), m_it_slot(nullptr) {}
+        template<typename S2> iterator_core(iterator_core<S2> const & it):m_it_ctrl(it.m_it_ctrl), m_it_slot(it.m_it_slot) {} // NOLINT
+        S & operator*() const { return *m_it_slot; }
+        S * operator->() const { return m_it_slot; }
+        iterator_core & operator++() { ++m_it_ctrl; ++m_it_slot; skip(); return *this; }
+        iterator_core operator++(int) { iterator_core r = *this; ++*this; return r; }
+        bool operator==(iterator_core const & o) const { return m_it_ctrl == o.m_it_ctrl; }
+        bool operator!=(iterator_core const & o) const { return m_it_ctrl != o.m_it_ctrl; }
+        template<typename S2> friend class iterator_core;
+    };
+
+public:
+    typedef Key                      key_type;
+    typedef Slot                     value_type;
+    typedef iterator_core<Slot>       iterator;
+    typedef iterator_core<Slot const> const_iterator;
+
+    explicit flat_hash_table(size_t capacity = 0, Hash const & h = Hash(), KeyEqual const & eq = KeyEqual()):
+        m_hash(h), m_eq(eq) {
+        init_empty();
+        if (capacity > 0) reserve(capacity);
+    }
+    flat_hash_table(flat_hash_table const & s):m_hash(s.m_hash), m_eq(s.m_eq) {
+        init_empty();
+        reserve(s.m_size);
+        for (Slot const & v : s) insert(v);
+    }
+    flat_hash_table(flat_hash_table && s):
+        m_ctrl(s.m_ctrl), m_slots(s.m_slots), m_capacity(s.m_capacity), m_size(s.m_size),
+        m_growth_left(s.m_growth_left), m_hash(s.m_hash), m_eq(s.m_eq) {
+        s.init_empty();
+    }
+    ~flat_hash_table() { destroy(); }
+
+    flat_hash_table & operator=(flat_hash_table const & s) {
+        if (this != &s) {
+            flat_hash_table tmp(s);
+            swap(tmp);
+        }
+        return *this;
+    }
+    flat_hash_table & operator=(flat_hash_table && s) {
+        clear();
+        swap(s);
+        return *this;
+    }
+
+    void swap(flat_hash_table & s) {
+        std::swap(m_ctrl, s.m_ctrl);
+        std::swap(m_slots, s.m_slots);
+        std::swap(m_capacity, s.m_capacity);
+        std::swap(m_size, s.m_size);
+        std::swap(m_growth_left, s.m_growth_left);
+        std::swap(m_hash, s.m_hash);
+        std::swap(m_eq, s.m_eq);
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t capacity() const { return m_capacity; }
+
+    iterator begin() { iterator it(m_ctrl, m_slots); it.skip(); return it; }
+    iterator end() { return iterator(m_ctrl + m_capacity, m_slots + m_capacity); }
+    const_iterator begin() const { const_iterator it(m_ctrl, m_slots); it.skip(); return it; }
+    const_iterator end() const { return const_iterator(m_ctrl + m_capacity, m_slots + m_capacity); }
+
+    void clear() {
+        destroy();
+        init_empty();
+    }
+
+    /* Make sure `n` elements can be stored without rehashing. */
+    void reserve(size_t n) {
+        size_t cap = m_capacity == 0 ? 16 : m_capacity;
+        while (max_load(cap) < n) cap *= 2;
+        if (cap != m_capacity || m_growth_left + m_size < n)
+            resize(cap);
+    }
+
+    iterator find(Key const & k) {
+        size_t i = find_index(k, hash_of(k));
+        return iterator(m_ctrl + i, m_slots + i);
+    }
+    const_iterator find(Key const & k) const {
+        size_t i = find_index(k, hash_of(k));
+        return const_iterator(m_ctrl + i, m_slots + i);
+    }
+    size_t count(Key const & k) const { return find_index(k, hash_of(k)) != m_capacity; }
+
+    std::pair<iterator, bool> insert(Slot const & v) {
+        auto r = find_or_prepare_insert(KeyOf()(v));
+        if (r.second) new (m_slots + r.first) Slot(v);
+        return std::make_pair(iterator(m_ctrl + r.first, m_slots + r.first), r.second);
+    }
+    std::pair<iterator, bool> insert(Slot && v) {
+        auto r = find_or_prepare_insert(KeyOf()(v));
+        if (r.second) new (m_slots + r.first) Slot(std::move(v));
+        return std::make_pair(iterator(m_ctrl + r.first, m_slots + r.first), r.second);
+    }
+    template<typename... Args> std::pair<iterator, bool> emplace(Args &&... args) {
+        return insert(Slot(std::forward<Args>(args)...));
+    }
+
+    /* Construct the slot from `k` and `args` only if `k` is not already in the table. */
+    template<typename... Args> std::pair<iterator, bool> try_emplace(Key const & k, Args &&... args) {
+        auto r = find_or_prepare_insert(k);
+        if (r.second) new (m_slots + r.first) Slot(std::piecewise_construct, std::forward_as_tuple(k),
+                                                   std::forward_as_tuple(std::forward<Args>(args)...));
+        return std::make_pair(iterator(m_ctrl + r.first, m_slots + r.first), r.second);
+    }
+
+    void erase(iterator it) {
+        size_t i = it.m_it_slot - m_slots;
+        m_slots[i].~Slot();
+        m_ctrl[i] = flat_hash_detail::ctrl_deleted;
+        m_size--;
+    }
+    size_t erase(Key const & k) {
+        iterator it = find(k);
+        if (it == end()) return 0;
+        erase(it);
+        return 1;
+    }
+};
+
+/** \brief Flat replacement for `std::unordered_map`. Elements are `std::pair<Key, T>`, with a
+    non-const key so that they can be moved on rehash. */
+template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class flat_hash_map : public flat_hash_table<std::pair<Key, T>, Key, flat_hash_detail::first_key<std::pair<Key, T>>, Hash, KeyEqual> {
+    typedef flat_hash_table<std::pair<Key, T>, Key, flat_hash_detail::first_key<std::pair<Key, T>>, Hash, KeyEqual> table;
+public:
+    typedef T mapped_type;
+    using table::table;
+    T & operator[](Key const & k) { return this->try_emplace(k).first->second; }
+};
+
+/** \brief Flat replacement for `std::unordered_set`. */
+template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using flat_hash_set = flat_hash_table<Key, Key, flat_hash_detail::identity_key<Key>, Hash, KeyEqual>;
+
+/** \brief Hash for caches keyed by object identity. Objects are at least 8-byte aligned. */
+struct ptr_hash {
+    size_t operator()(void const * p) const { return reinterpret_cast<size_t>(p) >> 3; }
+};
+
+/** \brief Hash for caches keyed by object identity and a binder offset (e.g., `replace_rec_fn`). */
+struct ptr_offset_hash {
+    template<typename P>
+    size_t operator()(std::pair<P *, unsigned> const & p) const {
+        return (reinterpret_cast<size_t>(p.first) >> 3) ^ (static_cast<size_t>(p.second) * 0x9e3779b9u);
+    }
+};
+
+template<typename P, typename T> using ptr_hash_map = flat_hash_map<P *, T, ptr_hash>;
+template<typename P>             using ptr_hash_set = flat_hash_set<P *, ptr_hash>;
+template<typename P, typename T> using ptr_offset_hash_map = flat_hash_map<std::pair<P *, unsigned>, T, ptr_offset_hash>;
+template<typename P>             using ptr_offset_hash_set = flat_hash_set<std::pair<P *, unsigned>, ptr_offset_hash>;
+}
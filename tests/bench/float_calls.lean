@@ -0,0 +1,23 @@
+/-!
+Numeric loops calling native functions with unboxed parameters and results (`Float.sqrt`, `Float.ceil`,
+`Float.ofInt`, `mixHash`). When interpreted, this measures the cost of crossing the interpreter/native boundary;
+compare with `-Dinterpreter.unboxed_calls=false`.
+-/
+
+def floats (n : Nat) : Float := Id.run do
+  let mut acc : Float := 0
+  for i in [0:n] do
+    let x := Float.ofInt i
+    acc := acc + x.sqrt.floor + (x * 0.5).ceil
+  return acc
+
+def hashes (n : Nat) : UInt64 := Id.run do
+  let mut h : UInt64 := 7
+  for i in [0:n] do
+    h := mixHash h i.toUInt64
+  return h
+
+def main (args : List String) : IO Unit := do
+  let n := args.head!.toNat!
+  IO.println (floats n).toUInt64
+  IO.println (hashes n)
@@ -0,0 +1,64 @@
+import Std.Internal.Async
+
+/-
+Hashes all files of a directory tree with `DIRS * FILES` files of `SIZE` bytes each, once with
+`IO.FS.readBinFile` on dedicated tasks, which block task manager threads for each system call, and once
+with `File.readFile`, which runs the system calls on the libuv thread pool.
+-/
+
+open Std.Internal.IO Async
+
+def DIRS : Nat := 100
+def FILES : Nat := 200
+def SIZE : Nat := 16 * 1024
+
+def setup (root : System.FilePath) : IO Unit := do
+  for d in [0:DIRS] do
+    let dir := root / s!"dir{d}"
+    IO.FS.createDirAll dir
+    for f in [0:FILES] do
+      IO.FS.writeBinFile (dir / s!"file{f}") (ByteArray.mk (Array.replicate SIZE (d + f).toUInt8))
+
+partial def walkSync (path : System.FilePath) : IO (Array System.FilePath) := do
+  let mut files := #[]
+  for entry in ← path.readDir do
+    if ← entry.path.isDir then
+      files := files ++ (← walkSync entry.path)
+    else
+      files := files.push entry.path
+  return files
+
+def hashSync (root : System.FilePath) : IO UInt64 := do
+  let tasks ← (← walkSync root).mapM fun path =>
+    IO.asTask (prio := .dedicated) (hash <$> IO.FS.readBinFile path)
+  tasks.foldlM (init := 0) fun acc task => return mixHash acc (← IO.ofExcept task.get)
+
+partial def walkAsync (path : System.FilePath) : IO (Array System.FilePath) := do
+  let entries ← (← File.readDir path).block
+  let types ← entries.mapM fun entry => return (entry, ← File.metadata entry.path)
+  let mut files := #[]
+  for (entry, metadata) in types do
+    if (← metadata.block).type == .dir then
+      files := files ++ (← walkAsync entry.path)
+    else
+      files := files.push entry.path
+  return files
+
+def hashAsync (root : System.FilePath) : IO UInt64 := do
+  let tasks ← (← walkAsync root).mapM fun path => return (← File.readFile path).map hash
+  tasks.foldlM (init := 0) fun acc task => return mixHash acc (← task.block)
+
+def run (name : String) (root : System.FilePath) (f : System.FilePath → IO UInt64) : IO UInt64 := do
+  let t1 ← IO.monoMsNow
+  let h ← f root
+  let t2 ← IO.monoMsNow
+  let time : Float := (t2 - t1).toFloat / 1000.0
+  IO.println s!"{name}: {time}"
+  return h
+
+def main : IO Unit := IO.FS.withTempDir fun root => do
+  setup root
+  let h₁ ← run "readBinFile" root hashSync
+  let h₂ ← run "File.readFile" root hashAsync
+  unless h₁ == h₂ do
+    throw <| IO.userError "hashes differ"
@@ -0,0 +1,111 @@
+// Microbenchmark for the access patterns of the kernel caches, comparing
+// `std::unordered_map/set` against `lean::flat_hash_map/set`.
+//
+//   c++ -O2 -std=c++14 -I ../../src kernel_cache_cpp.cpp -o kernel_cache_cpp && ./kernel_cache_cpp 2000000
+//
+// * `ptr`:    `replace_rec_fn`/`for_each_fn`: keyed by object address (and binder offset),
+//             lookup followed by an insert on a miss, roughly one third hits.
+// * `struct`: `type_checker::state` caches (`m_infer_type`, `m_whnf`, ...): keyed by a
+//             term with a cached hash code and a comparatively expensive equality test.
+// * `pair`:   `m_failure`: a set of term pairs that is mostly queried.
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "util/flat_hash_map.h"
+
+struct term {
+    unsigned           m_hash;
+    std::vector<int>   m_args;
+};
+
+struct term_ref {
+    term const * m_ptr;
+    bool operator==(term_ref const & o) const { return m_ptr == o.m_ptr || (m_ptr->m_hash == o.m_ptr->m_hash && m_ptr->m_args == o.m_ptr->m_args); }
+};
+
+struct term_hash {
+    size_t operator()(term_ref const & t) const { return t.m_ptr->m_hash; }
+};
+
+struct term_pair_hash {
+    size_t operator()(std::pair<term_ref, term_ref> const & p) const { return p.first.m_ptr->m_hash * 31 + p.second.m_ptr->m_hash; }
+};
+
+struct ptr_offset_std_hash {
+    size_t operator()(std::pair<void *, unsigned> const & p) const { return ((size_t)p.first >> 3) ^ p.second; }
+};
+
+template<typename F> void run(char const * name, F && f) {
+    auto start = std::chrono::steady_clock::now();
+    size_t r = f();
+    auto end = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::milli>(end - start).count() << "ms (" << r << ")\n";
+}
+
+template<typename Map> size_t bench_ptr(std::vector<void *> const & keys) {
+    Map m;
+    size_t hits = 0;
+    for (unsigned i = 0; i < keys.size(); i++) {
+        auto k = std::make_pair(keys[i], i % 4);
+        auto it = m.find(k);
+        if (it != m.end()) { hits += it->second; continue; }
+        m.insert(std::make_pair(k, 1u));
+    }
+    return hits;
+}
+
+template<typename Map> size_t bench_struct(std::vector<term_ref> const & keys) {
+    Map m;
+    size_t hits = 0;
+    for (unsigned i = 0; i < keys.size(); i++) {
+        auto it = m.find(keys[i]);
+        if (it != m.end()) { hits++; continue; }
+        m.insert(std::make_pair(keys[i], keys[(i + 1) % keys.size()]));
+    }
+    return hits;
+}
+
+template<typename Set> size_t bench_pair(std::vector<term_ref> const & keys) {
+    Set s;
+    size_t hits = 0;
+    for (unsigned i = 0; i + 1 < keys.size(); i += 16)
+        s.insert(std::make_pair(keys[i], keys[i + 1]));
+    for (unsigned i = 0; i + 1 < keys.size(); i++)
+        hits += s.count(std::make_pair(keys[i], keys[i + 1]));
+    return hits;
+}
+
+int main(int argc, char ** argv) {
+    if (argc != 2) {
+        std::cout << "invalid number of arguments\n";
+        return 1;
+    }
+    unsigned n = atoi(argv[1]);
+    std::mt19937 gen(42);
+    std::vector<term> terms(n / 3 + 1);
+    for (unsigned i = 0; i < terms.size(); i++) {
+        terms[i].m_hash = gen();
+        terms[i].m_args.assign(4 + gen() % 8, static_cast<int>(i));
+    }
+    std::vector<void *> ptr_keys(n);
+    std::vector<term_ref> term_keys(n);
+    for (unsigned i = 0; i < n; i++) {
+        term & t = terms[gen() % terms.size()];
+        ptr_keys[i]  = &t;
+        term_keys[i] = term_ref{&t};
+    }
+
+    typedef std::pair<void *, unsigned> ptr_key;
+    typedef std::pair<term_ref, term_ref> term_pair;
+    run("ptr    std::unordered_map", [&]() { return bench_ptr<std::unordered_map<ptr_key, unsigned, ptr_offset_std_hash>>(ptr_keys); });
+    run("ptr    lean::flat_hash_map", [&]() { return bench_ptr<lean::ptr_offset_hash_map<void, unsigned>>(ptr_keys); });
+    run("struct std::unordered_map", [&]() { return bench_struct<std::unordered_map<term_ref, term_ref, term_hash>>(term_keys); });
+    run("struct lean::flat_hash_map", [&]() { return bench_struct<lean::flat_hash_map<term_ref, term_ref, term_hash>>(term_keys); });
+    run("pair   std::unordered_set", [&]() { return bench_pair<std::unordered_set<term_pair, term_pair_hash>>(term_keys); });
+    run("pair   lean::flat_hash_set", [&]() { return bench_pair<lean::flat_hash_set<term_pair, term_pair_hash>>(term_keys); });
+    return 0;
+}
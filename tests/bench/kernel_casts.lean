@@ -0,0 +1,17 @@
+/-!
+Kernel type checking of terms with many nested casts. Each `▸` elaborates to an `Eq.rec`/`Eq.mpr`
+application whose motive is a lambda, so inferring the type of such an application instantiates the
+motive in head position.
+-/
+
+syntax "casts% " num ident term:max : term
+
+macro_rules
+  | `(casts% $n $h $x) =>
+    match n.getNat with
+    | 0 => `($x)
+    | n + 1 => `($h ▸ casts% $(Lean.Syntax.mkNumLit (toString n)) $h $x)
+
+set_option maxRecDepth 10000 in
+def casts (n : Nat) (h : n = n) (x : Fin (n + 1)) : Fin (n + 1) :=
+  casts% 400 h x
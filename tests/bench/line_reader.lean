@@ -0,0 +1,44 @@
+/-
+Counts the lines and bytes of a 2 GiB log file with `IO.FS.Handle.getLine`, `IO.FS.LineReader.readLine?`
+and `IO.FS.LineReader.foldLines`.
+-/
+
+def SIZE : Nat := 2 * 1024 * 1024 * 1024
+
+def setup (path : System.FilePath) : IO Unit := do
+  let mut chunk := ""
+  for i in [0:100000] do
+    chunk := chunk ++ s!"2026-10-18T12:00:{i % 60} INFO [worker-{i % 16}] request {i} handled in {i % 1000}ms\n"
+  IO.FS.withFile path .write fun h => do
+    for _ in [0:SIZE / chunk.utf8ByteSize] do
+      h.putStr chunk
+
+partial def getLineCount (h : IO.FS.Handle) (lines bytes : Nat) : IO (Nat × Nat) := do
+  let line ← h.getLine
+  if line.isEmpty then
+    return (lines, bytes)
+  getLineCount h (lines + 1) (bytes + line.utf8ByteSize)
+
+partial def readLineCount (r : IO.FS.LineReader) (lines bytes : Nat) : IO (Nat × Nat) := do
+  let some line ← r.readLine? | return (lines, bytes)
+  readLineCount r (lines + 1) (bytes + line.utf8ByteSize + 1)
+
+def run (name : String) (path : System.FilePath) (f : IO.FS.Handle → IO (Nat × Nat)) : IO (Nat × Nat) := do
+  let h ← IO.FS.Handle.mk path .read
+  let t1 ← IO.monoMsNow
+  let r ← f h
+  let t2 ← IO.monoMsNow
+  let time : Float := (t2 - t1).toFloat / 1000.0
+  IO.println s!"{name}: {time}"
+  return r
+
+def main : IO Unit := IO.FS.withTempDir fun dir => do
+  let path := dir / "log.txt"
+  setup path
+  let r₁ ← run "getLine" path (getLineCount · 0 0)
+  let r₂ ← run "readLine?" path fun h => do readLineCount (← IO.FS.LineReader.mk h) 0 0
+  let r₃ ← run "foldLines" path fun h => do
+    (← IO.FS.LineReader.mk h).foldLines (0, 0) fun (lines, bytes) line =>
+      return (lines + 1, bytes + line.utf8ByteSize + 1)
+  unless r₁ == r₂ && r₂ == r₃ do
+    throw <| IO.userError s!"results differ: {r₁} {r₂} {r₃}"
@@ -0,0 +1,48 @@
+/-
+Reads a 2 GiB file and checks that it is valid UTF-8, once with `IO.FS.readFile` (which reads the
+file into a `ByteArray` and copies it into a `String`), and once with `IO.FS.mmapFile` (which
+validates the mapped file in place).
+-/
+
+def SIZE : Nat := 2 * 1024 * 1024 * 1024
+def CHUNK : Nat := 64 * 1024 * 1024
+
+def setup (path : System.FilePath) : IO Unit := do
+  let line := "The quick brown fox jumps over the lazy dog. Über café naïve façade.\n".toUTF8
+  let mut chunk := ByteArray.emptyWithCapacity CHUNK
+  while chunk.size + line.size ≤ CHUNK do
+    chunk := chunk ++ line
+  IO.FS.withFile path .write fun h => do
+    for _ in [0:SIZE / chunk.size] do
+      h.write chunk
+
+def run (name : String) (f : IO Nat) : IO Unit := do
+  let t1 ← IO.monoMsNow
+  let size ← f
+  let t2 ← IO.monoMsNow
+  let time : Float := (t2 - t1).toFloat / 1000.0
+  IO.println s!"{name}: {time}"
+  unless size > 0 do
+    throw <| IO.userError "empty file"
+
+def main : IO Unit := IO.FS.withTempDir fun dir => do
+  let path := dir / "big.txt"
+  setup path
+  run "readBinFile" do
+    let data ← IO.FS.readBinFile path
+    unless String.validateUTF8 data do
+      throw <| IO.userError "invalid UTF-8"
+    return data.size
+  run "readFile" do
+    return (← IO.FS.readFile path).utf8ByteSize
+  run "mmapFile" do
+    let m ← IO.FS.mmapFile path
+    m.advise .sequential
+    unless m.validateUTF8 do
+      throw <| IO.userError "invalid UTF-8"
+    return m.size
+  run "mmapFile.toString?" do
+    let m ← IO.FS.mmapFile path
+    m.advise .sequential
+    let some s := m.toString? | throw <| IO.userError "invalid UTF-8"
+    return s.utf8ByteSize
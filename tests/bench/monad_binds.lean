@@ -0,0 +1,27 @@
+/-!
+Monadic code that is not specialized to a concrete monad, so that binds, `modify`, and `read` are calls
+of closures through `lean_apply_*`. Every transformer layer adds partial applications that are
+extended one argument at a time or applied to more arguments than they take.
+-/
+
+@[noinline, nospecialize]
+def step [Monad m] [MonadStateOf Nat m] [MonadReaderOf Nat m] (i : Nat) : m Unit := do
+  let k ← read
+  modify fun s => (s * 31 + i * k) % 1000000007
+
+@[noinline, nospecialize]
+def loop [Monad m] [MonadStateOf Nat m] [MonadReaderOf Nat m] (n : Nat) : m Unit := do
+  for i in [0:n] do
+    step i
+
+def main : List String → IO Unit
+  | [n] => do
+    let n := n.toNat!
+    let (_, s) := (loop (m := StateT Nat (ReaderT Nat Id)) n).run 0 |>.run 3
+    IO.println s
+    match (loop (m := StateT Nat (ReaderT Nat (ExceptT String Id))) n).run 0 |>.run 5 with
+    | .ok (_, s) => IO.println s
+    | .error e => throw <| IO.userError e
+    let (_, s) ← (loop (m := StateRefT Nat (ReaderT Nat IO)) n).run 0 |>.run 7
+    IO.println s
+  | _ => throw <| IO.userError "give number of iterations"
@@ -0,0 +1,38 @@
+/-
+Reads 500 MB from the standard output of a child process with `IO.Process.output`, and with a loop of
+1 KiB `IO.FS.Handle.read`s as `IO.FS.Handle.readBinToEnd` used to do.
+-/
+
+def SIZE : Nat := 500 * 1000 * 1000
+
+def child : IO.Process.SpawnArgs :=
+  { cmd := "head", args := #["-c", toString SIZE, "/dev/zero"] }
+
+partial def readChunks (h : IO.FS.Handle) (acc : ByteArray) : IO ByteArray := do
+  let buf ← h.read 1024
+  if buf.isEmpty then
+    return acc
+  readChunks h (acc ++ buf)
+
+def run (name : String) (act : IO Nat) : IO Unit := do
+  let t1 ← IO.monoMsNow
+  let size ← act
+  let t2 ← IO.monoMsNow
+  assert! size == SIZE
+  let time : Float := (t2 - t1).toFloat / 1000.0
+  IO.println s!"{name}: {time}"
+
+def main : IO Unit := do
+  run "1 KiB reads" do
+    let child ← IO.Process.spawn { child with stdout := .piped }
+    let data ← readChunks child.stdout .empty
+    discard child.wait
+    return data.size
+  run "readBinToEnd" do
+    let child ← IO.Process.spawn { child with stdout := .piped }
+    let data ← child.stdout.readBinToEnd
+    discard child.wait
+    return data.size
+  run "output" do
+    -- also validates UTF-8
+    return (← IO.Process.output child).stdout.utf8ByteSize
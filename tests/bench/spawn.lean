@@ -0,0 +1,32 @@
+/-
+Spawns 1000 short-lived processes, first one after another with `IO.Process.output`, then
+concurrently with the event loop based `Std.Internal.IO.Process.output`. The resident set size of
+the parent is inflated first, since that is what makes `fork` slow.
+-/
+import Std.Internal.Async
+
+def N : Nat := 1000
+
+def run (name : String) (act : IO Unit) : IO Unit := do
+  let t1 ← IO.monoMsNow
+  act
+  let t2 ← IO.monoMsNow
+  let time : Float := (t2 - t1).toFloat / 1000.0
+  IO.println s!"{name}: {time}"
+
+def main : IO Unit := do
+  -- about 1 GiB of live data
+  let ballast := (List.range 64).map fun i => ByteArray.mk (Array.replicate (16 * 1024 * 1024) i.toUInt8)
+  run "sequential output" do
+    for _ in [0:N] do
+      let out ← IO.Process.output { cmd := "true" }
+      assert! out.exitCode == 0
+  run "concurrent output" do
+    let tasks ← (List.range N).mapM fun _ => Std.Internal.IO.Process.output { cmd := "true" }
+    for task in tasks do
+      let out ← task.block
+      assert! out.exitCode == 0
+  let usage ← Std.Internal.IO.Process.getResourceUsage
+  IO.println s!"peak rss (KiB): {usage.peakResidentSetSizeKb}"
+  -- keep the ballast alive until the end
+  assert! ballast.length == 64
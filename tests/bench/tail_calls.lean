@@ -0,0 +1,30 @@
+/-!
+Long loops made of mutually tail-recursive functions. When interpreted, every iteration is a tail call of
+another function, which must not grow the native stack.
+-/
+
+mutual
+partial def collatzEven (n steps : Nat) : Nat :=
+  if n % 2 == 0 then collatzEven (n / 2) (steps + 1) else collatzOdd n steps
+
+partial def collatzOdd (n steps : Nat) : Nat :=
+  if n == 1 then steps else collatzEven (3 * n + 1) (steps + 1)
+end
+
+mutual
+partial def ping (n : Nat) (acc : UInt64) : UInt64 :=
+  if n == 0 then acc else pong (n - 1) (acc * 6364136223846793005 + 1442695040888963407)
+
+partial def pong (n : Nat) (acc : UInt64) : UInt64 :=
+  if n == 0 then acc else ping (n - 1) (acc ^^^ (acc >>> 29))
+end
+
+partial def sumSteps (i n acc : Nat) : Nat :=
+  if i > n then acc else sumSteps (i + 1) n (acc + collatzEven i 0)
+
+def main : List String → IO Unit
+  | [n] => do
+    let n := n.toNat!
+    IO.println (sumSteps 1 n 0)
+    IO.println (ping (n * 10) 0)
+  | _ => throw <| IO.userError "give number of iterations"
@@ -0,0 +1,62 @@
+import Std.Internal.Async
+import Std.Internal.UV
+
+/-
+Loopback echo benchmark for the libuv event loops: one echo server per event loop listens on the
+same port (using `SO_REUSEPORT` if there is more than one event loop), and `CLIENTS` clients each send
+`MESSAGES` messages of `SIZE` bytes and wait for their echo. Run with `LEAN_NUM_UV_LOOPS` set to
+compare a single event loop with several ones.
+-/
+
+open Std.Internal.IO Async
+open Std.Net
+
+def CLIENTS : Nat := 16
+def MESSAGES : Nat := 2_000
+def SIZE : Nat := 4096
+
+partial def echo (client : TCP.Socket.Client) : Async Unit := do
+  match ← await (← client.recv? 65536) with
+  | none => pure ()
+  | some data =>
+    await (← client.send data)
+    echo client
+
+partial def serve (server : TCP.Socket.Server) : Async Unit := do
+  let client ← await (← server.accept)
+  background (echo client)
+  serve server
+
+partial def recvExactly (client : TCP.Socket.Client) (size : Nat) : Async Unit := do
+  if size > 0 then
+    match ← await (← client.recv? size.toUInt64) with
+    | none => throw <| IO.userError "connection closed by the server"
+    | some data => recvExactly client (size - data.size)
+
+def runClient (addr : SocketAddress) : Async Unit := do
+  let client ← TCP.Socket.Client.mk
+  await (← client.connect addr)
+  client.noDelay
+  let data := ByteArray.mk (Array.replicate SIZE 42)
+  for _ in *...MESSAGES do
+    await (← client.send data)
+    recvExactly client SIZE
+  await (← client.shutdown)
+
+def main : IO Unit := do
+  let loops ← Std.Internal.UV.Loop.count
+  let addr : SocketAddress := SocketAddressV4.mk (.ofParts 127 0 0 1) 9321
+  for _ in *...loops do
+    let server ← TCP.Socket.Server.mk
+    server.bind addr (reusePort := loops > 1)
+    server.listen 128
+    discard <| (serve server).toIO
+  let t1 ← IO.monoMsNow
+  let clients ← (List.range CLIENTS).mapM fun _ => (runClient addr).toIO
+  for client in clients do
+    client.block
+  let t2 ← IO.monoMsNow
+  let time : Float := (t2 - t1).toFloat / 1000.0
+  IO.println s!"tcp_echo_{loops}_loops: {time}"
+  -- the servers keep accepting connections
+  IO.Process.exit 0
@@ -0,0 +1,76 @@
+import Std.Internal.Async
+
+/-
+Small-message RPC over loopback: a client sends `REQUESTS` requests consisting of a 4-byte header and
+a small body to an echo server and waits for the responses, either
+* `concat`: one `send` of the concatenated header and body per request,
+* `sendAll`: one vectored `sendAll` of header and body per request, or
+* `cork`: batches of `BATCH` requests sent with `sendAll` between `cork` and `flush`.
+-/
+
+open Std.Internal.IO Async
+open Std.Net
+
+def REQUESTS : Nat := 100_000
+def BATCH : Nat := 16
+
+def header : ByteArray := ⟨#[0, 0, 0, 32]⟩
+def body : ByteArray := ByteArray.mk (Array.replicate 32 42)
+def REQUEST_SIZE : Nat := header.size + body.size
+
+partial def echo (client : TCP.Socket.Client) : Async Unit := do
+  match ← await (← client.recv? 65536) with
+  | none => pure ()
+  | some data =>
+    await (← client.send data)
+    echo client
+
+partial def recvExactly (client : TCP.Socket.Client) (size : Nat) : Async Unit := do
+  if size > 0 then
+    match ← await (← client.recv? size.toUInt64) with
+    | none => throw <| IO.userError "connection closed by the server"
+    | some data => recvExactly client (size - data.size)
+
+def concat (client : TCP.Socket.Client) : Async Unit := do
+  for _ in *...REQUESTS do
+    await (← client.send (header ++ body))
+    recvExactly client REQUEST_SIZE
+
+def sendAll (client : TCP.Socket.Client) : Async Unit := do
+  for _ in *...REQUESTS do
+    await (← client.sendAll #[header, body])
+    recvExactly client REQUEST_SIZE
+
+def cork (client : TCP.Socket.Client) : Async Unit := do
+  for _ in *...(REQUESTS / BATCH) do
+    client.cork
+    let mut sent := #[]
+    for _ in *...BATCH do
+      sent := sent.push (← client.sendAll #[header, body])
+    client.flush
+    for task in sent do
+      await task
+    recvExactly client (BATCH * REQUEST_SIZE)
+
+def run (name : String) (port : UInt16) (rpc : TCP.Socket.Client → Async Unit) : IO Unit := do
+  let addr : SocketAddress := SocketAddressV4.mk (.ofParts 127 0 0 1) port
+  let server ← TCP.Socket.Server.mk
+  server.bind addr
+  server.listen 1
+  let accepted ← server.accept
+  let client ← TCP.Socket.Client.mk
+  (← client.connect addr).block
+  client.noDelay
+  let served ← (echo (← accepted.block)).toIO
+  let t1 ← IO.monoMsNow
+  (← (rpc client).toIO).block
+  let t2 ← IO.monoMsNow
+  (← client.shutdown).block
+  served.block
+  let time : Float := (t2 - t1).toFloat / 1000.0
+  IO.println s!"{name}: {time}"
+
+def main : IO Unit := do
+  run "concat" 9324 concat
+  run "sendAll" 9325 sendAll
+  run "cork" 9326 cork
@@ -0,0 +1,58 @@
+import Std.Internal.Async
+
+/-
+Loopback throughput of a large TCP transfer, received with `recv?`, which allocates a new buffer and
+starts and stops reading for every chunk, and with the continuous receive mode (`recvStart`), which
+keeps reading and reuses the buffers given back by `recycle`. The argument is the size of the
+transfer in MiB.
+-/
+
+open Std.Internal.IO Async
+open Std.Net
+
+def CHUNK : UInt64 := 65536
+
+def sendAll (client : TCP.Socket.Client) (mib : Nat) : Async Unit := do
+  let data := ByteArray.mk (Array.replicate (1024 * 1024) 42)
+  for _ in *...mib do
+    await (← client.send data)
+  await (← client.shutdown)
+
+partial def recvAll (client : TCP.Socket.Client) (received : Nat) : Async Nat := do
+  match ← await (← client.recv? CHUNK) with
+  | none => return received
+  | some data => recvAll client (received + data.size)
+
+partial def streamAll (client : TCP.Socket.Client) (received : Nat) : Async Nat := do
+  match ← await (← client.recvNext?) with
+  | none => return received
+  | some data =>
+    let received := received + data.size
+    client.recycle data
+    streamAll client received
+
+def run (name : String) (port : UInt16) (mib : Nat) (recv : TCP.Socket.Client → Async Nat) : IO Unit := do
+  let addr : SocketAddress := SocketAddressV4.mk (.ofParts 127 0 0 1) port
+  let server ← TCP.Socket.Server.mk
+  server.bind addr
+  server.listen 1
+  let accepted ← server.accept
+  let sender ← TCP.Socket.Client.mk
+  (← sender.connect addr).block
+  let receiver ← accepted.block
+  let t1 ← IO.monoMsNow
+  let sent ← (sendAll sender mib).toIO
+  let received ← (← (recv receiver).toIO).block
+  sent.block
+  let t2 ← IO.monoMsNow
+  unless received == mib * 1024 * 1024 do
+    throw <| IO.userError s!"{name}: received {received} bytes"
+  let time : Float := (t2 - t1).toFloat / 1000.0
+  IO.println s!"{name}: {time}"
+
+def main (args : List String) : IO Unit := do
+  let mib := args[0]!.toNat!
+  run "recv" 9322 mib (recvAll · 0)
+  run "recvStart" 9323 mib fun client => do
+    client.recvStart CHUNK
+    streamAll client 0
@@ -0,0 +1,57 @@
+import Std.Internal.Async
+
+/-
+Loopback UDP packets per second: a client sends `PACKETS` small datagrams to a server in bursts of
+`BURST`, and the server acknowledges each burst once it has received it, either
+* `single`: one `send` and one `recv` per datagram, or
+* `batched`: one `sendMany` and as few `recvMany` as possible per burst.
+-/
+
+open Std.Internal.IO Async
+open Std.Net
+
+def PACKETS : Nat := 1_000_000
+def BURST : Nat := 32
+
+def payload : ByteArray := ByteArray.mk (Array.replicate 64 42)
+
+def single (client server : UDP.Socket) (serverAddr clientAddr : SocketAddress) : IO Unit := do
+  for _ in *...(PACKETS / BURST) do
+    for _ in *...BURST do
+      (← client.send payload serverAddr).block
+    for _ in *...BURST do
+      discard <| (← server.recv 1024).block
+    (← server.send payload clientAddr).block
+    discard <| (← client.recv 1024).block
+
+partial def recvBurst (server : UDP.Socket) (remaining : Nat) : IO Unit := do
+  if remaining > 0 then
+    let datagrams ← (← server.recvMany remaining.toUInt32).block
+    recvBurst server (remaining - datagrams.size)
+
+def batched (client server : UDP.Socket) (serverAddr clientAddr : SocketAddress) : IO Unit := do
+  let burst := Array.replicate BURST payload
+  for _ in *...(PACKETS / BURST) do
+    (← client.sendMany burst serverAddr).block
+    recvBurst server BURST
+    (← server.send payload clientAddr).block
+    discard <| (← client.recv 1024).block
+
+def run (name : String) (port : UInt16)
+    (bench : UDP.Socket → UDP.Socket → SocketAddress → SocketAddress → IO Unit) : IO Unit := do
+  let serverAddr : SocketAddress := SocketAddressV4.mk (.ofParts 127 0 0 1) port
+  let clientAddr : SocketAddress := SocketAddressV4.mk (.ofParts 127 0 0 1) (port + 1)
+  -- Only the server receives with `recvMany`.
+  let server ← UDP.Socket.mk (batched := name == "batched")
+  server.bind serverAddr
+  let client ← UDP.Socket.mk
+  client.bind clientAddr
+  let t1 ← IO.monoMsNow
+  bench client server serverAddr clientAddr
+  let t2 ← IO.monoMsNow
+  let time : Float := (t2 - t1).toFloat / 1000.0
+  IO.println s!"{name}: {time}"
+
+def main : IO Unit := do
+  run "single" 9330 single
+  run "batched" 9332 batched
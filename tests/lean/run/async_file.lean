@@ -0,0 +1,77 @@
+import Std.Internal.Async
+
+open Std.Internal.IO Async
+
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+    throw <| IO.userError <|
+      s!"expected '{expected}', got '{actual}'"
+
+def readWrite : IO Unit := IO.FS.withTempDir fun dir => do
+  let path := dir / "data.txt"
+  let contents := "Hello, file system!".toUTF8
+  (← File.writeFile path contents).block
+
+  assertBEq (← (← File.readFile path).block).toList contents.toList
+  assertBEq (← (← File.metadata path).block).byteSize contents.size.toUInt64
+  assertBEq ((← (← File.metadata dir).block).type == .dir) true
+
+  let file ← (← File.open path .readWrite).block
+  assertBEq (String.fromUTF8! (← (← file.read 5).block)) "Hello"
+  assertBEq (String.fromUTF8! (← (← file.read 5 (some 7)).block)) "file "
+  (← file.write "FILE".toUTF8 (some 7)).block
+  (← file.fsync).block
+  assertBEq (String.fromUTF8! (← (← file.read 100 (some 7)).block)) "FILE system!"
+  assertBEq (← (← file.read 100 (some 100)).block).size 0
+  (← file.close).block
+
+  try
+    discard <| file.read 5
+    throw <| IO.userError "read after close should fail"
+  catch
+    | .invalidArgument .. => pure ()
+    | err => throw err
+
+def closeAfterWrites : IO Unit := IO.FS.withTempDir fun dir => do
+  let path := dir / "data.txt"
+  let file ← (← File.open path .write).block
+  let line (i : Nat) := s!"{i + 10}\n"
+  -- The writes run concurrently, so each one has its own offset.
+  let writes ← (List.range 50).mapM fun i => file.write (line i).toUTF8 (some (3 * i).toUInt64)
+  let close ← file.close
+  for write in writes do
+    write.block
+  close.block
+  assertBEq (← IO.FS.readFile path) (String.join ((List.range 50).map line))
+
+def directories : IO Unit := IO.FS.withTempDir fun dir => do
+  for i in [0:20] do
+    IO.FS.writeFile (dir / s!"file{i}") (toString i)
+  IO.FS.createDir (dir / "sub")
+
+  let entries ← (← File.readDir dir).block
+  assertBEq entries.size 21
+  assertBEq (entries.all (·.root == dir)) true
+  for i in [0:20] do
+    let entry := entries.find? (·.fileName == s!"file{i}") |>.get!
+    assertBEq (String.fromUTF8! (← (← File.readFile entry.path).block)) (toString i)
+
+def errors : IO Unit := IO.FS.withTempDir fun dir => do
+  try
+    discard <| (← File.readFile (dir / "missing")).block
+    throw <| IO.userError "reading a missing file should fail"
+  catch
+    | .noFileOrDirectory .. => pure ()
+    | err => throw err
+
+  try
+    discard <| (← File.open dir.toString .write).block
+    throw <| IO.userError "writing a directory should fail"
+  catch
+    | .inappropriateType .. => pure ()
+    | err => throw err
+
+#eval readWrite
+#eval closeAfterWrites
+#eval directories
+#eval errors
@@ -0,0 +1,55 @@
+import Std.Internal.Async
+import Std.Internal.UV
+import Std.Net.Addr
+
+open Std.Internal.IO Async
+open Std.Net
+
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+    throw <| IO.userError <|
+      s!"expected '{expected}', got '{actual}'"
+
+partial def recvAll (client : TCP.Socket.Client) (received : ByteArray) : Async ByteArray := do
+  match ← await (← client.recv? 1024) with
+  | none => return received
+  | some data => recvAll client (received ++ data)
+
+def sum (ms : Array Std.Internal.UV.Loop.Metrics) (f : Std.Internal.UV.Loop.Metrics → UInt64) : UInt64 :=
+  ms.foldl (· + f ·) 0
+
+def metrics (addr : SocketAddress) : IO Unit := do
+  Std.Internal.UV.Loop.configure { accumulateIdleTime := true }
+
+  let server ← TCP.Socket.Server.mk
+  server.bind addr
+  server.listen 128
+  let accepted ← server.accept
+
+  let client ← TCP.Socket.Client.mk
+  (← client.connect addr).block
+  let peer ← accepted.block
+
+  let before ← Std.Internal.UV.Loop.metrics
+  assertBEq before.size (← Std.Internal.UV.Loop.count)
+  for m in before do
+    assertBEq m.lockWaits.size 24
+    assertBEq m.jobDelays.size 24
+  -- the listening server is active
+  assertBEq (before.any fun m => m.activeHandles.any (·.1 == "tcp")) true
+
+  (← client.send (ByteArray.mk (Array.replicate 1000 0))).block
+  (← client.sendAll #["abc".toUTF8, "de".toUTF8]).block
+  (← client.shutdown).block
+  let received ← (← (recvAll peer .empty).toIO).block
+  assertBEq received.size 1005
+
+  assertBEq (← client.byteCounts) (0, 1005)
+  assertBEq (← peer.byteCounts) (1005, 0)
+
+  let after ← Std.Internal.UV.Loop.metrics
+  assertBEq (sum after (·.jobs) > sum before (·.jobs)) true
+  assertBEq (sum after (·.iterations) ≥ sum before (·.iterations)) true
+  assertBEq (sum after (·.idleTimeNs) ≥ sum before (·.idleTimeNs)) true
+
+#eval metrics (SocketAddressV4.mk (.ofParts 127 0 0 1) 8088)
@@ -0,0 +1,58 @@
+import Std.Internal.Async
+
+open Std.Internal.IO
+
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+  throw <| IO.userError <|
+    s!"expected '{expected}', got '{actual}'"
+
+def shell (script : String) : IO.Process.SpawnArgs :=
+  { cmd := "sh", args := #["-c", script] }
+
+def checkOutput (output : IO.Process.SpawnArgs → IO IO.Process.Output) : IO Unit := do
+  let out ← output (shell "echo out; echo err >&2; exit 3")
+  assertBEq out.exitCode 3
+  assertBEq out.stdout "out\n"
+  assertBEq out.stderr "err\n"
+
+  let out ← output { shell "echo $FOO-$BAR" with env := #[("FOO", some "foo"), ("BAR", none)] }
+  assertBEq out.stdout "foo-\n"
+
+  let out ← output { shell "pwd" with cwd := some "/" }
+  assertBEq out.stdout "/\n"
+
+  let out ← output { shell "echo $$" with setsid := true }
+  assertBEq out.exitCode 0
+
+  let out ← output (shell "kill -9 $$")
+  assertBEq out.exitCode (128 + 9)
+
+def spawnAndOutput : IO Unit := do
+  -- `IO.Process.spawn` and the event loop based `Process.output` behave the same
+  checkOutput IO.Process.output
+  checkOutput fun args => do (← Process.output args).block
+
+  -- a missing executable is reported by the exit code of the child for `IO.Process.spawn`...
+  let out ← IO.Process.output { cmd := "does-not-exist-lean" }
+  assertBEq out.exitCode 255
+  -- ... and as an error by `Process.output`
+  try
+    discard <| (← Process.output { cmd := "does-not-exist-lean" }).block
+    throw <| IO.userError "spawning a missing executable should fail"
+  catch
+    | .noFileOrDirectory fname .. => assertBEq fname "does-not-exist-lean"
+    | err => throw err
+
+def manyChildren : IO Unit := do
+  let tasks ← (List.range 100).mapM fun i => Process.output (shell s!"echo {i}")
+  for task in tasks, i in List.range 100 do
+  let out ← task.block
+  assertBEq out.stdout s!"{i}\n"
+
+  -- larger outputs are read completely
+  let out ← (← Process.output (shell "yes | head -c 1000000")).block
+  assertBEq out.stdout.utf8ByteSize 1000000
+
+#eval if System.Platform.isWindows then pure () else spawnAndOutput
+#eval if System.Platform.isWindows then pure () else manyChildren
@@ -0,0 +1,60 @@
+import Std.Internal.Async
+import Std.Internal.UV
+import Std.Net.Addr
+
+open Std.Internal.IO Async
+open Std.Net
+
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+    throw <| IO.userError <|
+      s!"expected '{expected}', got '{actual}'"
+
+/-- Robert sends a few messages and closes the connection. -/
+def runRobert (server : TCP.Socket.Server) : Async Unit := do
+  let joe ← await (← server.accept)
+  for i in *...100 do
+    await (← joe.send (String.toUTF8 s!"{i};"))
+  await (← joe.shutdown)
+
+/-- Joe receives everything using the continuous receive mode with a small queue. -/
+partial def runJoe (client : TCP.Socket.Client) (received : ByteArray) : Async ByteArray := do
+  match ← await (← client.recvNext?) with
+  | none => return received
+  | some data =>
+    assertBEq (data.size ≤ 8) true
+    let received := received ++ data
+    client.recycle data
+    runJoe client received
+
+def recvStream (addr : SocketAddress) : IO Unit := do
+  let server ← TCP.Socket.Server.mk
+  server.bind addr
+  server.listen 128
+
+  let serverTask ← (runRobert server).toIO
+
+  let joe ← TCP.Socket.Client.mk
+  (← joe.connect addr).block
+  joe.recvStart 8 (capacity := 2)
+  -- Chunks received into a larger recycled buffer are still at most 8 bytes long.
+  joe.recycle (ByteArray.emptyWithCapacity 1024)
+
+  -- Single receives are not supported in this mode.
+  try
+    discard <| (← joe.recv? 8).block
+    throw <| IO.userError "recv? after recvStart should fail"
+  catch
+    | .invalidArgument .. => pure ()
+    | err => throw err
+
+  let received ← (← (runJoe joe .empty).toIO).block
+  serverTask.block
+
+  let expected := String.join ((List.range 100).map (s!"{·};"))
+  assertBEq (String.fromUTF8? received) (some expected)
+
+  -- The stream has ended.
+  assertBEq (← (← joe.recvNext?).block) none
+
+#eval recvStream (SocketAddressV4.mk (.ofParts 127 0 0 1) 8086)
@@ -0,0 +1,34 @@
+import Std.Internal.Async
+import Std.Internal.UV
+import Std.Net.Addr
+
+open Std.Internal.IO Async
+open Std.Net
+
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+    throw <| IO.userError <|
+      s!"expected '{expected}', got '{actual}'"
+
+def reusePort (addr : SocketAddress) : IO Unit := do
+  assertBEq ((← Std.Internal.UV.Loop.count) ≥ 1) true
+
+  -- Both servers listen on the same address, the kernel distributes the connections among them.
+  let server1 ← TCP.Socket.Server.mk
+  server1.bind addr (reusePort := true)
+  server1.listen 128
+
+  let server2 ← TCP.Socket.Server.mk
+  server2.bind addr (reusePort := true)
+  server2.listen 128
+
+  assertBEq (← server1.getSockName).port addr.port
+  assertBEq (← server2.getSockName).port addr.port
+
+  let client ← TCP.Socket.Client.mk
+  let task ← client.connect addr
+  task.block
+
+  assertBEq (← client.getPeerName).port addr.port
+
+#eval reusePort (SocketAddressV4.mk (.ofParts 127 0 0 1) 8085)
@@ -0,0 +1,47 @@
+import Std.Internal.Async
+import Std.Internal.UV
+import Std.Net.Addr
+
+open Std.Internal.IO Async
+open Std.Net
+
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+    throw <| IO.userError <|
+      s!"expected '{expected}', got '{actual}'"
+
+partial def recvAll (client : TCP.Socket.Client) (received : ByteArray) : Async ByteArray := do
+  match ← await (← client.recv? 1024) with
+  | none => return received
+  | some data => recvAll client (received ++ data)
+
+/-- Joe sends vectored and corked messages. -/
+def runJoe (client : TCP.Socket.Client) : Async Unit := do
+  await (← client.sendAll #["he".toUTF8, "llo".toUTF8, ByteArray.empty, " ".toUTF8])
+  await (← client.sendAll #[])
+  client.cork
+  let first ← client.send "rob".toUTF8
+  let second ← client.sendAll #["er".toUTF8, "t!".toUTF8]
+  client.flush
+  await first
+  await second
+  await (← client.shutdown)
+
+def sendAll (addr : SocketAddress) : IO Unit := do
+  let server ← TCP.Socket.Server.mk
+  server.bind addr
+  server.listen 128
+
+  let accepted ← server.accept
+
+  let joe ← TCP.Socket.Client.mk
+  (← joe.connect addr).block
+
+  let robert ← accepted.block
+  let joeTask ← (runJoe joe).toIO
+  let received ← (← (recvAll robert .empty).toIO).block
+  joeTask.block
+
+  assertBEq (String.fromUTF8? received) (some "hello robert!")
+
+#eval sendAll (SocketAddressV4.mk (.ofParts 127 0 0 1) 8087)
@@ -0,0 +1,41 @@
+import Std.Internal.Async
+import Std.Internal.UV
+import Std.Net.Addr
+
+open Std.Internal.IO.Async.UDP
+open Std.Internal.IO.Async
+open Std.Net
+
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+    throw <| IO.userError <|
+      s!"expected '{expected}', got '{actual}'"
+
+partial def recvAll (server : UDP.Socket) (count : Nat) (received : Array String) : IO (Array String) := do
+  if received.size ≥ count then
+    return received
+  let datagrams ← (← server.recvMany 64).block
+  assertBEq (datagrams.size > 0) true
+  recvAll server count (received ++ datagrams.map (String.fromUTF8! ·.1))
+
+def batched (addr : UInt16 → SocketAddress) (first second : UInt16) : IO Unit := do
+  let server ← UDP.Socket.mk (batched := true)
+  server.bind (addr first)
+
+  let client ← UDP.Socket.mk
+  client.bind (addr second)
+
+  let messages := (Array.range 10).map (s!"message {·}")
+  (← client.sendMany (messages.map String.toUTF8) (addr first)).block
+  (← client.sendMany #[] (addr first)).block
+
+  let received ← recvAll server messages.size #[]
+  assertBEq received messages
+
+  -- an unbound socket is bound by the first send
+  let unbound ← UDP.Socket.mk
+  (← unbound.sendMany (messages.map String.toUTF8) (addr first)).block
+  let received ← recvAll server messages.size #[]
+  assertBEq received messages
+
+#eval batched (SocketAddress.v4 ∘ SocketAddressV4.mk (.ofParts 127 0 0 1)) 9005 9006
@@ -0,0 +1,28 @@
+import Lean
+open Lean
+
+def pgoCollatz (n : Nat) : Nat :=
+  if n % 2 == 0 then n / 2 else 3 * n + 1
+
+/--
+info: true
+true
+true
+-/
+#guard_msgs in
+#eval show CoreM Unit from do
+  let out ← IO.ofExcept <| IR.emitC (← getEnv) `emitCPGO (pgoGenerate := true)
+  IO.println ((out.splitOn "lean_pgo_register(&_l_pgo);").length == 2)
+  IO.println ((out.splitOn "_l_pgo_counts_emitCPGO[0]++;").length == 2)
+  IO.println ((out.splitOn "\"f:l_pgoCollatz\"").length == 2)
+
+/--
+info: false
+false
+-/
+#guard_msgs in
+#eval show CoreM Unit from do
+  let out ← IO.ofExcept <| IR.emitC (← getEnv) `emitCPGO
+  IO.println ((out.splitOn "_l_pgo").length > 1)
+  -- branches without hints are emitted as before
+  IO.println ((out.splitOn "if ((").length > 1)
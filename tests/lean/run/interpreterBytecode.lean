@@ -0,0 +1,56 @@
+/-!
+Exercises the lowering of IR to register bytecode in the interpreter; each result is compared against the IR
+tree-walking interpreter.
+-/
+
+def sumTR (n acc : Nat) : Nat :=
+  if n = 0 then acc else sumTR (n - 1) (acc + n)
+
+def classify : UInt8 → String
+  | 0 => "zero"
+  | 1 => "one"
+  | 7 => "seven"
+  | _ => "many"
+
+def floats (n : Nat) : Float := Id.run do
+  let mut x : Float := 0.5
+  for i in [0:n] do
+    x := x * 1.5 + i.toFloat
+  return x
+
+structure P where
+  a : UInt32
+  b : Float
+  c : List Nat
+
+def update (p : P) (xs : Array Nat) : P × Array Nat :=
+  ({ p with a := p.a + 1, c := xs.toList ++ p.c }, xs.push p.c.length)
+
+def run : IO Unit := do
+  IO.println (sumTR 100000 0)
+  IO.println ((List.range 10).map (fun i => classify i.toUInt8))
+  IO.println (floats 10)
+  let (p, xs) := update { a := 41, b := 1.0, c := [1, 2] } #[3]
+  IO.println (p.a, p.b, p.c, xs)
+  IO.println ((List.range 20).foldl (fun acc i => if i % 3 = 0 then acc.push i else acc) #[])
+
+/--
+info: 5000050000
+[zero, one, many, many, many, many, many, seven, many, many]
+235.492676
+(42, 1.000000, [3, 1, 2], #[3, 2])
+#[0, 3, 6, 9, 12, 15, 18]
+-/
+#guard_msgs in
+#eval run
+
+/--
+info: 5000050000
+[zero, one, many, many, many, many, many, seven, many, many]
+235.492676
+(42, 1.000000, [3, 1, 2], #[3, 2])
+#[0, 3, 6, 9, 12, 15, 18]
+-/
+#guard_msgs in
+set_option interpreter.bytecode false in
+#eval run
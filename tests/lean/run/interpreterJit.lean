@@ -0,0 +1,37 @@
+/-!
+Hot interpreted functions are compiled with the LLVM JIT when `interpreter.jit_threshold` is set. Builds
+without LLVM ignore the option, so the results must be the same either way.
+-/
+
+def collatz (n : Nat) : Nat := Id.run do
+  let mut n := n
+  let mut steps := 0
+  while n != 1 do
+    n := if n % 2 == 0 then n / 2 else 3 * n + 1
+    steps := steps + 1
+  return steps
+
+def sumCollatz (n : Nat) : Nat :=
+  (List.range n).foldl (fun acc i => acc + collatz (i + 1)) 0
+
+def scale (x : Float) (k : UInt64) : Float :=
+  x * k.toFloat
+
+def run : IO Unit := do
+  IO.println (sumCollatz 1000)
+  IO.println ((List.range 10).map (scale 1.5 ·.toUInt64))
+
+/--
+info: 59542
+[0.000000, 1.500000, 3.000000, 4.500000, 6.000000, 7.500000, 9.000000, 10.500000, 12.000000, 13.500000]
+-/
+#guard_msgs in
+#eval run
+
+/--
+info: 59542
+[0.000000, 1.500000, 3.000000, 4.500000, 6.000000, 7.500000, 9.000000, 10.500000, 12.000000, 13.500000]
+-/
+#guard_msgs in
+set_option interpreter.jit_threshold 3 in
+#eval run
@@ -0,0 +1,53 @@
+import Lean
+open Lean Firefox
+
+/-!
+The interpreter profiler samples the call stacks of interpreted code, including natively called
+functions.
+-/
+
+def spin (n : Nat) : Nat := Id.run do
+  let mut acc := 0
+  for i in [0:n] do
+    acc := acc + (toString i).length
+  return acc
+
+partial def busy (deadline : Nat) (acc : Nat) : IO Nat := do
+  if (← IO.monoMsNow) ≥ deadline then
+    return acc
+  busy deadline (acc + spin 1000)
+
+def profileBusy : IO InterpreterProfile := do
+  startInterpreterProfiler 100
+  discard <| busy ((← IO.monoMsNow) + 100) 0
+  stopInterpreterProfiler
+
+def hasExpectedFrames (profile : InterpreterProfile) : Bool :=
+  let stacks := profile.samples.map fun s => s.stack.map (profile.frames[·]!)
+  stacks.any (·.contains "busy") && profile.frames.any (·.endsWith " [native]")
+
+/-!
+Whether a sample is taken inside `busy` or inside a native callee depends on when the profiler thread
+ticks, so we profile until both have been seen. Without samples at all, which is always the case in
+single-threaded builds where the profiler is unavailable, only the shape of the result is checked.
+-/
+#guard_msgs in
+#eval show IO Unit from do
+  let mut profile ← profileBusy
+  for _ in [0:20] do
+    if hasExpectedFrames profile then
+      break
+    profile ← profileBusy
+  let threads := profile.toThreads "test" 100
+  if profile.samples.isEmpty then
+    unless profile.frames.isEmpty && threads.isEmpty do
+      throw <| .userError "unexpected frames without samples"
+    return
+  unless hasExpectedFrames profile do
+    throw <| .userError "no sample of `busy` and of a native callee"
+  unless threads.all (·.samples.length > 0) do
+    throw <| .userError "empty thread in the Firefox profile"
+  unless profile.samples.all (·.stack.all (· < profile.frames.size)) do
+    throw <| .userError "invalid frame index"
+  unless profile.samples.all (·.ticks > 0) do
+    throw <| .userError "sample without ticks"
@@ -0,0 +1,38 @@
+/-!
+Constants evaluated by the interpreter are shared with interpreters on other threads.
+-/
+
+def bigTable : Array Nat := (List.range 100000).toArray.map (· * 7)
+
+def lookupInTasks : IO (List Nat) := do
+  let tasks ← (List.range 4).mapM fun i => IO.asTask (pure bigTable[9999 + i]!)
+  tasks.mapM fun t => IO.ofExcept t.get
+
+/-- info: [69993, 70000, 70007, 70014] -/
+#guard_msgs in
+#eval lookupInTasks
+
+set_option interpreter.shared_constant_cache 0 in
+/-- info: [69993, 70000, 70007, 70014] -/
+#guard_msgs in
+#eval lookupInTasks
+
+/--
+Evaluates `bigTable` on other threads, one after another, and checks whether all of them got the
+same object. The results are kept alive, so unshared values cannot end up at the same address.
+-/
+unsafe def sharedInTasks : IO Bool := do
+  let mut tables := #[]
+  for _ in [0:4] do
+    let t ← IO.asTask (pure bigTable)
+    tables := tables.push (← IO.ofExcept t.get)
+  return tables.all (ptrAddrUnsafe · == ptrAddrUnsafe tables[0]!)
+
+/-- info: true -/
+#guard_msgs in
+#eval sharedInTasks
+
+set_option interpreter.shared_constant_cache 0 in
+/-- info: false -/
+#guard_msgs in
+#eval sharedInTasks
@@ -0,0 +1,15 @@
+/-!
+Mutual tail calls in interpreted code must run in constant native stack space.
+-/
+
+mutual
+partial def ping (n : Nat) (acc : UInt64) : UInt64 :=
+  if n == 0 then acc else pong (n - 1) (acc * 6364136223846793005 + 1442695040888963407)
+
+partial def pong (n : Nat) (acc : UInt64) : UInt64 :=
+  if n == 0 then acc else ping (n - 1) (acc ^^^ (acc >>> 29))
+end
+
+/-- info: 18339779572059917205 -/
+#guard_msgs in
+#eval ping 3000000 0
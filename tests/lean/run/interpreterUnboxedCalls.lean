@@ -0,0 +1,44 @@
+/-!
+Calls native functions with unboxed parameters or results from interpreted code, both through the typed
+trampolines and through their boxed versions.
+-/
+
+def sumSqrt (n : Nat) : Float := Id.run do
+  let mut acc : Float := 0
+  for i in [0:n] do
+    acc := acc + (Float.ofInt i).sqrt.floor
+  return acc
+
+def run : IO Unit := do
+  IO.println (Float.sqrt 2)
+  IO.println (Float32.sqrt 2).toFloat
+  IO.println (Float.ofInt (-3))
+  IO.println (Float.scaleB 1.5 4)
+  IO.println (mixHash 7 11)
+  IO.println ("abc".hash == "abc".hash, "abc".hash != "abd".hash)
+  IO.println (sumSqrt 100)
+
+/--
+info: 1.414214
+1.414214
+-3.000000
+24.000000
+14200442188093677519
+(true, true)
+615.000000
+-/
+#guard_msgs in
+#eval run
+
+/--
+info: 1.414214
+1.414214
+-3.000000
+24.000000
+14200442188093677519
+(true, true)
+615.000000
+-/
+#guard_msgs in
+set_option interpreter.unboxed_calls false in
+#eval run
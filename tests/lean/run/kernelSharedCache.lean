@@ -0,0 +1,19 @@
+import Lean
+open Lean
+
+-- kernel checking must finish before the statistics are read below
+set_option Elab.async false
+set_option kernel.sharedCache 10000
+
+theorem sharedCacheEx₁ : (List.replicate 50 1).sum = 50 := by decide
+theorem sharedCacheEx₂ : (List.replicate 50 1).sum = 50 := by decide
+
+/--
+info: true
+true
+-/
+#guard_msgs in
+#eval show IO Unit from do
+  let json ← IO.ofExcept <| Json.parse (← Kernel.sharedCacheStats)
+  IO.println ((← IO.ofExcept <| json.getObjValAs? Nat "hits") > 0)
+  IO.println ((← IO.ofExcept <| json.getObjValAs? Nat "capacity") == 10000)
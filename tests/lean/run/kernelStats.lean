@@ -0,0 +1,29 @@
+import Lean
+open Lean
+
+-- kernel checking must finish before the file is read below
+set_option Elab.async false
+
+def statsFile : System.FilePath := "kernelStats.jsonl.tmp"
+
+#eval show IO Unit from do
+  if ← statsFile.pathExists then IO.FS.removeFile statsFile
+
+set_option kernel.stats true in
+set_option kernel.stats.output "kernelStats.jsonl.tmp" in
+theorem kernelStatsEx : 2 ^ 64 + 1 = 18446744073709551617 := rfl
+
+/--
+info: ["kernelStatsEx"]
+true
+true
+-/
+#guard_msgs in
+#eval show IO Unit from do
+  let lines ← IO.FS.lines statsFile
+  IO.FS.removeFile statsFile
+  let json ← IO.ofExcept <| Json.parse lines[0]!
+  IO.println (json.getObjValD "decls").compress
+  let kernel := json.getObjValD "kernel"
+  IO.println ((← IO.ofExcept <| kernel.getObjValAs? Nat "is_def_eq_core") > 0)
+  IO.println ((kernel.getObjValD "cache").getObjValD "whnf" |>.getObjVal? "hits" |>.isOk)
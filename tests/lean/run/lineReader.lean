@@ -0,0 +1,56 @@
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+    throw <| IO.userError <|
+      s!"expected '{expected}', got '{actual}'"
+
+#eval IO.FS.withTempFile fun h path => do
+  h.putStr "first\nsecond\r\n\n\r\nwörld\nlast"
+  h.flush
+  let h ← IO.FS.Handle.mk path .read
+  let r ← IO.FS.LineReader.mk h
+  assertBEq (← r.readLine?) (some "first")
+  assertBEq (← r.readLines 2) #["second", ""]
+  assertBEq (← r.readLines 10) #["", "wörld", "last"]
+  assertBEq (← r.readLine?) none
+  assertBEq (← r.readLines 10) #[]
+  assertBEq (← IO.FS.lines path) #["first", "second", "", "", "wörld", "last"]
+
+-- lines that are longer than the buffer
+#eval IO.FS.withTempFile fun h path => do
+  let long := String.mk (List.replicate 10000 'x')
+  for i in [0:100] do
+    h.putStrLn s!"{i}{long}"
+  h.flush
+  let h ← IO.FS.Handle.mk path .read
+  let r ← IO.FS.LineReader.mk h (capacity := 4096)
+  let lines ← r.lines
+  assertBEq lines.size 100
+  assertBEq (lines.all (·.length ≥ 10000)) true
+  assertBEq lines[99]! s!"99{long}"
+
+#eval IO.FS.withTempFile fun h path => do
+  for i in [0:5000] do
+    h.putStrLn (toString i)
+  h.flush
+  let h ← IO.FS.Handle.mk path .read
+  let r ← IO.FS.LineReader.mk h
+  let sum ← r.foldLines 0 fun acc line => return acc + line.toNat!
+  assertBEq sum (5000 * 4999 / 2)
+
+-- a trailing `\r` without `\n` is kept, like `Handle.getLine` does
+#eval IO.FS.withTempFile fun h path => do
+  h.putStr "a\r"
+  h.flush
+  assertBEq (← IO.FS.lines path) #["a\r"]
+
+-- lines from a pipe are returned as soon as they have arrived
+#eval if System.Platform.isWindows then pure () else do
+  let child ← IO.Process.spawn { cmd := "cat", stdin := .piped, stdout := .piped }
+  let r ← IO.FS.LineReader.mk child.stdout
+  for i in [0:3] do
+    child.stdin.putStrLn s!"line {i}"
+    child.stdin.flush
+    assertBEq (← r.readLine?) (some s!"line {i}")
+  let (_, child) ← child.takeStdin
+  assertBEq (← r.readLine?) none
+  assertBEq (← child.wait) 0
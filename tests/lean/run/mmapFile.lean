@@ -0,0 +1,51 @@
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+    throw <| IO.userError <|
+      s!"expected '{expected}', got '{actual}'"
+
+#eval IO.FS.withTempDir fun dir => do
+  let path := dir / "data.txt"
+  IO.FS.writeFile path "Hello, wörld!"
+  let m ← IO.FS.mmapFile path
+  m.advise .sequential
+  assertBEq m.size 14
+  assertBEq (m.get! 0) 'H'.toUInt8
+  assertBEq (m.uget 100) 0
+  assertBEq (m.extract 7 14).toList "wörld!".toUTF8.toList
+  assertBEq (m.extract 10 100).size 4
+  assertBEq (m.extract 5 2).size 0
+  assertBEq m.validateUTF8 true
+  assertBEq m.toString? (some "Hello, wörld!")
+
+  let mut sum := 0
+  for b in m do
+    sum := sum + b.toNat
+  assertBEq sum ("Hello, wörld!".toUTF8.foldl (fun acc b => acc + b.toNat) 0)
+
+  let mut it := m.iter.forward 7
+  assertBEq it.curr 'w'.toUInt8
+  it := it.next
+  assertBEq it.remainingBytes 6
+  assertBEq (it.forward 6).atEnd true
+  assertBEq it.remainingToByteArray.size 6
+
+#eval IO.FS.withTempDir fun dir => do
+  let path := dir / "invalid"
+  IO.FS.writeBinFile path (ByteArray.mk #[0x61, 0xff, 0x62])
+  let m ← IO.FS.mmapFile path
+  assertBEq m.validateUTF8 false
+  assertBEq m.toString? none
+
+  let empty := dir / "empty"
+  IO.FS.writeFile empty ""
+  let m ← IO.FS.mmapFile empty
+  m.advise .willNeed
+  assertBEq m.size 0
+  assertBEq m.toString? (some "")
+
+  try
+    discard <| IO.FS.mmapFile (dir / "missing")
+    throw <| IO.userError "mapping a missing file should fail"
+  catch
+    | .noFileOrDirectory .. => pure ()
+    | err => throw err
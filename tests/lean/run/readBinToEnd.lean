@@ -0,0 +1,57 @@
+def assertBEq [BEq α] [ToString α] (actual expected : α) : IO Unit := do
+  unless actual == expected do
+    throw <| IO.userError <|
+      s!"expected '{expected}', got '{actual}'"
+
+def bytes (n : Nat) : ByteArray := Id.run do
+  let mut r := ByteArray.emptyWithCapacity n
+  for i in [0:n] do
+    r := r.push (i % 251).toUInt8
+  return r
+
+def test : IO Unit := IO.FS.withTempFile fun h path => do
+  -- larger than the initial chunk and not a multiple of it
+  let data := bytes 300001
+  h.write data
+  h.flush
+
+  IO.FS.withFile path .read fun h => do
+    assertBEq (← h.readBinToEnd).data data.data
+    -- EOF is not sticky
+    assertBEq (← h.readBinToEnd).size 0
+
+  IO.FS.withFile path .read fun h => do
+    -- data buffered by previous reads is not lost
+    let first ← h.read 10
+    assertBEq (first ++ (← h.readBinToEnd)).data data.data
+
+  IO.FS.withFile path .read fun h => do
+    -- a shared buffer is not modified
+    let pre := bytes 5
+    let r ← h.readBinToEndInto pre
+    assertBEq pre.size 5
+    assertBEq r.data (pre ++ data).data
+
+  IO.FS.withFile path .read fun h => do
+    -- a buffer that fits exactly is filled before probing for EOF
+    let r ← h.readBinToEndInto (.emptyWithCapacity data.size)
+    assertBEq r.data data.data
+
+  assertBEq (← IO.FS.readBinFile path).data data.data
+
+  let empty := path.withExtension "empty"
+  IO.FS.writeFile empty ""
+  assertBEq (← IO.FS.readBinFile empty).size 0
+  IO.FS.removeFile empty
+
+  -- streams
+  let r ← IO.mkRef { data := data : IO.FS.Stream.Buffer }
+  assertBEq (← (IO.FS.Stream.ofBuffer r).readBinToEnd).data data.data
+
+def testPipe : IO Unit := do
+  let out ← IO.Process.output { cmd := "sh", args := #["-c", "yes | head -c 5000000; yes >&2 | head -c 100000 >&2"] }
+  assertBEq out.stdout.utf8ByteSize 5000000
+  assertBEq out.stderr.utf8ByteSize 100000
+
+#eval test
+#eval if System.Platform.isWindows then pure () else testPipe